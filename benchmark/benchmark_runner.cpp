@@ -166,6 +166,11 @@ void BenchmarkRunner::RunBenchmark(Benchmark *benchmark) {
 					break;
 				} else {
 					LogResult(to_string(profiler.Elapsed()));
+					auto metrics = benchmark->GetMetrics(state.get());
+					if (!metrics.empty()) {
+						LogLine(metrics);
+						LogOutput(metrics);
+					}
 				}
 			}
 		} else {
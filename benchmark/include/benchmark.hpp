@@ -68,6 +68,10 @@ public:
 	}
 
 	virtual string GetLogOutput(BenchmarkState *state) = 0;
+	//! Returns additional metrics of the last run (e.g. throughput and latency percentiles), if any
+	virtual string GetMetrics(BenchmarkState *state) {
+		return string();
+	}
 
 	//! Whether or not Initialize() should be called once for every run or just
 	//! once
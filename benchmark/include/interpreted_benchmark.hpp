@@ -7,6 +7,7 @@
 #pragma once
 
 #include "benchmark.hpp"
+#include "duckdb/common/constants.hpp"
 
 #include <unordered_map>
 #include <unordered_set>
@@ -37,6 +38,13 @@ public:
 	string BenchmarkInfo() override;
 
 	string GetLogOutput(BenchmarkState *state) override;
+	//! Returns the throughput and latency of every client count of a concurrent benchmark
+	string GetMetrics(BenchmarkState *state) override;
+
+	//! Whether or not the benchmark runs a workload from multiple concurrent clients
+	bool IsConcurrent() {
+		return !workload.empty();
+	}
 
 private:
 	std::unordered_map<string, string> replacement_mapping;
@@ -49,6 +57,15 @@ private:
 	std::unordered_set<string> extensions;
 	int64_t result_column_count = 0;
 	vector<vector<string>> result_values;
+
+	//! The queries that are issued by the clients of a concurrent benchmark
+	vector<string> workload;
+	//! The amount of concurrent clients to run the workload with; a run is done for every entry in the list
+	vector<idx_t> concurrent_clients;
+	//! The amount of queries each client issues per run
+	idx_t client_queries = 100;
+	//! The amount of threads used by the database (0 = leave unchanged)
+	idx_t threads = 0;
 };
 
 } // namespace duckdb
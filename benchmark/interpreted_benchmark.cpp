@@ -2,9 +2,12 @@
 #include "benchmark_runner.hpp"
 #include "duckdb.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <sstream>
+#include <thread>
 
+#include "duckdb/common/profiler.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/main/client_context.hpp"
 
@@ -32,11 +35,32 @@ static string ParseGroupFromPath(string file) {
 	return "[" + file.substr(0, group_end) + "]" + extension;
 }
 
+//! The measurements of a single run of a concurrent benchmark with a fixed amount of clients
+struct ConcurrentRunResult {
+	idx_t clients;
+	//! The total wall clock time of the run (in seconds)
+	double elapsed;
+	//! The amount of queries that completed successfully
+	idx_t queries;
+	//! The amount of queries that were aborted because of a transaction conflict
+	idx_t conflicts;
+	//! The latency percentiles of the successful queries (in seconds)
+	double p50;
+	double p99;
+};
+
 struct InterpretedBenchmarkState : public BenchmarkState {
 	DuckDB db;
 	Connection con;
 	unique_ptr<MaterializedQueryResult> result;
 
+	//! The connections used by the clients of a concurrent benchmark
+	vector<unique_ptr<Connection>> clients;
+	//! The results of the last concurrent run, one entry per client count
+	vector<ConcurrentRunResult> concurrent_results;
+	//! The first unexpected error encountered by any client in the last concurrent run
+	string concurrent_error;
+
 	InterpretedBenchmarkState() : db(nullptr), con(db) {
 		con.EnableProfiling();
 	}
@@ -175,6 +199,39 @@ void InterpretedBenchmark::LoadBenchmark() {
 					result_values.push_back(move(result_splits));
 				}
 			}
+		} else if (splits[0] == "workload") {
+			// workload: every line up to the next blank line is a query issued by the concurrent clients
+			if (!workload.empty()) {
+				throw std::runtime_error(reader.FormatException("Multiple workloads in the same benchmark file"));
+			}
+			while (reader.ReadLine(line)) {
+				if (line.empty()) {
+					break;
+				}
+				workload.push_back(line);
+			}
+		} else if (splits[0] == "clients") {
+			// clients: the list of client counts to run the workload with (e.g. clients 1 2 4 8)
+			if (splits.size() < 2) {
+				throw std::runtime_error(reader.FormatException("clients requires at least one parameter"));
+			}
+			for (idx_t i = 1; i < splits.size(); i++) {
+				auto client_count = std::stoll(splits[i]);
+				if (client_count <= 0) {
+					throw std::runtime_error(reader.FormatException("client count must be positive"));
+				}
+				concurrent_clients.push_back(client_count);
+			}
+		} else if (splits[0] == "client_queries") {
+			if (splits.size() != 2) {
+				throw std::runtime_error(reader.FormatException("client_queries requires a single parameter"));
+			}
+			client_queries = std::stoll(splits[1]);
+		} else if (splits[0] == "threads") {
+			if (splits.size() != 2) {
+				throw std::runtime_error(reader.FormatException("threads requires a single parameter"));
+			}
+			threads = std::stoll(splits[1]);
 		} else if (splits[0] == "template") {
 			// template: update the path to read
 			benchmark_path = splits[1];
@@ -202,10 +259,19 @@ void InterpretedBenchmark::LoadBenchmark() {
 unique_ptr<BenchmarkState> InterpretedBenchmark::Initialize() {
 	unique_ptr<QueryResult> result;
 	LoadBenchmark();
-	if (queries.find("run") == queries.end()) {
-		throw Exception("Invalid benchmark file: no \"run\" query specified");
+	if (IsConcurrent()) {
+		if (queries.find("run") != queries.end()) {
+			throw Exception("Invalid benchmark file: a benchmark cannot have both a \"run\" query and a workload");
+		}
+		if (concurrent_clients.empty()) {
+			concurrent_clients.push_back(1);
+		}
+	} else {
+		if (queries.find("run") == queries.end()) {
+			throw Exception("Invalid benchmark file: no \"run\" query specified");
+		}
+		run_query = queries["run"];
 	}
-	run_query = queries["run"];
 
 	auto state = make_unique<InterpretedBenchmarkState>();
 	for (auto &extension : extensions) {
@@ -251,11 +317,94 @@ unique_ptr<BenchmarkState> InterpretedBenchmark::Initialize() {
 		}
 		result = move(result->next);
 	}
+	if (threads > 0) {
+		result = state->con.Query("PRAGMA threads=" + to_string(threads));
+		if (!result->success) {
+			throw Exception(result->error);
+		}
+	}
+	if (IsConcurrent()) {
+		// create one connection per client up-front so connection setup is not measured
+		auto max_clients = *std::max_element(concurrent_clients.begin(), concurrent_clients.end());
+		for (idx_t i = 0; i < max_clients; i++) {
+			state->clients.push_back(make_unique<Connection>(state->db));
+		}
+	}
 	return state;
 }
 
+static void RunConcurrentClient(Connection &con, const vector<string> &workload, idx_t client_idx, idx_t query_count,
+                                vector<double> &latencies, idx_t &conflicts, string &error) {
+	Profiler profiler;
+	for (idx_t i = 0; i < query_count; i++) {
+		// clients start at different offsets in the workload so that the query mix is interleaved
+		auto &query = workload[(client_idx + i) % workload.size()];
+		profiler.Start();
+		auto result = con.Query(query);
+		profiler.End();
+		if (result->success) {
+			latencies.push_back(profiler.Elapsed());
+		} else if (result->error.find("Conflict") != string::npos) {
+			// transaction conflicts are expected for concurrent writers: count them but keep going
+			conflicts++;
+		} else {
+			error = result->error;
+			return;
+		}
+	}
+}
+
+static ConcurrentRunResult RunConcurrentWorkload(InterpretedBenchmarkState &state, const vector<string> &workload,
+                                                 idx_t clients, idx_t query_count) {
+	vector<vector<double>> client_latencies(clients);
+	vector<idx_t> client_conflicts(clients, 0);
+	vector<string> client_errors(clients);
+
+	Profiler profiler;
+	profiler.Start();
+	vector<std::thread> client_threads;
+	for (idx_t i = 0; i < clients; i++) {
+		client_threads.emplace_back(RunConcurrentClient, std::ref(*state.clients[i]), std::cref(workload), i,
+		                            query_count, std::ref(client_latencies[i]), std::ref(client_conflicts[i]),
+		                            std::ref(client_errors[i]));
+	}
+	for (auto &thread : client_threads) {
+		thread.join();
+	}
+	profiler.End();
+
+	ConcurrentRunResult result;
+	result.clients = clients;
+	result.elapsed = profiler.Elapsed();
+	result.conflicts = 0;
+	vector<double> latencies;
+	for (idx_t i = 0; i < clients; i++) {
+		latencies.insert(latencies.end(), client_latencies[i].begin(), client_latencies[i].end());
+		result.conflicts += client_conflicts[i];
+		if (state.concurrent_error.empty() && !client_errors[i].empty()) {
+			state.concurrent_error = client_errors[i];
+		}
+	}
+	result.queries = latencies.size();
+	std::sort(latencies.begin(), latencies.end());
+	result.p50 = latencies.empty() ? 0 : latencies[latencies.size() / 2];
+	result.p99 = latencies.empty() ? 0 : latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+	return result;
+}
+
 void InterpretedBenchmark::Run(BenchmarkState *state_) {
 	auto &state = (InterpretedBenchmarkState &)*state_;
+	if (IsConcurrent()) {
+		state.concurrent_results.clear();
+		state.concurrent_error = string();
+		for (auto &clients : concurrent_clients) {
+			state.concurrent_results.push_back(RunConcurrentWorkload(state, workload, clients, client_queries));
+			if (!state.concurrent_error.empty()) {
+				break;
+			}
+		}
+		return;
+	}
 	state.result = state.con.Query(run_query);
 }
 
@@ -276,6 +425,9 @@ void InterpretedBenchmark::Cleanup(BenchmarkState *state_) {
 
 string InterpretedBenchmark::Verify(BenchmarkState *state_) {
 	auto &state = (InterpretedBenchmarkState &)*state_;
+	if (IsConcurrent()) {
+		return state.concurrent_error;
+	}
 	if (!state.result->success) {
 		return state.result->error;
 	}
@@ -314,9 +466,15 @@ string InterpretedBenchmark::Verify(BenchmarkState *state_) {
 void InterpretedBenchmark::Interrupt(BenchmarkState *state_) {
 	auto &state = (InterpretedBenchmarkState &)*state_;
 	state.con.Interrupt();
+	for (auto &client : state.clients) {
+		client->Interrupt();
+	}
 }
 
 string InterpretedBenchmark::BenchmarkInfo() {
+	if (IsConcurrent()) {
+		return name + " - concurrent workload: " + StringUtil::Join(workload, "; ");
+	}
 	return name + " - " + run_query;
 }
 
@@ -325,4 +483,22 @@ string InterpretedBenchmark::GetLogOutput(BenchmarkState *state_) {
 	return state.con.context->profiler.ToJSON();
 }
 
+string InterpretedBenchmark::GetMetrics(BenchmarkState *state_) {
+	auto &state = (InterpretedBenchmarkState &)*state_;
+	if (state.concurrent_results.empty()) {
+		return string();
+	}
+	// one line per client count, so the lines together form the scalability curve of the workload
+	string result;
+	for (auto &run : state.concurrent_results) {
+		double throughput = run.elapsed > 0 ? run.queries / run.elapsed : 0;
+		result += StringUtil::Format(
+		    "clients=%llu\tqueries=%llu\tconflicts=%llu\ttime=%f\tthroughput=%f\tp50=%f\tp99=%f\n",
+		    (uint64_t)run.clients, (uint64_t)run.queries, (uint64_t)run.conflicts, run.elapsed, throughput, run.p50,
+		    run.p99);
+	}
+	result.pop_back();
+	return result;
+}
+
 } // namespace duckdb
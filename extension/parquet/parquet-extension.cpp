@@ -1,7 +1,6 @@
 #include <string>
 #include <vector>
 #include <bitset>
-#include <fstream>
 #include <cstring>
 #include <iostream>
 #include <sstream>
@@ -19,6 +18,13 @@
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
 #include "duckdb/common/serializer/buffered_serializer.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/parallel/task_context.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression_iterator.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
 
 #include "utf8proc_wrapper.hpp"
 
@@ -303,7 +309,8 @@ struct ParquetScanColumnData {
 
 	uint8_t byte_pos = 0; // to decode plain booleans from bit fields
 
-	ResizeableBuffer buf;
+	ByteBuffer buf;                    // the column chunk, points into the mapped file or into read_buf
+	ResizeableBuffer read_buf;         // only used for files that are not memory mapped
 	ResizeableBuffer decompressed_buf; // only used for compressed files
 	ResizeableBuffer dict;
 	ResizeableBuffer offset_buf;
@@ -328,6 +335,11 @@ public:
 	void ReadChunk(DataChunk &output);
 	void PrepareChunkBuffer(idx_t col_idx);
 	bool PreparePageBuffers(idx_t col_idx);
+	//! Open the file, memory mapping it if the file system supports it
+	void OpenFile(FileSystem &fs, const string &file_name);
+	//! Returns a pointer to len bytes at the location in the file. If the file is memory mapped the pointer points
+	//! directly into the mapping, otherwise the bytes are read into the target buffer.
+	char *ReadFileRange(ResizeableBuffer &target, idx_t location, idx_t len);
 
 	template <class T>
 	static void _fill_from_dict(ParquetScanColumnData &col_data, idx_t count, Vector &target, idx_t target_offset) {
@@ -360,18 +372,25 @@ public:
 public:
 	int64_t current_group;
 	int64_t group_offset;
+	//! The row groups of the file that are read, and the position of the next one in that list
+	vector<idx_t> row_groups;
+	idx_t next_row_group;
 
-	ifstream pfile;
+	unique_ptr<FileHandle> handle;
+	unique_ptr<MappedFile> mapped_file;
+	idx_t file_size;
 
-	FileMetaData file_meta_data;
+	shared_ptr<FileMetaData> file_meta_data;
 	vector<LogicalType> sql_types;
 	vector<ParquetScanColumnData> column_data;
+	//! The values of the hive partition columns of the file, which follow the columns stored in the file
+	vector<Value> partition_values;
 	bool finished;
 };
 
 bool ParquetScanFunctionData::PreparePageBuffers(idx_t col_idx) {
 	auto &col_data = column_data[col_idx];
-	auto &chunk = file_meta_data.row_groups[current_group].columns[col_idx];
+	auto &chunk = file_meta_data->row_groups[current_group].columns[col_idx];
 
 	// clean up a bit to avoid nasty surprises
 	col_data.payload.ptr = nullptr;
@@ -606,7 +625,7 @@ bool ParquetScanFunctionData::PreparePageBuffers(idx_t col_idx) {
 }
 
 void ParquetScanFunctionData::PrepareChunkBuffer(idx_t col_idx) {
-	auto &chunk = file_meta_data.row_groups[current_group].columns[col_idx];
+	auto &chunk = file_meta_data->row_groups[current_group].columns[col_idx];
 	if (chunk.__isset.file_path) {
 		throw runtime_error("Only inlined data files are supported (no references)");
 	}
@@ -623,13 +642,31 @@ void ParquetScanFunctionData::PrepareChunkBuffer(idx_t col_idx) {
 	}
 	auto chunk_len = chunk.meta_data.total_compressed_size;
 
-	// read entire chunk into RAM
-	pfile.seekg(chunk_start);
-	column_data[col_idx].buf.resize(chunk_len);
-	pfile.read(column_data[col_idx].buf.ptr, chunk_len);
-	if (!pfile) {
-		throw runtime_error("Could not read chunk. File corrupt?");
+	// read entire chunk into RAM, or reference it directly in the mapped file
+	auto &col_data = column_data[col_idx];
+	col_data.buf = ByteBuffer(ReadFileRange(col_data.read_buf, chunk_start, chunk_len), chunk_len);
+}
+
+void ParquetScanFunctionData::OpenFile(FileSystem &fs, const string &file_name) {
+	handle = fs.OpenFile(file_name.c_str(), FileFlags::FILE_FLAGS_READ);
+	auto size = fs.GetFileSize(*handle);
+	if (size < 0) {
+		throw IOException("Could not determine the size of file \"%s\"", file_name);
 	}
+	file_size = size;
+	mapped_file = fs.MapFile(*handle);
+}
+
+char *ParquetScanFunctionData::ReadFileRange(ResizeableBuffer &target, idx_t location, idx_t len) {
+	if (location + len > file_size) {
+		throw runtime_error("Could not read from file: range exceeds the file size. File corrupt?");
+	}
+	if (mapped_file) {
+		return (char *)mapped_file->data + location;
+	}
+	target.resize(len);
+	handle->Read(target.ptr, len, location);
+	return target.ptr;
 }
 
 void ParquetScanFunctionData::ReadChunk(DataChunk &output) {
@@ -637,22 +674,20 @@ void ParquetScanFunctionData::ReadChunk(DataChunk &output) {
 		return;
 	}
 
-	// see if we have to switch to the next row group in the parquet file
-	if (current_group < 0 || group_offset >= file_meta_data.row_groups[current_group].num_rows) {
-
-		current_group++;
-		group_offset = 0;
-
-		if ((idx_t)current_group == file_meta_data.row_groups.size()) {
+	// see if we have to switch to the next row group in the parquet file, skipping over empty row groups
+	while (current_group < 0 || group_offset >= file_meta_data->row_groups[current_group].num_rows) {
+		if (next_row_group == row_groups.size()) {
 			finished = true;
 			return;
 		}
+		current_group = row_groups[next_row_group++];
+		group_offset = 0;
 
 		for (idx_t out_col_idx = 0; out_col_idx < output.column_count(); out_col_idx++) {
 			auto file_col_idx = column_ids[out_col_idx];
 
 			// this is a special case where we are not interested in the actual contents of the file
-			if (file_col_idx == COLUMN_IDENTIFIER_ROW_ID) {
+			if (file_col_idx == COLUMN_IDENTIFIER_ROW_ID || file_col_idx >= sql_types.size()) {
 				continue;
 			}
 
@@ -662,7 +697,7 @@ void ParquetScanFunctionData::ReadChunk(DataChunk &output) {
 		}
 	}
 
-	auto current_row_group = file_meta_data.row_groups[current_group];
+	auto &current_row_group = file_meta_data->row_groups[current_group];
 	output.SetCardinality(std::min<int64_t>(STANDARD_VECTOR_SIZE, current_row_group.num_rows - group_offset));
 
 	if (output.size() == 0) {
@@ -676,6 +711,11 @@ void ParquetScanFunctionData::ReadChunk(DataChunk &output) {
 			output.data[out_col_idx].Reference(constant_42);
 			continue;
 		}
+		if (file_col_idx >= sql_types.size()) {
+			// hive partition column: constant for the entire file
+			output.data[out_col_idx].Reference(partition_values[file_col_idx - sql_types.size()]);
+			continue;
+		}
 
 		auto &col_data = column_data[file_col_idx];
 
@@ -844,56 +884,82 @@ void ParquetScanFunctionData::ReadChunk(DataChunk &output) {
 	group_offset += output.size();
 }
 
+struct ParquetScanBindData : public TableFunctionData {
+	//! The files that are scanned, after expanding the glob pattern and skipping files on their hive partitions
+	vector<string> files;
+	//! The metadata of every file, read once while binding
+	vector<shared_ptr<FileMetaData>> metadata;
+	//! The types of the columns stored in the files
+	vector<LogicalType> file_types;
+	//! The names of the hive partition columns, which are returned after the columns stored in the files
+	vector<string> partition_names;
+	//! The values of the hive partition columns of every file
+	vector<vector<Value>> partition_values;
+};
+
+struct ParquetScanOperatorData : public FunctionOperatorData {
+	vector<column_t> column_ids;
+	//! The reader of the file that is currently being scanned
+	unique_ptr<ParquetScanFunctionData> reader;
+	//! The next file to scan and the end of the range of files to scan
+	idx_t file_index;
+	idx_t file_end;
+	//! The row group to scan, or -1 to scan all row groups of the files
+	int64_t row_group;
+};
+
+class ParquetScanTaskInfo : public OperatorTaskInfo {
+public:
+	idx_t file_index;
+	idx_t row_group;
+};
+
 class ParquetScanFunction : public TableFunction {
 public:
 	ParquetScanFunction()
 	    : TableFunction("parquet_scan", {LogicalType::VARCHAR}, parquet_scan_function, parquet_scan_bind,
-	                    parquet_scan_init) {
+	                    parquet_scan_init, nullptr, parquet_scan_parallel, nullptr, nullptr,
+	                    parquet_scan_pushdown_complex_filter) {
+		named_parameters["hive_partitioning"] = LogicalType::BOOLEAN;
 		projection_pushdown = true;
 	}
 
-	static unique_ptr<FunctionData> ReadParquetHeader(string file_name, vector<LogicalType> &return_types,
-	                                                  vector<string> &names) {
+	static unique_ptr<ParquetScanFunctionData> ReadParquetHeader(ClientContext &context, string file_name,
+	                                                             vector<LogicalType> &return_types,
+	                                                             vector<string> &names) {
 		auto res = make_unique<ParquetScanFunctionData>();
 
-		auto &pfile = res->pfile;
-		auto &file_meta_data = res->file_meta_data;
-
-		pfile.open(file_name, std::ios::binary);
+		res->OpenFile(FileSystem::GetFileSystem(context), file_name);
+		res->file_meta_data = make_shared<FileMetaData>();
+		auto &file_meta_data = *res->file_meta_data;
+		auto file_size = res->file_size;
+		if (file_size < 12) {
+			throw runtime_error("File too small to be a Parquet file");
+		}
 
 		ResizeableBuffer buf;
-		buf.resize(4);
-		memset(buf.ptr, '\0', 4);
 		// check for magic bytes at start of file
-		pfile.read(buf.ptr, 4);
-		if (strncmp(buf.ptr, "PAR1", 4) != 0) {
+		auto magic = res->ReadFileRange(buf, 0, 4);
+		if (strncmp(magic, "PAR1", 4) != 0) {
 			throw runtime_error("File not found or missing magic bytes");
 		}
 
-		// check for magic bytes at end of file
-		pfile.seekg(-4, ios_base::end);
-		pfile.read(buf.ptr, 4);
-		if (strncmp(buf.ptr, "PAR1", 4) != 0) {
+		// check for magic bytes at end of file, preceded by the four-byte footer length
+		auto footer_end = res->ReadFileRange(buf, file_size - 8, 8);
+		if (strncmp(footer_end + 4, "PAR1", 4) != 0) {
 			throw runtime_error("No magic bytes found at end of file");
 		}
-
-		// read four-byte footer length from just before the end magic bytes
-		pfile.seekg(-8, ios_base::end);
-		pfile.read(buf.ptr, 4);
-		int32_t footer_len = *(uint32_t *)buf.ptr;
+		uint32_t footer_len = *(uint32_t *)footer_end;
 		if (footer_len == 0) {
 			throw runtime_error("Footer length can't be 0");
 		}
-
-		// read footer into buffer and de-thrift
-		buf.resize(footer_len);
-		pfile.seekg(-(footer_len + 8), ios_base::end);
-		pfile.read(buf.ptr, footer_len);
-		if (!pfile) {
-			throw runtime_error("Could not read footer");
+		if (footer_len + 12 > file_size) {
+			throw runtime_error("Footer length exceeds the file size. File corrupt?");
 		}
 
-		thrift_unpack((const uint8_t *)buf.ptr, (uint32_t *)&footer_len, &file_meta_data);
+		// de-thrift the footer
+		auto footer = res->ReadFileRange(buf, file_size - footer_len - 8, footer_len);
+		thrift_unpack((const uint8_t *)footer, &footer_len, &file_meta_data);
 
 		if (file_meta_data.__isset.encryption_algorithm) {
 			throw runtime_error("Encrypted Parquet files are not supported");
@@ -907,6 +973,10 @@ public:
 		}
 
 		bool has_expected_types = return_types.size() > 0;
+		if (has_expected_types && return_types.size() != file_meta_data.schema.size() - 1) {
+			throw NotImplementedException("PARQUET file contains %d columns, expected %d columns",
+			                              file_meta_data.schema.size() - 1, return_types.size());
+		}
 
 		// skip the first column its the root and otherwise useless
 		for (uint64_t col_idx = 1; col_idx < file_meta_data.schema.size(); col_idx++) {
@@ -962,11 +1032,52 @@ public:
 
 			res->sql_types.push_back(type);
 		}
+		for (idx_t i = 0; i < file_meta_data.row_groups.size(); i++) {
+			res->row_groups.push_back(i);
+		}
+		res->next_row_group = 0;
+		res->group_offset = 0;
+		res->current_group = -1;
+		res->column_data.resize(res->sql_types.size());
+		res->finished = false;
+		return res;
+	}
+
+	//! Open a file of a (multi-file) scan, using the metadata that was read while binding the scan
+	static unique_ptr<ParquetScanFunctionData> OpenParquetFile(ClientContext &context,
+	                                                           const ParquetScanBindData &bind_data, idx_t file_idx) {
+		auto res = make_unique<ParquetScanFunctionData>();
+		res->OpenFile(FileSystem::GetFileSystem(context), bind_data.files[file_idx]);
+		res->file_meta_data = bind_data.metadata[file_idx];
+		res->sql_types = bind_data.file_types;
+		res->partition_values = bind_data.partition_values[file_idx];
+		for (idx_t i = 0; i < res->file_meta_data->row_groups.size(); i++) {
+			res->row_groups.push_back(i);
+		}
+		res->next_row_group = 0;
 		res->group_offset = 0;
 		res->current_group = -1;
-		res->column_data.resize(return_types.size());
+		res->column_data.resize(res->sql_types.size());
 		res->finished = false;
-		return move(res);
+		return res;
+	}
+
+	//! Parse the key=value directories in the path of a file of a hive partitioned data set
+	static vector<pair<string, string>> ParseHivePartitions(const string &file_name) {
+		vector<pair<string, string>> result;
+		idx_t last_pos = 0;
+		for (idx_t i = 0; i < file_name.size(); i++) {
+			if (file_name[i] != '/' && file_name[i] != '\\') {
+				continue;
+			}
+			auto directory = file_name.substr(last_pos, i - last_pos);
+			auto eq_pos = directory.find('=');
+			if (eq_pos != string::npos && eq_pos > 0) {
+				result.push_back(make_pair(directory.substr(0, eq_pos), directory.substr(eq_pos + 1)));
+			}
+			last_pos = i + 1;
+		}
+		return result;
 	}
 
 	static unique_ptr<FunctionData> parquet_read_bind(ClientContext &context, CopyInfo &info,
@@ -975,28 +1086,207 @@ public:
 		for (auto &option : info.options) {
 			throw NotImplementedException("Unsupported option for COPY FROM parquet: %s", option.first);
 		}
-		auto data = ReadParquetHeader(info.file_path, expected_types, expected_names);
-		// FIXME: hacky
-		auto &pdata = (ParquetScanFunctionData &)*data;
+		auto data = ReadParquetHeader(context, info.file_path, expected_types, expected_names);
 		for (idx_t i = 0; i < expected_types.size(); i++) {
-			pdata.column_ids.push_back(i);
+			data->column_ids.push_back(i);
 		}
-		return data;
+		return move(data);
 	}
 
 	static unique_ptr<FunctionData> parquet_scan_bind(ClientContext &context, vector<Value> &inputs,
 	                                                  unordered_map<string, Value> &named_parameters,
 	                                                  vector<LogicalType> &return_types, vector<string> &names) {
-		auto file_name = inputs[0].GetValue<string>();
-		return ReadParquetHeader(file_name, return_types, names);
+		auto file_pattern = inputs[0].GetValue<string>();
+		bool hive_partitioning = false;
+		for (auto &kv : named_parameters) {
+			if (kv.first == "hive_partitioning") {
+				hive_partitioning = kv.second.value_.boolean;
+			}
+		}
+
+		auto result = make_unique<ParquetScanBindData>();
+		if (FileSystem::HasGlob(file_pattern)) {
+			auto &fs = FileSystem::GetFileSystem(context);
+			result->files = fs.Glob(file_pattern);
+			if (result->files.empty()) {
+				throw IOException("No files found that match the pattern \"%s\"", file_pattern);
+			}
+		} else {
+			result->files.push_back(file_pattern);
+		}
+		// read the metadata of every file once: the schema of the first file determines the result types, all other
+		// files have to match it, both in the names and in the types of their columns
+		for (idx_t file_idx = 0; file_idx < result->files.size(); file_idx++) {
+			auto &file_name = result->files[file_idx];
+			if (file_idx == 0) {
+				auto reader = ReadParquetHeader(context, file_name, return_types, names);
+				result->metadata.push_back(reader->file_meta_data);
+				continue;
+			}
+			vector<LogicalType> file_types;
+			vector<string> file_names;
+			auto reader = ReadParquetHeader(context, file_name, file_types, file_names);
+			if (file_types != return_types || file_names != names) {
+				throw BinderException("File \"%s\" does not have the same schema as file \"%s\"", file_name,
+				                      result->files[0]);
+			}
+			result->metadata.push_back(reader->file_meta_data);
+		}
+		result->file_types = return_types;
+
+		if (!hive_partitioning) {
+			result->partition_values.resize(result->files.size());
+			return move(result);
+		}
+		// hive partitioning: the key=value directories in the path of the files become VARCHAR columns
+		for (idx_t file_idx = 0; file_idx < result->files.size(); file_idx++) {
+			auto partitions = ParseHivePartitions(result->files[file_idx]);
+			if (file_idx == 0) {
+				for (auto &partition : partitions) {
+					for (auto &name : names) {
+						if (name == partition.first) {
+							throw BinderException("Hive partition \"%s\" has the same name as a column in the file",
+							                      partition.first);
+						}
+					}
+					result->partition_names.push_back(partition.first);
+				}
+			}
+			if (partitions.size() != result->partition_names.size()) {
+				throw BinderException("File \"%s\" does not have the same hive partitions as file \"%s\"",
+				                      result->files[file_idx], result->files[0]);
+			}
+			vector<Value> values;
+			for (idx_t i = 0; i < partitions.size(); i++) {
+				if (partitions[i].first != result->partition_names[i]) {
+					throw BinderException("File \"%s\" does not have the same hive partitions as file \"%s\"",
+					                      result->files[file_idx], result->files[0]);
+				}
+				values.push_back(Value(partitions[i].second));
+			}
+			result->partition_values.push_back(move(values));
+		}
+		for (auto &name : result->partition_names) {
+			names.push_back(name);
+			return_types.push_back(LogicalType::VARCHAR);
+		}
+		return move(result);
 	}
 
 	static unique_ptr<FunctionOperatorData>
-	parquet_scan_init(ClientContext &context, const FunctionData *bind_data, OperatorTaskInfo *task_info,
+	parquet_scan_init(ClientContext &context, const FunctionData *bind_data_, OperatorTaskInfo *task_info,
 	                  vector<column_t> &column_ids, unordered_map<idx_t, vector<TableFilter>> &table_filters) {
-		auto &data = (ParquetScanFunctionData &)*bind_data;
-		data.column_ids = column_ids;
-		return nullptr;
+		auto &bind_data = (const ParquetScanBindData &)*bind_data_;
+		auto result = make_unique<ParquetScanOperatorData>();
+		result->column_ids = column_ids;
+		if (task_info) {
+			// parallel scan: only scan the row group of the file assigned to this task
+			auto &info = (ParquetScanTaskInfo &)*task_info;
+			result->file_index = info.file_index;
+			result->file_end = info.file_index + 1;
+			result->row_group = info.row_group;
+		} else {
+			result->file_index = 0;
+			result->file_end = bind_data.files.size();
+			result->row_group = -1;
+		}
+		return move(result);
+	}
+
+	static void parquet_scan_parallel(ClientContext &context, const FunctionData *bind_data_,
+	                                  vector<column_t> &column_ids,
+	                                  unordered_map<idx_t, vector<TableFilter>> &table_filters,
+	                                  std::function<void(unique_ptr<OperatorTaskInfo>)> callback) {
+		auto &bind_data = (const ParquetScanBindData &)*bind_data_;
+		idx_t row_group_count = 0;
+		for (auto &metadata : bind_data.metadata) {
+			row_group_count += metadata->row_groups.size();
+		}
+		if (row_group_count <= 1) {
+			// a single row group is not worth parallelizing
+			return;
+		}
+		// create one task per row group of every file
+		for (idx_t file_idx = 0; file_idx < bind_data.files.size(); file_idx++) {
+			for (idx_t row_group = 0; row_group < bind_data.metadata[file_idx]->row_groups.size(); row_group++) {
+				auto task = make_unique<ParquetScanTaskInfo>();
+				task->file_index = file_idx;
+				task->row_group = row_group;
+				callback(move(task));
+			}
+		}
+	}
+
+	//! Replace the references to hive partition columns with the partition values of a file, returns false if the
+	//! expression references any other column
+	static bool ReplacePartitionColumns(unique_ptr<Expression> &expr, LogicalGet &get, idx_t partition_start,
+	                                    const vector<Value> &partition_values) {
+		if (expr->type == ExpressionType::BOUND_COLUMN_REF) {
+			auto &colref = (BoundColumnRefExpression &)*expr;
+			if (colref.depth > 0 || colref.binding.table_index != get.table_index) {
+				return false;
+			}
+			auto column_id = get.column_ids[colref.binding.column_index];
+			if (column_id == COLUMN_IDENTIFIER_ROW_ID || column_id < partition_start) {
+				return false;
+			}
+			expr = make_unique<BoundConstantExpression>(partition_values[column_id - partition_start]);
+			return true;
+		}
+		bool success = true;
+		ExpressionIterator::EnumerateChildren(*expr, [&](unique_ptr<Expression> child) -> unique_ptr<Expression> {
+			if (success) {
+				success = ReplacePartitionColumns(child, get, partition_start, partition_values);
+			}
+			return child;
+		});
+		return success;
+	}
+
+	static void parquet_scan_pushdown_complex_filter(ClientContext &context, LogicalGet &get,
+	                                                 FunctionData *bind_data_,
+	                                                 vector<unique_ptr<Expression>> &filters) {
+		auto &bind_data = (ParquetScanBindData &)*bind_data_;
+		if (bind_data.partition_names.empty()) {
+			return;
+		}
+		auto partition_start = bind_data.file_types.size();
+		for (idx_t i = 0; i < filters.size(); i++) {
+			// evaluate filters that only reference partition columns for every file
+			vector<bool> keep_file;
+			bool is_partition_filter = true;
+			for (idx_t file_idx = 0; file_idx < bind_data.files.size(); file_idx++) {
+				auto filter = filters[i]->Copy();
+				if (!ReplacePartitionColumns(filter, get, partition_start, bind_data.partition_values[file_idx]) ||
+				    !filter->IsFoldable()) {
+					is_partition_filter = false;
+					break;
+				}
+				auto result = ExpressionExecutor::EvaluateScalar(*filter).CastAs(LogicalType::BOOLEAN);
+				keep_file.push_back(!result.is_null && result.value_.boolean);
+			}
+			if (!is_partition_filter) {
+				continue;
+			}
+			// skip the files that do not pass the filter; the filter holds for all remaining files so it is removed
+			idx_t keep_count = 0;
+			for (idx_t file_idx = 0; file_idx < bind_data.files.size(); file_idx++) {
+				if (!keep_file[file_idx]) {
+					continue;
+				}
+				if (keep_count != file_idx) {
+					bind_data.files[keep_count] = move(bind_data.files[file_idx]);
+					bind_data.metadata[keep_count] = move(bind_data.metadata[file_idx]);
+					bind_data.partition_values[keep_count] = move(bind_data.partition_values[file_idx]);
+				}
+				keep_count++;
+			}
+			bind_data.files.resize(keep_count);
+			bind_data.metadata.resize(keep_count);
+			bind_data.partition_values.resize(keep_count);
+			filters.erase(filters.begin() + i);
+			i--;
+		}
 	}
 
 	static unique_ptr<GlobalFunctionData> parquet_read_initialize(ClientContext &context, FunctionData &fdata) {
@@ -1009,10 +1299,28 @@ public:
 		data.ReadChunk(output);
 	}
 
-	static void parquet_scan_function(ClientContext &context, const FunctionData *bind_data,
+	static void parquet_scan_function(ClientContext &context, const FunctionData *bind_data_,
 	                                  FunctionOperatorData *operator_state, DataChunk &output) {
-		auto &data = (ParquetScanFunctionData &)*bind_data;
-		data.ReadChunk(output);
+		auto &bind_data = (const ParquetScanBindData &)*bind_data_;
+		auto &state = (ParquetScanOperatorData &)*operator_state;
+		while (true) {
+			if (state.reader) {
+				state.reader->ReadChunk(output);
+				if (output.size() > 0) {
+					return;
+				}
+				state.reader.reset();
+			}
+			if (state.file_index >= state.file_end) {
+				return;
+			}
+			// move on to the next file
+			state.reader = OpenParquetFile(context, bind_data, state.file_index++);
+			state.reader->column_ids = state.column_ids;
+			if (state.row_group >= 0) {
+				state.reader->row_groups = {(idx_t)state.row_group};
+			}
+		}
 	}
 };
 
@@ -27,7 +27,7 @@ using namespace std;
 
 Catalog::Catalog(StorageManager &storage)
     : storage(storage), schemas(make_unique<CatalogSet>(*this)),
-      dependency_manager(make_unique<DependencyManager>(*this)) {
+      dependency_manager(make_unique<DependencyManager>(*this)), catalog_version(0) {
 }
 Catalog::~Catalog() {
 }
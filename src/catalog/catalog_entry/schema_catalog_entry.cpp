@@ -12,6 +12,7 @@
 #include "duckdb/catalog/catalog_entry/pragma_function_catalog_entry.hpp"
 #include "duckdb/catalog/catalog_entry/view_catalog_entry.hpp"
 #include "duckdb/common/exception.hpp"
+#include "duckdb/main/client_context.hpp"
 #include "duckdb/parser/parsed_data/alter_table_info.hpp"
 #include "duckdb/parser/parsed_data/create_index_info.hpp"
 #include "duckdb/parser/parsed_data/create_scalar_function_info.hpp"
@@ -52,6 +53,8 @@ CatalogEntry *SchemaCatalogEntry::AddEntry(ClientContext &context, unique_ptr<St
 		dependencies.insert(this);
 	} else {
 		entry->temporary = true;
+		// queries of this connection can now refer to its temporary objects
+		context.has_temporary_objects = true;
 	}
 	if (on_conflict == OnCreateConflict::REPLACE) {
 		// CREATE OR REPLACE: first try to drop the entry
@@ -61,6 +61,7 @@ bool CatalogSet::CreateEntry(Transaction &transaction, const string &name, uniqu
 	value->child->parent = value.get();
 	// push the old entry in the undo buffer for this transaction
 	transaction.PushCatalogEntry(value->child.get());
+	ModifyCatalog(*value->child);
 	data[name] = move(value);
 	return true;
 }
@@ -111,6 +112,7 @@ bool CatalogSet::AlterEntry(ClientContext &context, const string &name, AlterInf
 
 	// push the old entry in the undo buffer for this transaction
 	transaction.PushCatalogEntry(value->child.get(), serialized_alter.data.get(), serialized_alter.size);
+	ModifyCatalog(*value->child);
 	data[name] = move(value);
 
 	return true;
@@ -167,10 +169,20 @@ void CatalogSet::DropEntryInternal(Transaction &transaction, CatalogEntry &curre
 
 	// push the old entry in the undo buffer for this transaction
 	transaction.PushCatalogEntry(value->child.get());
+	ModifyCatalog(*value->child);
 
 	data[current.name] = move(value);
 }
 
+void CatalogSet::ModifyCatalog(CatalogEntry &entry) {
+	// prepared statements are local to a connection, they do not change the plans of queries
+	if (entry.type == CatalogType::PREPARED_STATEMENT ||
+	    (entry.parent && entry.parent->type == CatalogType::PREPARED_STATEMENT)) {
+		return;
+	}
+	catalog.ModifyCatalog();
+}
+
 bool CatalogSet::HasConflict(Transaction &transaction, CatalogEntry &current) {
 	return (current.timestamp >= TRANSACTION_ID_START && current.timestamp != transaction.transaction_id) ||
 	       (current.timestamp < TRANSACTION_ID_START && current.timestamp > transaction.start_time);
@@ -220,6 +232,7 @@ void CatalogSet::Undo(CatalogEntry *entry) {
 	// and entry->parent has to be removed ("rolled back")
 
 	// i.e. we have to place (entry) as (entry->parent) again
+	ModifyCatalog(*entry);
 	auto &to_be_removed_node = entry->parent;
 	if (!to_be_removed_node->deleted) {
 		// delete the entry from the dependency manager as well
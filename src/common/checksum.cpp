@@ -5,6 +5,16 @@ using namespace std;
 
 namespace duckdb {
 
+//! Hashes the remaining bytes of the buffer one byte at a time. This is part of the on-disk format: it is kept
+//! separate from the string hash, which can change without invalidating the checksums of existing database files.
+static uint64_t ChecksumRemainder(uint8_t *buffer, size_t size) {
+	uint64_t hash = 5381;
+	for (size_t i = 0; i < size; i++) {
+		hash = ((hash << 5) + hash) + (char)buffer[i];
+	}
+	return hash;
+}
+
 uint64_t Checksum(uint8_t *buffer, size_t size) {
 	uint64_t result = 5381;
 	uint64_t *ptr = (uint64_t *)buffer;
@@ -14,8 +24,8 @@ uint64_t Checksum(uint8_t *buffer, size_t size) {
 		result ^= Hash(ptr[i]);
 	}
 	if (size - i * 8 > 0) {
-		// the remaining 0-7 bytes we hash using a string hash
-		result ^= Hash(buffer + i * 8, size - i * 8);
+		// the remaining 0-7 bytes we hash one byte at a time
+		result ^= ChecksumRemainder(buffer + i * 8, size - i * 8);
 	}
 	return result;
 }
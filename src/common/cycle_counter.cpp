@@ -0,0 +1,31 @@
+#include "duckdb/common/cycle_counter.hpp"
+
+#include <thread>
+
+namespace duckdb {
+using namespace std;
+
+static double CalibrateTicksPerSecond() {
+#ifdef DUCKDB_HAS_RDTSC
+	// measure the amount of ticks that elapse during a short sleep
+	auto start_time = chrono::steady_clock::now();
+	auto start_ticks = CycleCounter::Tick();
+	this_thread::sleep_for(chrono::milliseconds(10));
+	auto end_ticks = CycleCounter::Tick();
+	auto end_time = chrono::steady_clock::now();
+	auto elapsed = chrono::duration_cast<chrono::duration<double>>(end_time - start_time).count();
+	if (elapsed <= 0 || end_ticks <= start_ticks) {
+		return 1e9;
+	}
+	return (end_ticks - start_ticks) / elapsed;
+#else
+	return 1e9;
+#endif
+}
+
+double CycleCounter::TicksPerSecond() {
+	static double ticks_per_second = CalibrateTicksPerSecond();
+	return ticks_per_second;
+}
+
+} // namespace duckdb
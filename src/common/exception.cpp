@@ -122,6 +122,10 @@ string Exception::ExceptionTypeToString(ExceptionType type) {
 		return "FATAL";
 	case ExceptionType::INTERNAL:
 		return "INTERNAL";
+	case ExceptionType::INVALID_INPUT:
+		return "Invalid Input";
+	case ExceptionType::OUT_OF_MEMORY:
+		return "Out of Memory";
 	default:
 		return "Unknown";
 	}
@@ -234,4 +238,7 @@ InternalException::InternalException(string msg) : Exception(ExceptionType::INTE
 InvalidInputException::InvalidInputException(string msg) : Exception(ExceptionType::INVALID_INPUT, msg) {
 }
 
+OutOfMemoryException::OutOfMemoryException(string msg) : Exception(ExceptionType::OUT_OF_MEMORY, msg) {
+}
+
 } // namespace duckdb
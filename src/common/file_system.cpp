@@ -1,5 +1,6 @@
 #include "duckdb/common/file_system.hpp"
 
+#include "duckdb/common/algorithm.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/helper.hpp"
 #include "duckdb/common/string_util.hpp"
@@ -31,6 +32,7 @@ static void AssertValidFileFlags(uint8_t flags) {
 #include <dirent.h>
 #include <fcntl.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -133,6 +135,24 @@ void FileSystem::SetFilePointer(FileHandle &handle, idx_t location) {
 	}
 }
 
+void FileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
+	int fd = ((UnixFileHandle &)handle).fd;
+	// pread does not move the file pointer, and can return less than the requested amount of bytes
+	auto read_buffer = (char *)buffer;
+	while (nr_bytes > 0) {
+		int64_t bytes_read = pread(fd, read_buffer, nr_bytes, location);
+		if (bytes_read == -1) {
+			throw IOException("Could not read from file \"%s\": %s", handle.path, strerror(errno));
+		}
+		if (bytes_read == 0) {
+			throw IOException("Could not read sufficient bytes from file \"%s\"", handle.path);
+		}
+		read_buffer += bytes_read;
+		nr_bytes -= bytes_read;
+		location += bytes_read;
+	}
+}
+
 int64_t FileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes) {
 	int fd = ((UnixFileHandle &)handle).fd;
 	int64_t bytes_read = read(fd, buffer, nr_bytes);
@@ -160,6 +180,23 @@ int64_t FileSystem::GetFileSize(FileHandle &handle) {
 	return s.st_size;
 }
 
+unique_ptr<MappedFile> FileSystem::MapFile(FileHandle &handle) {
+	int fd = ((UnixFileHandle &)handle).fd;
+	auto file_size = GetFileSize(handle);
+	if (file_size <= 0) {
+		return nullptr;
+	}
+	void *data = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		return nullptr;
+	}
+	return make_unique<MappedFile>((data_ptr_t)data, file_size);
+}
+
+MappedFile::~MappedFile() {
+	munmap(data, size);
+}
+
 void FileSystem::Truncate(FileHandle &handle, int64_t new_size) {
 	int fd = ((UnixFileHandle &)handle).fd;
 	if (ftruncate(fd, new_size) != 0) {
@@ -573,12 +610,28 @@ void FileSystem::MoveFile(const string &source, const string &target) {
 	}
 }
 
-void FileSystem::SetWorkingDirectory(string path) {
-	if (!SetCurrentDirectory(path.c_str())) {
-		throw IOException("Could not change working directory!");
+unique_ptr<MappedFile> FileSystem::MapFile(FileHandle &handle) {
+	HANDLE hFile = ((WindowsFileHandle &)handle).fd;
+	auto file_size = GetFileSize(handle);
+	if (file_size <= 0) {
+		return nullptr;
 	}
+	HANDLE mapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping) {
+		return nullptr;
+	}
+	auto data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	// the view keeps the mapping alive
+	CloseHandle(mapping);
+	if (!data) {
+		return nullptr;
+	}
+	return make_unique<MappedFile>((data_ptr_t)data, file_size);
+}
+
+MappedFile::~MappedFile() {
+	UnmapViewOfFile(data);
 }
-#endif
 
 void FileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
 	// seek to the location
@@ -590,6 +643,13 @@ void FileSystem::Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t
 	}
 }
 
+void FileSystem::SetWorkingDirectory(string path) {
+	if (!SetCurrentDirectory(path.c_str())) {
+		throw IOException("Could not change working directory!");
+	}
+}
+#endif
+
 void FileSystem::Write(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location) {
 	// seek to the location
 	SetFilePointer(handle, location);
@@ -605,6 +665,164 @@ string FileSystem::JoinPath(const string &a, const string &b) {
 	return a + PathSeparator() + b;
 }
 
+bool FileSystem::HasGlob(const string &str) {
+	for (idx_t i = 0; i < str.size(); i++) {
+		switch (str[i]) {
+		case '*':
+		case '?':
+		case '[':
+			return true;
+		default:
+			break;
+		}
+	}
+	return false;
+}
+
+//! Match a single path component against a glob pattern
+static bool glob_match(const char *name, const char *pattern) {
+	while (*pattern) {
+		switch (*pattern) {
+		case '*':
+			// skip consecutive stars, then try to match the remainder of the pattern at every position
+			while (*pattern == '*') {
+				pattern++;
+			}
+			if (!*pattern) {
+				return true;
+			}
+			for (; *name; name++) {
+				if (glob_match(name, pattern)) {
+					return true;
+				}
+			}
+			return false;
+		case '?':
+			if (!*name) {
+				return false;
+			}
+			break;
+		case '[': {
+			if (!*name) {
+				return false;
+			}
+			auto class_ptr = pattern + 1;
+			bool invert = *class_ptr == '!';
+			if (invert) {
+				class_ptr++;
+			}
+			// a ']' directly after the opening bracket is part of the character class
+			auto class_start = class_ptr;
+			bool found = false;
+			while (*class_ptr && (*class_ptr != ']' || class_ptr == class_start)) {
+				if (class_ptr[1] == '-' && class_ptr[2] && class_ptr[2] != ']') {
+					found = found || (*name >= class_ptr[0] && *name <= class_ptr[2]);
+					class_ptr += 3;
+				} else {
+					found = found || *name == *class_ptr;
+					class_ptr++;
+				}
+			}
+			if (!*class_ptr) {
+				// unterminated character class: match the '[' literally
+				if (*name != '[') {
+					return false;
+				}
+			} else {
+				if (found == invert) {
+					return false;
+				}
+				pattern = class_ptr;
+			}
+			break;
+		}
+		default:
+			if (*name != *pattern) {
+				return false;
+			}
+			break;
+		}
+		name++;
+		pattern++;
+	}
+	return !*name;
+}
+
+vector<string> FileSystem::Glob(const string &pattern) {
+	vector<string> result;
+	if (pattern.empty()) {
+		return result;
+	}
+	// split the pattern up into its path components
+	auto separator = PathSeparator();
+	bool absolute_path = pattern[0] == '/' || pattern[0] == separator[0];
+	vector<string> splits;
+	idx_t last_pos = 0;
+	for (idx_t i = 0; i <= pattern.size(); i++) {
+		if (i == pattern.size() || pattern[i] == '/' || pattern[i] == separator[0]) {
+			if (i > last_pos) {
+				splits.push_back(pattern.substr(last_pos, i - last_pos));
+			}
+			last_pos = i + 1;
+		}
+	}
+	// expand the components one by one, starting either from the root or from the working directory
+	vector<string> paths;
+	if (absolute_path) {
+		paths.push_back(string());
+	}
+	for (idx_t i = 0; i < splits.size(); i++) {
+		bool is_last = i + 1 == splits.size();
+		auto &split = splits[i];
+		vector<string> new_paths;
+		if (!HasGlob(split)) {
+			if (paths.empty() && !absolute_path) {
+				new_paths.push_back(split);
+			} else {
+				for (auto &path : paths) {
+					new_paths.push_back(JoinPath(path, split));
+				}
+			}
+		} else {
+			auto list_directory = [&](const string &directory, const string &prefix) {
+				vector<string> matches;
+				ListFiles(directory, [&](string name, bool is_directory) {
+					// intermediate components can only match directories, the final component only matches files
+					if (is_directory == is_last) {
+						return;
+					}
+					// wildcards do not match hidden files
+					if (name[0] == '.' && split[0] != '.') {
+						return;
+					}
+					if (glob_match(name.c_str(), split.c_str())) {
+						matches.push_back(prefix.empty() && directory == "." ? name : JoinPath(prefix, name));
+					}
+				});
+				new_paths.insert(new_paths.end(), matches.begin(), matches.end());
+			};
+			if (paths.empty() && !absolute_path) {
+				list_directory(".", string());
+			} else {
+				for (auto &path : paths) {
+					list_directory(path.empty() ? separator : path, path);
+				}
+			}
+		}
+		paths = move(new_paths);
+		if (paths.empty()) {
+			return result;
+		}
+	}
+	for (auto &path : paths) {
+		if (FileExists(path)) {
+			result.push_back(path);
+		}
+	}
+	sort(result.begin(), result.end());
+	return result;
+}
+
 void FileHandle::Read(void *buffer, idx_t nr_bytes, idx_t location) {
 	file_system.Read(*this, buffer, nr_bytes, location);
 }
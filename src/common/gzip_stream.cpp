@@ -7,6 +7,8 @@
 #include "miniz.hpp"
 
 #include "duckdb/common/limits.hpp"
+
+#include <cstring>
 using namespace duckdb_miniz;
 using namespace std;
 namespace duckdb {
@@ -54,12 +56,16 @@ namespace duckdb {
 
  */
 
-static idx_t consume_string(fstream &input) {
-	idx_t size = 1; // terminator
-	while (input.get() != '\0') {
-		size++;
+static void consume_string(fstream &input) {
+	while (true) {
+		auto c = input.get();
+		if (c == '\0') {
+			return;
+		}
+		if (c == fstream::traits_type::eof()) {
+			throw Exception("Input is not a GZIP stream");
+		}
 	}
-	return size;
 }
 
 static const uint8_t GZIP_COMPRESSION_DEFLATE = 0x08;
@@ -72,29 +78,23 @@ static const uint8_t GZIP_FLAG_COMMENT = 0x10;
 static const uint8_t GZIP_FLAG_ENCRYPT = 0x20;
 
 static const uint8_t GZIP_HEADER_MINSIZE = 10;
+static const uint8_t GZIP_FOOTER_SIZE = 8;
 
-static const unsigned char GZIP_FLAG_UNSUPPORTED =
-    GZIP_FLAG_ASCII | GZIP_FLAG_MULTIPART | GZIP_FLAG_EXTRA | GZIP_FLAG_COMMENT | GZIP_FLAG_ENCRYPT;
-
-void GzipStreamBuf::initialize() {
-	if (is_initialized) {
-		return;
-	}
-	assert(BUFFER_SIZE >= 3); // found to work fine with 3
-	uint8_t gzip_hdr[10];
-	data_start = GZIP_HEADER_MINSIZE;
-
-	in_buff = new data_t[BUFFER_SIZE];
-	in_buff_start = in_buff;
-	in_buff_end = in_buff;
-	out_buff = new data_t[BUFFER_SIZE];
-
-	mz_stream_ptr = new mz_stream();
-	// TODO use custom alloc/free methods in miniz to throw exceptions on OOM
+static const unsigned char GZIP_FLAG_UNSUPPORTED = GZIP_FLAG_ASCII | GZIP_FLAG_MULTIPART | GZIP_FLAG_ENCRYPT;
 
-	FstreamUtil::OpenFile(filename, input, ios::in | ios::binary);
+//! The size of the buffer that compressed data is read into
+static const idx_t GZIP_INPUT_BUFFER_SIZE = 262144;
 
+//! Reads the header of the next member of the file and positions the stream at the start of its payload data. Returns
+//! false if there are no more members: like gzip, any data after the last member that does not start with the magic
+//! header (e.g. zero padding) is ignored.
+static bool read_member_header(fstream &input, bool first_member) {
+	uint8_t gzip_hdr[GZIP_HEADER_MINSIZE];
 	input.read((char *)gzip_hdr, GZIP_HEADER_MINSIZE);
+	if (!first_member && (input.gcount() < 2 || gzip_hdr[0] != 0x1F || gzip_hdr[1] != 0x8B)) {
+		// no more members
+		return false;
+	}
 	if (!input) {
 		throw Exception("Input is not a GZIP stream");
 	}
@@ -108,104 +108,175 @@ void GzipStreamBuf::initialize() {
 		throw Exception("Unsupported GZIP archive");
 	}
 
+	if (gzip_hdr[3] & GZIP_FLAG_EXTRA) {
+		uint8_t extra_len[2];
+		input.read((char *)extra_len, 2);
+		input.seekg(extra_len[0] | (extra_len[1] << 8), input.cur);
+	}
 	if (gzip_hdr[3] & GZIP_FLAG_NAME) {
-		input.seekg(data_start, input.beg);
-		data_start += consume_string(input);
+		consume_string(input);
+	}
+	if (gzip_hdr[3] & GZIP_FLAG_COMMENT) {
+		consume_string(input);
+	}
+	if (!input) {
+		throw Exception("Input is not a GZIP stream");
 	}
-	input.seekg(data_start, input.beg);
 	// stream is now set to beginning of payload data
+	return true;
+}
+
+//! Wraps a miniz inflate stream so that it is cleaned up when an exception is thrown
+struct GzipInflater {
+	GzipInflater() {
+		memset(&stream, 0, sizeof(mz_stream));
+		// TODO use custom alloc/free methods in miniz to throw exceptions on OOM
+		auto ret = mz_inflateInit2(&stream, -MZ_DEFAULT_WINDOW_BITS);
+		if (ret != MZ_OK) {
+			throw Exception("Failed to initialize miniz");
+		}
+	}
+	~GzipInflater() {
+		mz_inflateEnd(&stream);
+	}
 
-	auto ret = mz_inflateInit2((mz_streamp)mz_stream_ptr, -MZ_DEFAULT_WINDOW_BITS);
-	if (ret != MZ_OK) {
-		throw Exception("Failed to initialize miniz");
+	mz_stream stream;
+};
+
+static GzipBlock new_block() {
+	GzipBlock block;
+	block.data = unique_ptr<data_t[]>(new data_t[GzipStreamBuf::BLOCK_SIZE]);
+	return block;
+}
+
+void GzipStreamBuf::initialize() {
+	if (is_initialized) {
+		return;
 	}
 	// initialize eback, gptr, egptr
-	setg((char *)out_buff, (char *)out_buff, (char *)out_buff);
+	setg(nullptr, nullptr, nullptr);
+	decompress_thread = make_unique<thread>(&GzipStreamBuf::Decompress, this);
 	is_initialized = true;
 }
 
-streambuf::int_type GzipStreamBuf::underflow() {
-	if (!is_initialized) {
-		initialize();
+void GzipStreamBuf::Decompress() {
+	try {
+		fstream input;
+		FstreamUtil::OpenFile(filename, input, ios::in | ios::binary);
+		InflateMembers(input);
+	} catch (std::exception &ex) {
+		lock_guard<mutex> glock(lock);
+		error = ex.what();
 	}
-
-	// adapted from https://github.com/mateidavid/zstr
-	auto zstrm_p = (mz_streamp)mz_stream_ptr;
-	if (!zstrm_p) {
-		return traits_type::eof();
+	{
+		lock_guard<mutex> glock(lock);
+		finished = true;
 	}
+	cv.notify_all();
+}
 
-	if (gptr() == egptr()) {
-		// pointers for free region in output buffer
-		auto out_buff_free_start = out_buff;
-		do {
-			assert(in_buff_start <= in_buff_end);
-			assert(in_buff_end <= in_buff_start + BUFFER_SIZE);
-
+void GzipStreamBuf::InflateMembers(fstream &input) {
+	auto in_buff = unique_ptr<data_t[]>(new data_t[GZIP_INPUT_BUFFER_SIZE]);
+	auto block = new_block();
+	// the members of a file are concatenated: decompress them one after the other into the same output
+	for (bool first_member = true; read_member_header(input, first_member); first_member = false) {
+		GzipInflater inflater;
+		auto &zstrm = inflater.stream;
+		// the file offset of the data in the input buffer, and the amount of data in it
+		idx_t in_buff_offset = (idx_t)input.tellg();
+		idx_t in_buff_size = 0;
+		while (true) {
 			// read more input if none available
-			if (in_buff_start == in_buff_end) {
-				// empty input buffer: refill from the start
-				in_buff_start = in_buff;
-				std::streamsize sz = input.rdbuf()->sgetn((char *)in_buff, BUFFER_SIZE);
-				if (sz == 0) {
-					break; // end of input
+			if (zstrm.avail_in == 0) {
+				in_buff_offset += in_buff_size;
+				in_buff_size = input.rdbuf()->sgetn((char *)in_buff.get(), GZIP_INPUT_BUFFER_SIZE);
+				if (in_buff_size == 0) {
+					// the input ended in the middle of a member
+					throw Exception("Unexpected end of GZIP stream: the file is truncated");
 				}
-				in_buff_end = in_buff + sz;
+				zstrm.next_in = in_buff.get();
+				zstrm.avail_in = (uint32_t)in_buff_size;
 			}
-
-			// actually decompress
-			assert(zstrm_p);
-			zstrm_p->next_in = (data_ptr_t)in_buff_start;
-			assert(in_buff_end - in_buff_start < NumericLimits<int32_t>::Maximum());
-			zstrm_p->avail_in = (uint32_t)(in_buff_end - in_buff_start);
-			zstrm_p->next_out = (data_ptr_t)out_buff_free_start;
-			assert((out_buff + BUFFER_SIZE) - out_buff_free_start < NumericLimits<int32_t>::Maximum());
-			zstrm_p->avail_out = (uint32_t)((out_buff + BUFFER_SIZE) - out_buff_free_start);
-			auto ret = mz_inflate(zstrm_p, MZ_NO_FLUSH);
+			// actually decompress into the free region of the output block
+			zstrm.next_out = block.data.get() + block.size;
+			zstrm.avail_out = (uint32_t)(BLOCK_SIZE - block.size);
+			auto ret = mz_inflate(&zstrm, MZ_NO_FLUSH);
 			if (ret != MZ_OK && ret != MZ_STREAM_END) {
 				throw Exception(mz_error(ret));
 			}
-			// update pointers following inflate()
-			in_buff_start = (data_ptr_t)zstrm_p->next_in;
-			in_buff_end = in_buff_start + zstrm_p->avail_in;
-			out_buff_free_start = (data_ptr_t)zstrm_p->next_out;
-			assert(out_buff_free_start + zstrm_p->avail_out == out_buff + BUFFER_SIZE);
-			// if stream ended, deallocate inflator
+			block.size = BLOCK_SIZE - zstrm.avail_out;
+			if (block.size == BLOCK_SIZE) {
+				// the block is full: hand it to the consumer
+				if (!PushBlock(move(block))) {
+					return;
+				}
+				block = new_block();
+			}
 			if (ret == MZ_STREAM_END) {
-				mz_inflateEnd(zstrm_p);
-				delete zstrm_p;
-				mz_stream_ptr = nullptr;
 				break;
 			}
+		}
+		// the member has ended: skip its footer, the next member (if any) follows directly after it
+		idx_t member_end = in_buff_offset + (zstrm.next_in - in_buff.get());
+		input.clear();
+		input.seekg(member_end + GZIP_FOOTER_SIZE, input.beg);
+	}
+	if (block.size > 0) {
+		PushBlock(move(block));
+	}
+}
 
-		} while (out_buff_free_start == out_buff);
-		// 2 exit conditions:
-		// - end of input: there might or might not be output available
-		// - out_buff_free_start != out_buff: output available
-		setg((char *)out_buff, (char *)out_buff, (char *)out_buff_free_start);
+bool GzipStreamBuf::PushBlock(GzipBlock block) {
+	unique_lock<mutex> glock(lock);
+	cv.wait(glock, [&] { return blocks.size() < MAX_QUEUED_BLOCKS || cancelled; });
+	if (cancelled) {
+		return false;
 	}
+	blocks.push_back(move(block));
+	glock.unlock();
+	cv.notify_all();
+	return true;
+}
 
-	// ensure all those pointers point at something sane
-	assert(out_buff);
-	assert(gptr() <= egptr());
-	assert(eback() == (char *)out_buff);
-	assert(gptr() >= (char *)out_buff);
-	assert(gptr() <= (char *)out_buff + BUFFER_SIZE);
-	assert(egptr() >= (char *)out_buff);
-	assert(egptr() <= (char *)out_buff + BUFFER_SIZE);
-	assert(gptr() <= egptr());
+streambuf::int_type GzipStreamBuf::underflow() {
+	if (!is_initialized) {
+		initialize();
+	}
 
-	return this->gptr() == this->egptr() ? traits_type::eof() : traits_type::to_int_type(*this->gptr());
+	if (gptr() == egptr()) {
+		// the current block has been read: wait for the next block
+		unique_lock<mutex> glock(lock);
+		cv.wait(glock, [&] { return !blocks.empty() || finished; });
+		if (blocks.empty()) {
+			// the background thread has finished and all blocks have been read
+			if (!error.empty()) {
+				throw Exception(error);
+			}
+			return traits_type::eof();
+		}
+		current_block = move(blocks.front());
+		blocks.pop_front();
+		glock.unlock();
+		// there is room for another block again
+		cv.notify_all();
+
+		auto data = (char *)current_block.data.get();
+		setg(data, data, data + current_block.size);
+	}
+	assert(gptr() < egptr());
+	return traits_type::to_int_type(*this->gptr());
 }
 
 GzipStreamBuf::~GzipStreamBuf() {
-	delete[] in_buff;
-	delete[] out_buff;
-	auto zstrm_p = (mz_streamp)mz_stream_ptr;
-	if (zstrm_p) {
-		mz_inflateEnd(zstrm_p);
+	if (decompress_thread) {
+		// stop the background thread if it is still running
+		{
+			lock_guard<mutex> glock(lock);
+			cancelled = true;
+		}
+		cv.notify_all();
+		decompress_thread->join();
 	}
-	delete zstrm_p;
 }
 
 } // namespace duckdb
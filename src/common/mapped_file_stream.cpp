@@ -0,0 +1,36 @@
+#include "duckdb/common/mapped_file_stream.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+MappedFileStreamBuf::MappedFileStreamBuf(unique_ptr<MappedFile> mapping_p) : mapping(move(mapping_p)) {
+	auto data = (char *)mapping->data;
+	setg(data, data, data + mapping->size);
+}
+
+streambuf::pos_type MappedFileStreamBuf::seekoff(off_type offset, ios_base::seekdir dir, ios_base::openmode which) {
+	char *target;
+	switch (dir) {
+	case ios_base::beg:
+		target = eback() + offset;
+		break;
+	case ios_base::cur:
+		target = gptr() + offset;
+		break;
+	default:
+		target = egptr() + offset;
+		break;
+	}
+	if (!(which & ios_base::in) || target < eback() || target > egptr()) {
+		return pos_type(off_type(-1));
+	}
+	setg(eback(), target, egptr());
+	return pos_type(target - eback());
+}
+
+streambuf::pos_type MappedFileStreamBuf::seekpos(pos_type position, ios_base::openmode which) {
+	return seekoff(off_type(position), ios_base::beg, which);
+}
+
+} // namespace duckdb
@@ -28,6 +28,29 @@ void ChunkCollection::Append(ChunkCollection &other) {
 	}
 }
 
+idx_t ChunkCollection::MemoryUsage() {
+	idx_t row_width = 0;
+	for (auto &type : types) {
+		row_width += GetTypeIdSize(type.InternalType());
+	}
+	idx_t memory_usage = chunks.size() * STANDARD_VECTOR_SIZE * row_width + string_heap_size;
+	if (!chunks.empty()) {
+		// the last chunk can still be appended to: its string heaps are not included in string_heap_size yet
+		memory_usage += StringHeapSize(*chunks.back());
+	}
+	return memory_usage;
+}
+
+idx_t ChunkCollection::StringHeapSize(DataChunk &chunk) {
+	idx_t size = 0;
+	for (idx_t col_idx = 0; col_idx < chunk.column_count(); col_idx++) {
+		if (chunk.data[col_idx].type.InternalType() == PhysicalType::VARCHAR) {
+			size += StringVector::HeapSize(chunk.data[col_idx]);
+		}
+	}
+	return size;
+}
+
 void ChunkCollection::Append(DataChunk &new_chunk) {
 	if (new_chunk.size() == 0) {
 		return;
@@ -96,6 +119,10 @@ void ChunkCollection::Append(DataChunk &new_chunk) {
 		auto chunk = make_unique<DataChunk>();
 		chunk->Initialize(types);
 		new_chunk.Copy(*chunk, offset);
+		if (!chunks.empty()) {
+			// the previous chunk is full: its string heaps no longer grow
+			string_heap_size += StringHeapSize(*chunks.back());
+		}
 		chunks.push_back(move(chunk));
 	}
 }
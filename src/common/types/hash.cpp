@@ -3,6 +3,7 @@
 
 #include "duckdb/common/exception.hpp"
 
+#include <cstring>
 #include <functional>
 
 using namespace std;
@@ -34,18 +35,61 @@ template <> hash_t Hash(interval_t val) {
 }
 
 template <> hash_t Hash(const char *str) {
-	hash_t hash = 5381;
-	hash_t c;
+	return Hash(str, strlen(str));
+}
 
-	while ((c = *str++)) {
-		hash = ((hash << 5) + hash) + c;
-	}
+// strings are hashed 8 bytes at a time using MurmurHash64A
+static constexpr hash_t STRING_HASH_SEED = 0xe17a1465;
+static constexpr hash_t STRING_HASH_MULTIPLIER = 0xc6a4a7935bd1e995;
+static constexpr int STRING_HASH_SHIFT = 47;
+
+static inline hash_t StringHashStart(size_t size) {
+	return STRING_HASH_SEED ^ (size * STRING_HASH_MULTIPLIER);
+}
 
-	return hash;
+static inline hash_t StringHashWord(hash_t hash, uint64_t word) {
+	word *= STRING_HASH_MULTIPLIER;
+	word ^= word >> STRING_HASH_SHIFT;
+	word *= STRING_HASH_MULTIPLIER;
+	return (hash ^ word) * STRING_HASH_MULTIPLIER;
+}
+
+//! Hashes the remaining (1-7) bytes of a string, zero-padded to a word
+static inline hash_t StringHashTail(hash_t hash, uint64_t tail) {
+	return (hash ^ tail) * STRING_HASH_MULTIPLIER;
+}
+
+static inline hash_t StringHashFinalize(hash_t hash) {
+	hash ^= hash >> STRING_HASH_SHIFT;
+	hash *= STRING_HASH_MULTIPLIER;
+	return hash ^ (hash >> STRING_HASH_SHIFT);
 }
 
 template <> hash_t Hash(string_t val) {
-	return Hash(val.GetData(), val.GetSize());
+	auto size = val.GetSize();
+	if (!val.IsInlined()) {
+		return Hash(val.GetData(), size);
+	}
+	// short strings are stored inside the string_t itself: hash them using fixed-size loads, masking out the bytes
+	// past the end of the string
+	auto data = val.GetPrefix();
+	uint64_t first;
+	uint32_t second;
+	memcpy(&first, data, sizeof(uint64_t));
+	memcpy(&second, data + sizeof(uint64_t), sizeof(uint32_t));
+
+	auto hash = StringHashStart(size);
+	if (size >= sizeof(uint64_t)) {
+		hash = StringHashWord(hash, first);
+		auto remaining = size - sizeof(uint64_t);
+		if (remaining > 0) {
+			// the mask is computed in 64 bits so that a tail of a full 4 bytes is masked correctly as well
+			hash = StringHashTail(hash, uint64_t(second) & ((uint64_t(1) << (remaining * 8)) - 1));
+		}
+	} else if (size > 0) {
+		hash = StringHashTail(hash, first & ((uint64_t(1) << (size * 8)) - 1));
+	}
+	return StringHashFinalize(hash);
 }
 
 template <> hash_t Hash(char *val) {
@@ -53,13 +97,18 @@ template <> hash_t Hash(char *val) {
 }
 
 hash_t Hash(const char *val, size_t size) {
-	hash_t hash = 5381;
-
-	for (size_t i = 0; i < size; i++) {
-		hash = ((hash << 5) + hash) + val[i];
+	auto hash = StringHashStart(size);
+	for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), val += sizeof(uint64_t)) {
+		uint64_t word;
+		memcpy(&word, val, sizeof(uint64_t));
+		hash = StringHashWord(hash, word);
 	}
-
-	return hash;
+	if (size > 0) {
+		uint64_t tail = 0;
+		memcpy(&tail, val, size);
+		hash = StringHashTail(hash, tail);
+	}
+	return StringHashFinalize(hash);
 }
 
 hash_t Hash(char *val, size_t size) {
@@ -0,0 +1,104 @@
+#include "duckdb/common/types/hyperloglog.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace duckdb {
+using namespace std;
+
+HyperLogLog::HyperLogLog() {
+	memset(registers, 0, sizeof(registers));
+}
+
+//! The hash functions used for hash tables only need to distribute values over the buckets, and are not uniform
+//! enough over all 64 bits for the sketch. The finalizer of MurmurHash3 mixes every input bit into every output bit.
+static inline uint64_t MixHash(uint64_t x) {
+	x ^= x >> 33;
+	x *= UINT64_C(0xff51afd7ed558ccd);
+	x ^= x >> 33;
+	x *= UINT64_C(0xc4ceb9fe1a85ec53);
+	x ^= x >> 33;
+	return x;
+}
+
+void HyperLogLog::Add(hash_t hash) {
+	auto mixed = MixHash(hash);
+	// the upper bits select the register
+	auto index = mixed >> RANK_BITS;
+	// the rank is the position of the first set bit in the remaining bits
+	uint64_t mask = uint64_t(1) << (RANK_BITS - 1);
+	uint8_t rank = 1;
+	while (rank <= RANK_BITS && !(mixed & mask)) {
+		rank++;
+		mask >>= 1;
+	}
+	if (rank > registers[index]) {
+		registers[index] = rank;
+	}
+}
+
+void HyperLogLog::Merge(const HyperLogLog &other) {
+	for (idx_t i = 0; i < REGISTER_COUNT; i++) {
+		registers[i] = MaxValue<uint8_t>(registers[i], other.registers[i]);
+	}
+}
+
+// The estimator below is the "improved raw estimator" of Ertl (2017), "New cardinality estimation algorithms for
+// HyperLogLog sketches". Unlike the original estimator it does not need empirical bias correction tables and is
+// unbiased over the full cardinality range, including small cardinalities.
+static double EstimatorSigma(double x) {
+	if (x == 1) {
+		return numeric_limits<double>::infinity();
+	}
+	double y = 1;
+	double z = x;
+	double previous;
+	do {
+		x *= x;
+		previous = z;
+		z += x * y;
+		y += y;
+	} while (z != previous);
+	return z;
+}
+
+static double EstimatorTau(double x) {
+	if (x == 0 || x == 1) {
+		return 0;
+	}
+	double y = 1;
+	double z = 1 - x;
+	double previous;
+	do {
+		x = sqrt(x);
+		previous = z;
+		y *= 0.5;
+		z -= (1 - x) * (1 - x) * y;
+	} while (z != previous);
+	return z / 3;
+}
+
+idx_t HyperLogLog::Count() const {
+	// compute the histogram of the register values
+	idx_t histogram[RANK_BITS + 2];
+	memset(histogram, 0, sizeof(histogram));
+	for (idx_t i = 0; i < REGISTER_COUNT; i++) {
+		histogram[registers[i]]++;
+	}
+	if (histogram[0] == REGISTER_COUNT) {
+		// no values were added
+		return 0;
+	}
+	double m = REGISTER_COUNT;
+	double z = m * EstimatorTau(1 - histogram[RANK_BITS + 1] / m);
+	for (idx_t k = RANK_BITS; k >= 1; k--) {
+		z = 0.5 * (z + histogram[k]);
+	}
+	z += m * EstimatorSigma(histogram[0] / m);
+	// alpha for an infinite amount of registers: 1 / (2 * ln(2))
+	double alpha = 0.5 / log(2.0);
+	return (idx_t)llround(alpha * m * m / z);
+}
+
+} // namespace duckdb
@@ -12,7 +12,7 @@ using namespace std;
 
 #define MINIMUM_HEAP_SIZE 4096
 
-StringHeap::StringHeap() : tail(nullptr) {
+StringHeap::StringHeap() : tail(nullptr), allocated_size(0) {
 }
 
 string_t StringHeap::AddString(const char *data, idx_t len) {
@@ -45,6 +45,7 @@ string_t StringHeap::EmptyString(idx_t len) {
 	if (!chunk || chunk->current_position + len >= chunk->maximum_size) {
 		// have to make a new entry
 		auto new_chunk = make_unique<StringChunk>(MaxValue<idx_t>(len + 1, MINIMUM_HEAP_SIZE));
+		allocated_size += new_chunk->maximum_size;
 		new_chunk->prev = move(chunk);
 		chunk = move(new_chunk);
 		if (!tail) {
@@ -65,7 +66,9 @@ void StringHeap::MergeHeap(StringHeap &other) {
 	if (!tail) {
 		tail = this->chunk.get();
 	}
+	allocated_size += other.allocated_size;
 	other.tail = nullptr;
+	other.allocated_size = 0;
 }
 
 } // namespace duckdb
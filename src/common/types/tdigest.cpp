@@ -0,0 +1,125 @@
+#include "duckdb/common/types/tdigest.hpp"
+
+#include "duckdb/common/algorithm.hpp"
+#include "duckdb/common/assert.hpp"
+
+#include <cmath>
+
+namespace duckdb {
+using namespace std;
+
+constexpr double TDigest::DEFAULT_COMPRESSION;
+
+static constexpr double TDIGEST_PI = 3.14159265358979323846;
+
+TDigest::TDigest(double compression) : compression(compression), total_weight(0), min(0), max(0) {
+}
+
+void TDigest::Add(double value, double weight) {
+	if (total_weight == 0) {
+		min = max = value;
+	} else {
+		min = MinValue<double>(min, value);
+		max = MaxValue<double>(max, value);
+	}
+	unmerged.push_back(Centroid(value, weight));
+	total_weight += weight;
+	if (unmerged.size() >= 5 * compression) {
+		Compress();
+	}
+}
+
+void TDigest::Merge(const TDigest &other) {
+	if (other.total_weight == 0) {
+		return;
+	}
+	if (total_weight == 0) {
+		min = other.min;
+		max = other.max;
+	} else {
+		min = MinValue<double>(min, other.min);
+		max = MaxValue<double>(max, other.max);
+	}
+	unmerged.insert(unmerged.end(), other.centroids.begin(), other.centroids.end());
+	unmerged.insert(unmerged.end(), other.unmerged.begin(), other.unmerged.end());
+	total_weight += other.total_weight;
+	if (unmerged.size() >= 5 * compression) {
+		Compress();
+	}
+}
+
+// the scale function k1, and its inverse, bound the size of the centroids: a centroid can span at most one unit of k
+static double ScaleFunction(double quantile, double compression) {
+	return compression / (2 * TDIGEST_PI) * asin(2 * quantile - 1);
+}
+
+static double InverseScaleFunction(double k, double compression) {
+	return (sin(k * 2 * TDIGEST_PI / compression) + 1) / 2;
+}
+
+void TDigest::Compress() {
+	if (unmerged.empty()) {
+		return;
+	}
+	unmerged.insert(unmerged.end(), centroids.begin(), centroids.end());
+	sort(unmerged.begin(), unmerged.end(), [](const Centroid &a, const Centroid &b) { return a.mean < b.mean; });
+
+	centroids.clear();
+	double weight_so_far = 0;
+	double quantile_limit = InverseScaleFunction(ScaleFunction(0, compression) + 1, compression);
+	auto current = unmerged[0];
+	for (idx_t i = 1; i < unmerged.size(); i++) {
+		auto &next = unmerged[i];
+		double proposed_quantile = (weight_so_far + current.weight + next.weight) / total_weight;
+		if (proposed_quantile <= quantile_limit) {
+			// the next centroid fits into the current centroid: merge them
+			current.weight += next.weight;
+			current.mean += (next.mean - current.mean) * next.weight / current.weight;
+		} else {
+			// start a new centroid
+			weight_so_far += current.weight;
+			centroids.push_back(current);
+			quantile_limit = InverseScaleFunction(
+			    ScaleFunction(MinValue<double>(weight_so_far / total_weight, 1), compression) + 1, compression);
+			current = next;
+		}
+	}
+	centroids.push_back(current);
+	unmerged.clear();
+}
+
+double TDigest::Quantile(double quantile) {
+	assert(total_weight > 0);
+	Compress();
+	if (centroids.size() == 1) {
+		return centroids[0].mean;
+	}
+	// the position of the requested quantile in the (weighted) sorted values
+	double index = quantile * total_weight;
+	// every centroid is centered around the middle of the values it represents
+	auto &first = centroids[0];
+	if (index < first.weight / 2) {
+		// interpolate between the minimum and the first centroid
+		return min + (first.mean - min) * index / (first.weight / 2);
+	}
+	double weight_so_far = first.weight / 2;
+	for (idx_t i = 0; i + 1 < centroids.size(); i++) {
+		auto &left = centroids[i];
+		auto &right = centroids[i + 1];
+		double distance = (left.weight + right.weight) / 2;
+		if (index < weight_so_far + distance) {
+			// interpolate between the centers of the two neighbouring centroids
+			return left.mean + (right.mean - left.mean) * (index - weight_so_far) / distance;
+		}
+		weight_so_far += distance;
+	}
+	// interpolate between the last centroid and the maximum
+	auto &last = centroids.back();
+	double remaining = total_weight - weight_so_far;
+	if (remaining <= 0) {
+		return max;
+	}
+	return last.mean + (max - last.mean) * MinValue<double>((index - weight_so_far) / remaining, 1);
+}
+
+} // namespace duckdb
@@ -836,6 +836,14 @@ string_t StringVector::EmptyString(Vector &vector, idx_t len) {
 	return string_buffer.EmptyString(len);
 }
 
+idx_t StringVector::HeapSize(Vector &vector) {
+	assert(vector.type.InternalType() == PhysicalType::VARCHAR);
+	if (!vector.auxiliary || vector.auxiliary->type != VectorBufferType::STRING_BUFFER) {
+		return 0;
+	}
+	return ((VectorStringBuffer &)*vector.auxiliary).AllocatedSize();
+}
+
 void StringVector::AddHeapReference(Vector &vector, Vector &other) {
 	assert(vector.type.InternalType() == PhysicalType::VARCHAR);
 	assert(other.type.InternalType() == PhysicalType::VARCHAR);
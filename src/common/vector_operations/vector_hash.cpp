@@ -34,6 +34,39 @@ static inline void tight_loop_hash(T *__restrict ldata, hash_t *__restrict resul
 	}
 }
 
+//! Hashes a dictionary vector by hashing every referenced entry of the dictionary only once. Only worthwhile for types
+//! that are expensive to hash (i.e. strings), and only if the dictionary is much smaller than the vector. Returns
+//! false if the vector is not hashed this way.
+template <bool HAS_RSEL, class T>
+static bool dictionary_loop_hash(Vector &input, VectorData &idata, hash_t *__restrict result_data,
+                                 const SelectionVector *rsel, idx_t count) {
+	if (!std::is_same<T, string_t>::value || input.vector_type != VectorType::DICTIONARY_VECTOR) {
+		return false;
+	}
+	idx_t dictionary_size = 0;
+	for (idx_t i = 0; i < count; i++) {
+		auto ridx = HAS_RSEL ? rsel->get_index(i) : i;
+		dictionary_size = MaxValue<idx_t>(dictionary_size, idata.sel->get_index(ridx) + 1);
+	}
+	if (dictionary_size * 2 > count) {
+		return false;
+	}
+	auto ldata = (T *)idata.data;
+	auto dictionary_hashes = unique_ptr<hash_t[]>(new hash_t[dictionary_size]);
+	auto hashed = unique_ptr<bool[]>(new bool[dictionary_size]);
+	memset(hashed.get(), 0, dictionary_size * sizeof(bool));
+	for (idx_t i = 0; i < count; i++) {
+		auto ridx = HAS_RSEL ? rsel->get_index(i) : i;
+		auto idx = idata.sel->get_index(ridx);
+		if (!hashed[idx]) {
+			dictionary_hashes[idx] = HashOp::Operation(ldata[idx], (*idata.nullmask)[idx]);
+			hashed[idx] = true;
+		}
+		result_data[ridx] = dictionary_hashes[idx];
+	}
+	return true;
+}
+
 template <bool HAS_RSEL, class T>
 static inline void templated_loop_hash(Vector &input, Vector &result, const SelectionVector *rsel, idx_t count) {
 	if (input.vector_type == VectorType::CONSTANT_VECTOR) {
@@ -48,8 +81,11 @@ static inline void templated_loop_hash(Vector &input, Vector &result, const Sele
 		VectorData idata;
 		input.Orrify(count, idata);
 
-		tight_loop_hash<HAS_RSEL, T>((T *)idata.data, FlatVector::GetData<hash_t>(result), rsel, count, idata.sel,
-		                             *idata.nullmask);
+		auto result_data = FlatVector::GetData<hash_t>(result);
+		if (dictionary_loop_hash<HAS_RSEL, T>(input, idata, result_data, rsel, count)) {
+			return;
+		}
+		tight_loop_hash<HAS_RSEL, T>((T *)idata.data, result_data, rsel, count, idata.sel, *idata.nullmask);
 	}
 }
 
@@ -145,6 +181,15 @@ static inline void tight_loop_combine_hash(T *__restrict ldata, hash_t *__restri
 	}
 }
 
+template <bool HAS_RSEL>
+static inline void combine_dictionary_hashes(hash_t *__restrict hash_data, hash_t *__restrict other_hashes,
+                                             const SelectionVector *rsel, idx_t count) {
+	for (idx_t i = 0; i < count; i++) {
+		auto ridx = HAS_RSEL ? rsel->get_index(i) : i;
+		hash_data[ridx] = combine_hash(hash_data[ridx], other_hashes[ridx]);
+	}
+}
+
 template <bool HAS_RSEL, class T>
 void templated_loop_combine_hash(Vector &input, Vector &hashes, const SelectionVector *rsel, idx_t count) {
 	if (input.vector_type == VectorType::CONSTANT_VECTOR && hashes.vector_type == VectorType::CONSTANT_VECTOR) {
@@ -156,7 +201,20 @@ void templated_loop_combine_hash(Vector &input, Vector &hashes, const SelectionV
 	} else {
 		VectorData idata;
 		input.Orrify(count, idata);
-		if (hashes.vector_type == VectorType::CONSTANT_VECTOR) {
+		hash_t dictionary_hashes[STANDARD_VECTOR_SIZE];
+		if (dictionary_loop_hash<HAS_RSEL, T>(input, idata, dictionary_hashes, rsel, count)) {
+			if (hashes.vector_type == VectorType::CONSTANT_VECTOR) {
+				// spread the constant hash over a flat vector first
+				auto constant_hash = *ConstantVector::GetData<hash_t>(hashes);
+				hashes.Initialize(hashes.type);
+				auto hash_data = FlatVector::GetData<hash_t>(hashes);
+				for (idx_t i = 0; i < count; i++) {
+					hash_data[HAS_RSEL ? rsel->get_index(i) : i] = constant_hash;
+				}
+			}
+			assert(hashes.vector_type == VectorType::FLAT_VECTOR);
+			combine_dictionary_hashes<HAS_RSEL>(FlatVector::GetData<hash_t>(hashes), dictionary_hashes, rsel, count);
+		} else if (hashes.vector_type == VectorType::CONSTANT_VECTOR) {
 			// mix constant with non-constant, first get the constant value
 			auto constant_hash = *ConstantVector::GetData<hash_t>(hashes);
 			// now re-initialize the hashes vector to an empty flat vector
@@ -1,13 +1,14 @@
 #include "duckdb/execution/aggregate_hashtable.hpp"
 
 #include "duckdb/common/exception.hpp"
+#include "duckdb/common/limits.hpp"
 #include "duckdb/common/types/null_value.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/planner/expression/bound_aggregate_expression.hpp"
 #include "duckdb/catalog/catalog_entry/aggregate_function_catalog_entry.hpp"
-#include "duckdb/common/vector_operations/unary_executor.hpp"
 #include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/algorithm.hpp"
+#include "duckdb/execution/buffered_chunk_collection.hpp"
 
 #include <cmath>
 #include <map>
@@ -36,10 +37,10 @@ SuperLargeHashTable::SuperLargeHashTable(idx_t initial_capacity, vector<LogicalT
                                          vector<LogicalType> payload_types, vector<AggregateObject> aggregate_objects,
                                          bool parallel)
     : aggregates(move(aggregate_objects)), group_types(group_types), payload_types(payload_types), group_width(0),
-      payload_width(0), capacity(0), entries(0), data(nullptr), parallel(parallel) {
+      payload_width(0), capacity(0), entries(0), first_block_capacity(0), parallel(parallel) {
 	// HT tuple layout is as follows:
-	// [FLAG][GROUPS][PAYLOAD]
-	// [FLAG] is the state of the tuple in memory
+	// [HASH][GROUPS][PAYLOAD]
+	// [HASH] is the hash of the groups, used to rebuild the pointer array when resizing
 	// [GROUPS] is the groups
 	// [PAYLOAD] is the payload (i.e. the aggregate states)
 	for (idx_t i = 0; i < group_types.size(); i++) {
@@ -81,7 +82,10 @@ SuperLargeHashTable::SuperLargeHashTable(idx_t initial_capacity, vector<LogicalT
 		}
 	}
 
-	tuple_size = FLAG_SIZE + (group_width + payload_width);
+	tuple_size = HASH_WIDTH + (group_width + payload_width);
+	// every row holds a hash, so the offset of a row within its block always fits in an entry of the pointer array
+	tuples_per_block = MaxValue<idx_t>(Storage::BLOCK_ALLOC_SIZE / tuple_size, 1);
+	assert(tuples_per_block <= NumericLimits<uint16_t>::Maximum());
 	Resize(initial_capacity);
 }
 
@@ -103,120 +107,343 @@ void SuperLargeHashTable::CallDestructors(Vector &state_vector, idx_t count) {
 	}
 }
 
-void SuperLargeHashTable::Destroy() {
-	if (!data) {
-		return;
-	}
-	// check if there is a destructor
-	bool has_destructor = false;
+bool SuperLargeHashTable::HasDestructors() {
 	for (idx_t i = 0; i < aggregates.size(); i++) {
 		if (aggregates[i].function.destructor) {
-			has_destructor = true;
+			return true;
 		}
 	}
-	if (!has_destructor) {
+	return false;
+}
+
+void SuperLargeHashTable::Destroy() {
+	// check if there is a destructor
+	if (entries == 0 || !HasDestructors()) {
 		return;
 	}
-	// there are aggregates with destructors: loop over the hash table
+	// there are aggregates with destructors: loop over the rows
 	// and call the destructor method for each of the aggregates
 	data_ptr_t data_pointers[STANDARD_VECTOR_SIZE];
 	Vector state_vector(LogicalType::POINTER, (data_ptr_t)data_pointers);
-	idx_t count = 0;
-	for (data_ptr_t ptr = data, end = data + capacity * tuple_size; ptr < end; ptr += tuple_size) {
-		if (*ptr == FULL_CELL) {
-			// found entry
-			data_pointers[count++] = ptr + FLAG_SIZE + group_width;
-			if (count == STANDARD_VECTOR_SIZE) {
-				// vector is full: call the destructors
-				CallDestructors(state_vector, count);
-				count = 0;
-			}
+	idx_t position = 0;
+	while (true) {
+		idx_t count = FetchRowPointers(position, data_pointers);
+		if (count == 0) {
+			break;
 		}
+		// move from the groups to the aggregate states
+		VectorOperations::AddInPlace(state_vector, group_width, count);
+		CallDestructors(state_vector, count);
 	}
-	CallDestructors(state_vector, count);
 }
 
-void SuperLargeHashTable::Resize(idx_t size) {
-	if (size <= capacity) {
-		throw Exception("Cannot downsize a hash table!");
+data_ptr_t SuperLargeHashTable::GetRow(aggr_ht_entry_t &entry) {
+	assert(entry.block_nr > 0 && entry.block_nr <= row_blocks.size());
+	return row_blocks[entry.block_nr - 1].get() + entry.block_offset * tuple_size;
+}
+
+void SuperLargeHashTable::ReserveRows(idx_t count) {
+	if (row_blocks.size() > 1 || first_block_capacity == tuples_per_block) {
+		return;
 	}
-	if (size < STANDARD_VECTOR_SIZE) {
-		size = STANDARD_VECTOR_SIZE;
+	auto required_capacity = MinValue<idx_t>(entries + count, tuples_per_block);
+	if (required_capacity <= first_block_capacity) {
+		return;
 	}
-	// size needs to be a power of 2
-	assert((size & (size - 1)) == 0);
-	bitmask = size - 1;
+	// grow the first row block geometrically, starting at a vector of rows
+	auto new_capacity = MaxValue<idx_t>(MaxValue<idx_t>(first_block_capacity * 2, STANDARD_VECTOR_SIZE),
+	                                    required_capacity);
+	new_capacity = MinValue<idx_t>(new_capacity, tuples_per_block);
+	auto new_block = unique_ptr<data_t[]>(new data_t[new_capacity * tuple_size]);
+	if (row_blocks.empty()) {
+		row_blocks.push_back(move(new_block));
+	} else {
+		// the entries of the pointer array refer to rows by block number and offset: they remain valid
+		memcpy(new_block.get(), row_blocks[0].get(), entries * tuple_size);
+		row_blocks[0] = move(new_block);
+	}
+	first_block_capacity = new_capacity;
+}
+
+data_ptr_t SuperLargeHashTable::CreateRow(aggr_ht_entry_t &entry, hash_t hash, uint16_t salt) {
+	auto block_offset = entries % tuples_per_block;
+	if (entries / tuples_per_block == row_blocks.size()) {
+		// the last row block is full: allocate a new one
+		assert(first_block_capacity == tuples_per_block);
+		row_blocks.push_back(unique_ptr<data_t[]>(new data_t[tuples_per_block * tuple_size]));
+	}
+	assert(row_blocks.size() > 1 || block_offset < first_block_capacity);
+	entry.salt = salt;
+	entry.block_offset = block_offset;
+	entry.block_nr = row_blocks.size();
+	entries++;
+
+	auto row = row_blocks.back().get() + block_offset * tuple_size;
+	memcpy(row, &hash, HASH_WIDTH);
+	// initialize the payload info for the row
+	memcpy(row + HASH_WIDTH + group_width, empty_payload_data.get(), payload_width);
+	return row;
+}
 
+idx_t SuperLargeHashTable::FetchRowPointers(idx_t &position, data_ptr_t pointers[]) {
+	idx_t count = 0;
+	while (position < entries && count < STANDARD_VECTOR_SIZE) {
+		auto block_offset = position % tuples_per_block;
+		auto row = row_blocks[position / tuples_per_block].get() + block_offset * tuple_size;
+		auto next = MinValue<idx_t>(tuples_per_block - block_offset,
+		                            MinValue<idx_t>(entries - position, STANDARD_VECTOR_SIZE - count));
+		for (idx_t i = 0; i < next; i++) {
+			pointers[count++] = row + HASH_WIDTH;
+			row += tuple_size;
+		}
+		position += next;
+	}
+	return count;
+}
+
+//! Returns the salt of a hash, which is compared before comparing the groups. The hash is scrambled first, so the
+//! salt depends on all bits of the hash and not only on the (possibly zero) upper ones.
+static inline uint16_t GetSalt(hash_t hash) {
+	return (hash * UINT64_C(0x9E3779B97F4A7C15)) >> 48;
+}
+
+idx_t SuperLargeHashTable::MemoryUsage() {
+	idx_t allocated_rows = row_blocks.empty() ? 0 : first_block_capacity + (row_blocks.size() - 1) * tuples_per_block;
+	idx_t memory_usage = capacity * sizeof(aggr_ht_entry_t) + allocated_rows * tuple_size + string_heap.AllocatedSize();
+	for (auto &distinct_ht : distinct_hashes) {
+		if (distinct_ht) {
+			memory_usage += distinct_ht->MemoryUsage();
+		}
+	}
+	return memory_usage;
+}
+
+idx_t SuperLargeHashTable::GrowthMemoryUsage() {
+	return MemoryUsage() + 2 * capacity * sizeof(aggr_ht_entry_t) + tuples_per_block * tuple_size;
+}
+
+void SuperLargeHashTable::Spill(vector<unique_ptr<BufferedChunkCollection>> &partitions, idx_t radix_bits) {
+	assert(partitions.size() == (idx_t(1) << radix_bits));
+	for (auto &distinct_ht : distinct_hashes) {
+		if (distinct_ht) {
+			throw InternalException("Cannot spill a hash table with DISTINCT aggregates");
+		}
+	}
 	if (entries > 0) {
-		auto new_table = make_unique<SuperLargeHashTable>(size, group_types, payload_types, aggregates, parallel);
+		vector<LogicalType> spill_types(group_types);
+		spill_types.push_back(LogicalType::BLOB);
 
-		DataChunk groups;
-		groups.Initialize(group_types);
+		DataChunk spill_chunk, partition_chunk;
+		spill_chunk.Initialize(spill_types);
+		partition_chunk.InitializeEmpty(spill_types);
+		auto &state_vector = spill_chunk.data[group_types.size()];
 
 		Vector addresses(LogicalType::POINTER);
 		auto data_pointers = FlatVector::GetData<data_ptr_t>(addresses);
+		vector<SelectionVector> partition_sel(partitions.size());
+		for (auto &sel : partition_sel) {
+			sel.Initialize(STANDARD_VECTOR_SIZE);
+		}
+		vector<idx_t> partition_count(partitions.size());
 
-		data_ptr_t ptr = data;
-		data_ptr_t end = data + capacity * tuple_size;
-
-		assert(new_table->tuple_size == this->tuple_size);
-
+		idx_t position = 0;
 		while (true) {
-			groups.Reset();
-
-			// scan the table for full cells starting from the scan position
-			idx_t found_entries = 0;
-			for (; ptr < end && found_entries < STANDARD_VECTOR_SIZE; ptr += tuple_size) {
-				if (*ptr == FULL_CELL) {
-					// found entry
-					data_pointers[found_entries++] = ptr + FLAG_SIZE;
-				}
-			}
+			spill_chunk.Reset();
+			idx_t found_entries = FetchRowPointers(position, data_pointers);
 			if (found_entries == 0) {
 				break;
 			}
-			// fetch the group columns
-			groups.SetCardinality(found_entries);
-			for (idx_t i = 0; i < groups.column_count(); i++) {
-				auto &column = groups.data[i];
-				VectorOperations::Gather::Set(addresses, column, found_entries);
+			// radix partition the rows on the upper bits of the (scrambled) stored hash of the groups
+			std::fill(partition_count.begin(), partition_count.end(), 0);
+			for (idx_t i = 0; i < found_entries; i++) {
+				hash_t hash;
+				memcpy(&hash, data_pointers[i] - HASH_WIDTH, HASH_WIDTH);
+				hash *= UINT64_C(0x9E3779B97F4A7C15);
+				auto partition_idx = radix_bits == 0 ? 0 : hash >> (64 - radix_bits);
+				partition_sel[partition_idx].set_index(partition_count[partition_idx]++, i);
+			}
+			// fetch the group columns, after which the addresses point to the aggregate states
+			spill_chunk.SetCardinality(found_entries);
+			for (idx_t i = 0; i < group_types.size(); i++) {
+				VectorOperations::Gather::Set(addresses, spill_chunk.data[i], found_entries);
+			}
+			// copy the raw aggregate states into the BLOB column: the states (and anything they own) are moved out
+			auto states = FlatVector::GetData<string_t>(state_vector);
+			for (idx_t i = 0; i < found_entries; i++) {
+				states[i] = StringVector::AddStringOrBlob(
+				    state_vector, string_t((const char *)data_pointers[i], (uint32_t)payload_width));
+			}
+			for (idx_t partition_idx = 0; partition_idx < partitions.size(); partition_idx++) {
+				if (partition_count[partition_idx] == 0) {
+					continue;
+				}
+				partition_chunk.Slice(spill_chunk, partition_sel[partition_idx], partition_count[partition_idx]);
+				partitions[partition_idx]->Append(partition_chunk);
 			}
+		}
+	}
+	// the partitions now own the aggregate states: release the table without calling their destructors
+	row_blocks.clear();
+	first_block_capacity = 0;
+	ht_entries.reset();
+	capacity = 0;
+	entries = 0;
+	string_heap.Destroy();
+	Resize(STANDARD_VECTOR_SIZE);
+}
 
-			groups.Verify();
-			assert(groups.size() == found_entries);
-			Vector new_addresses(LogicalType::POINTER);
-			new_table->FindOrCreateGroups(groups, new_addresses);
+idx_t SuperLargeHashTable::SpilledStateWidth() {
+	return (payload_width + 7) / 8 * 8;
+}
 
-			// NB: both address vectors already point to the payload start
-			assert(addresses.type == new_addresses.type && addresses.type == LogicalType::POINTER);
+void SuperLargeHashTable::GetSpilledStates(DataChunk &spilled, data_ptr_t state_buffer, Vector &state_vector) {
+	assert(spilled.column_count() == group_types.size() + 1);
+	VectorData sdata;
+	spilled.data[group_types.size()].Orrify(spilled.size(), sdata);
+	auto states = (string_t *)sdata.data;
+	auto state_pointers = FlatVector::GetData<data_ptr_t>(state_vector);
+	auto state_width = SpilledStateWidth();
+	for (idx_t i = 0; i < spilled.size(); i++) {
+		auto &state = states[sdata.sel->get_index(i)];
+		assert(state.GetSize() == payload_width);
+		// the string data of the BLOB column has no alignment guarantees: copy the state out before using it
+		state_pointers[i] = state_buffer + i * state_width;
+		memcpy(state_pointers[i], state.GetData(), payload_width);
+	}
+}
 
-			auto new_address_data = FlatVector::GetData<data_ptr_t>(new_addresses);
-			for (idx_t i = 0; i < found_entries; i++) {
-				memcpy(new_address_data[i], data_pointers[i], payload_width);
+void SuperLargeHashTable::CombinePartition(BufferedChunkCollection &partition) {
+	DataChunk spilled, groups;
+	spilled.Initialize(partition.Types());
+	groups.InitializeEmpty(group_types);
+	Vector addresses(LogicalType::POINTER);
+	Vector state_vector(LogicalType::POINTER);
+	auto state_buffer = unique_ptr<data_t[]>(new data_t[STANDARD_VECTOR_SIZE * SpilledStateWidth()]);
+	for (idx_t chunk_idx = 0; chunk_idx < partition.ChunkCount(); chunk_idx++) {
+		partition.FetchChunk(chunk_idx, spilled);
+		for (idx_t i = 0; i < group_types.size(); i++) {
+			groups.data[i].Reference(spilled.data[i]);
+		}
+		groups.SetCardinality(spilled);
+		FindOrCreateGroups(groups, addresses);
+		GetSpilledStates(spilled, state_buffer.get(), state_vector);
+		// combine the spilled states into the states of the HT, after which the spilled states are destroyed
+		for (idx_t aggr_idx = 0; aggr_idx < aggregates.size(); aggr_idx++) {
+			auto &aggr = aggregates[aggr_idx];
+			aggr.function.combine(state_vector, addresses, spilled.size());
+			if (aggr.function.destructor) {
+				aggr.function.destructor(state_vector, spilled.size());
 			}
+			VectorOperations::AddInPlace(state_vector, aggr.payload_size, spilled.size());
+			VectorOperations::AddInPlace(addresses, aggr.payload_size, spilled.size());
 		}
+	}
+}
 
-		assert(this->entries == new_table->entries);
+void SuperLargeHashTable::DestroyPartition(BufferedChunkCollection &partition) {
+	if (!HasDestructors()) {
+		return;
+	}
+	DataChunk spilled;
+	spilled.Initialize(partition.Types());
+	Vector state_vector(LogicalType::POINTER);
+	auto state_buffer = unique_ptr<data_t[]>(new data_t[STANDARD_VECTOR_SIZE * SpilledStateWidth()]);
+	for (idx_t chunk_idx = 0; chunk_idx < partition.ChunkCount(); chunk_idx++) {
+		partition.FetchChunk(chunk_idx, spilled);
+		GetSpilledStates(spilled, state_buffer.get(), state_vector);
+		CallDestructors(state_vector, spilled.size());
+	}
+}
 
-		this->data = move(new_table->data);
-		this->owned_data = move(new_table->owned_data);
-		this->capacity = new_table->capacity;
-		this->string_heap.MergeHeap(new_table->string_heap);
-		new_table->data = nullptr;
-	} else {
-		data = new data_t[size * tuple_size];
-		owned_data = unique_ptr<data_t[]>(data);
-		for (idx_t i = 0; i < size; i++) {
-			data[i * tuple_size] = EMPTY_CELL;
+void SuperLargeHashTable::Combine(SuperLargeHashTable &other) {
+	assert(other.group_types == group_types);
+	assert(other.payload_width == payload_width);
+	if (other.entries == 0) {
+		return;
+	}
+	DataChunk groups;
+	groups.Initialize(group_types);
+	Vector source_addresses(LogicalType::POINTER);
+	auto source_pointers = FlatVector::GetData<data_ptr_t>(source_addresses);
+	Vector addresses(LogicalType::POINTER);
+	idx_t position = 0;
+	while (true) {
+		groups.Reset();
+		idx_t count = other.FetchRowPointers(position, source_pointers);
+		if (count == 0) {
+			break;
+		}
+		// fetch the group columns, after which the source addresses point to the aggregate states
+		groups.SetCardinality(count);
+		for (idx_t i = 0; i < group_types.size(); i++) {
+			VectorOperations::Gather::Set(source_addresses, groups.data[i], count);
+		}
+		FindOrCreateGroups(groups, addresses);
+		for (idx_t aggr_idx = 0; aggr_idx < aggregates.size(); aggr_idx++) {
+			auto &aggr = aggregates[aggr_idx];
+			aggr.function.combine(source_addresses, addresses, count);
+			VectorOperations::AddInPlace(source_addresses, aggr.payload_size, count);
+			VectorOperations::AddInPlace(addresses, aggr.payload_size, count);
+		}
+	}
+}
+
+void SuperLargeHashTable::Clear() {
+	Destroy();
+	for (auto &distinct_ht : distinct_hashes) {
+		if (distinct_ht) {
+			distinct_ht->Clear();
 		}
+	}
+	if (row_blocks.size() > 1) {
+		// the first block is full-sized once there are more blocks: keep only that one
+		row_blocks.erase(row_blocks.begin() + 1, row_blocks.end());
+	}
+	memset(ht_entries.get(), 0, capacity * sizeof(aggr_ht_entry_t));
+	entries = 0;
+	string_heap.Destroy();
+}
 
-		capacity = size;
+void SuperLargeHashTable::Resize(idx_t size) {
+	if (size <= capacity) {
+		throw Exception("Cannot downsize a hash table!");
+	}
+	if (size < STANDARD_VECTOR_SIZE) {
+		size = STANDARD_VECTOR_SIZE;
 	}
+	// size needs to be a power of 2
+	assert((size & (size - 1)) == 0);
+	bitmask = size - 1;
 
-	endptr = data + tuple_size * capacity;
+	// the rows stay where they are: only the pointer array is rebuilt, using the stored hashes of the rows
+	ht_entries = unique_ptr<aggr_ht_entry_t[]>(new aggr_ht_entry_t[size]);
+	memset(ht_entries.get(), 0, size * sizeof(aggr_ht_entry_t));
+	capacity = size;
+	for (idx_t block_idx = 0; block_idx < row_blocks.size(); block_idx++) {
+		auto row = row_blocks[block_idx].get();
+		auto block_count = MinValue<idx_t>(tuples_per_block, entries - block_idx * tuples_per_block);
+		for (idx_t block_offset = 0; block_offset < block_count; block_offset++, row += tuple_size) {
+			hash_t hash;
+			memcpy(&hash, row, HASH_WIDTH);
+			// all rows hold distinct groups: insert the row in the first empty entry
+			auto ht_offset = hash & bitmask;
+			while (ht_entries[ht_offset].block_nr != 0) {
+				ht_offset = (ht_offset + 1) & bitmask;
+			}
+			auto &entry = ht_entries[ht_offset];
+			entry.salt = GetSalt(hash);
+			entry.block_offset = block_offset;
+			entry.block_nr = block_idx + 1;
+		}
+	}
 }
 
 void SuperLargeHashTable::AddChunk(DataChunk &groups, DataChunk &payload) {
+	AddChunk(groups, payload, vector<bool>());
+}
+
+void SuperLargeHashTable::AddChunk(DataChunk &groups, DataChunk &payload, const vector<bool> &aggregate_filter) {
+	assert(aggregate_filter.empty() || aggregate_filter.size() == aggregates.size());
 	if (groups.size() == 0) {
 		return;
 	}
@@ -234,6 +461,12 @@ void SuperLargeHashTable::AddChunk(DataChunk &groups, DataChunk &payload) {
 		// for any entries for which a group was found, update the aggregate
 		auto &aggr = aggregates[aggr_idx];
 		auto input_count = max((idx_t)1, (idx_t)aggr.child_count);
+		if (!aggregate_filter.empty() && !aggregate_filter[aggr_idx]) {
+			// the aggregate is filtered out: leave its state untouched
+			payload_idx += input_count;
+			VectorOperations::AddInPlace(addresses, aggr.payload_size, payload.size());
+			continue;
+		}
 		if (aggr.distinct) {
 			// construct chunk for secondary hash table probing
 			vector<LogicalType> probe_types(group_types);
@@ -282,6 +515,26 @@ void SuperLargeHashTable::AddChunk(DataChunk &groups, DataChunk &payload) {
 	}
 }
 
+void SuperLargeHashTable::UpdateAggregate(DataChunk &groups, idx_t aggr_idx, DataChunk &input) {
+	assert(aggr_idx < aggregates.size());
+	if (groups.size() == 0) {
+		return;
+	}
+	Vector addresses(LogicalType::POINTER);
+	FindOrCreateGroups(groups, addresses);
+
+	// move the addresses to the state of the aggregate
+	idx_t payload_offset = 0;
+	for (idx_t i = 0; i < aggr_idx; i++) {
+		payload_offset += aggregates[i].payload_size;
+	}
+	VectorOperations::AddInPlace(addresses, payload_offset, groups.size());
+
+	auto &aggr = aggregates[aggr_idx];
+	assert(input.column_count() == max((idx_t)1, (idx_t)aggr.child_count));
+	aggr.function.update(&input.data[0], input.column_count(), addresses, groups.size());
+}
+
 void SuperLargeHashTable::FetchAggregates(DataChunk &groups, DataChunk &result) {
 	groups.Verify();
 	assert(groups.column_count() == group_types.size());
@@ -304,19 +557,6 @@ void SuperLargeHashTable::FetchAggregates(DataChunk &groups, DataChunk &result)
 	}
 }
 
-void SuperLargeHashTable::HashGroups(DataChunk &groups, Vector &addresses) {
-	// create a set of hashes for the groups
-	Vector hashes(LogicalType::HASH);
-	groups.Hash(hashes);
-
-	// now compute the entry in the table based on the hash using a modulo
-	// multiply the position by the tuple size and add the base address
-	UnaryExecutor::Execute<hash_t, data_ptr_t>(hashes, addresses, groups.size(), [&](hash_t element) {
-		assert((element & bitmask) == (element % capacity));
-		return data + ((element & bitmask) * tuple_size);
-	});
-}
-
 template <class T>
 static void templated_scatter(VectorData &gdata, Vector &addresses, const SelectionVector &sel, idx_t count,
                               idx_t type_size) {
@@ -453,9 +693,10 @@ static void templated_compare_groups(VectorData &gdata, Vector &addresses, Selec
 	count = match_count;
 }
 
-static idx_t CompareGroups(DataChunk &groups, unique_ptr<VectorData[]> &group_data, Vector &addresses,
-                           SelectionVector &sel, idx_t count, SelectionVector &no_match) {
-	idx_t no_match_count = 0;
+//! Compares the groups with the groups the addresses point to, appending the non-matching entries to the no_match
+//! selection vector
+static void CompareGroups(DataChunk &groups, unique_ptr<VectorData[]> &group_data, Vector &addresses,
+                          SelectionVector &sel, idx_t count, SelectionVector &no_match, idx_t &no_match_count) {
 	for (idx_t group_idx = 0; group_idx < groups.column_count(); group_idx++) {
 		auto &data = groups.data[group_idx];
 		auto &gdata = group_data[group_idx];
@@ -493,7 +734,6 @@ static idx_t CompareGroups(DataChunk &groups, unique_ptr<VectorData[]> &group_da
 			throw Exception("Unsupported type for group vector");
 		}
 	}
-	return no_match_count;
 }
 
 // this is to support distinct aggregations where we need to record whether we
@@ -506,10 +746,23 @@ idx_t SuperLargeHashTable::FindOrCreateGroups(DataChunk &groups, Vector &address
 
 	// we need to be able to fit at least one vector of data
 	assert(capacity - entries > STANDARD_VECTOR_SIZE);
+	// the first row block can only be grown before any row pointers of this chunk are handed out
+	ReserveRows(groups.size());
 	assert(addresses.type == LogicalType::POINTER);
 
-	// hash the groups to get the addresses
-	HashGroups(groups, addresses);
+	// hash the groups
+	Vector hashes(LogicalType::HASH);
+	groups.Hash(hashes);
+	hashes.Normalify(groups.size());
+	auto hash_data = FlatVector::GetData<hash_t>(hashes);
+
+	// compute the starting position in the pointer array and the salt of every group
+	idx_t ht_offsets[STANDARD_VECTOR_SIZE];
+	uint16_t salts[STANDARD_VECTOR_SIZE];
+	for (idx_t i = 0; i < groups.size(); i++) {
+		ht_offsets[i] = hash_data[i] & bitmask;
+		salts[i] = GetSalt(hash_data[i]);
+	}
 
 	addresses.Normalify(groups.size());
 	auto data_pointers = FlatVector::GetData<data_ptr_t>(addresses);
@@ -538,43 +791,44 @@ idx_t SuperLargeHashTable::FindOrCreateGroups(DataChunk &groups, Vector &address
 	while (remaining_entries > 0) {
 		idx_t entry_count = 0;
 		idx_t empty_count = 0;
+		idx_t no_match_count = 0;
 
-		// first figure out for each remaining whether or not it belongs to a full or empty group
+		// first figure out for each remaining whether it belongs to an empty entry, an entry with the same salt or a
+		// different one
 		for (idx_t i = 0; i < remaining_entries; i++) {
 			idx_t index = sel_vector->get_index(i);
-			auto entry = data_pointers[index];
-			if (*entry == EMPTY_CELL) {
-				// cell is empty; mark the cell as filled
-				*entry = FULL_CELL;
+			auto &entry = ht_entries[ht_offsets[index]];
+			data_ptr_t row;
+			if (entry.block_nr == 0) {
+				// entry is empty: create a new row for the group
+				row = CreateRow(entry, hash_data[index], salts[index]);
 				empty_vector.set_index(empty_count++, index);
 				new_groups.set_index(new_group_count++, index);
-				// initialize the payload info for the column
-				memcpy(entry + FLAG_SIZE + group_width, empty_payload_data.get(), payload_width);
-			} else {
-				// cell is occupied: add to check list
+			} else if (entry.salt == salts[index]) {
+				// salt matches: add to check list
+				row = GetRow(entry);
 				next_vector->set_index(entry_count++, index);
+			} else {
+				// salt differs: the groups cannot match
+				no_match_vector->set_index(no_match_count++, index);
+				continue;
 			}
-			group_pointers[index] = entry + FLAG_SIZE;
-			data_pointers[index] = entry + FLAG_SIZE + group_width;
+			group_pointers[index] = row + HASH_WIDTH;
+			data_pointers[index] = row + HASH_WIDTH + group_width;
 		}
 
 		if (empty_count > 0) {
 			// for each of the locations that are empty, serialize the group columns to the locations
 			ScatterGroups(groups, group_data, pointers, empty_vector, empty_count);
-			entries += empty_count;
 		}
 		// now we have only the tuples remaining that might match to an existing group
 		// start performing comparisons with each of the groups
-		idx_t no_match_count = CompareGroups(groups, group_data, pointers, *next_vector, entry_count, *no_match_vector);
+		CompareGroups(groups, group_data, pointers, *next_vector, entry_count, *no_match_vector, no_match_count);
 
 		// each of the entries that do not match we move them to the next entry in the HT
 		for (idx_t i = 0; i < no_match_count; i++) {
 			idx_t index = no_match_vector->get_index(i);
-			data_pointers[index] += payload_width;
-			assert(((uint64_t)(data_pointers[index] - data)) % tuple_size == 0);
-			if (data_pointers[index] >= endptr) {
-				data_pointers[index] = data;
-			}
+			ht_offsets[index] = (ht_offsets[index] + 1) & bitmask;
 		}
 		sel_vector = no_match_vector;
 		std::swap(next_vector, no_match_vector);
@@ -590,24 +844,11 @@ void SuperLargeHashTable::FindOrCreateGroups(DataChunk &groups, Vector &addresse
 }
 
 idx_t SuperLargeHashTable::Scan(idx_t &scan_position, DataChunk &groups, DataChunk &result) {
-	data_ptr_t ptr;
-	data_ptr_t start = data + scan_position;
-	data_ptr_t end = data + capacity * tuple_size;
-	if (start >= end) {
-		return 0;
-	}
-
 	Vector addresses(LogicalType::POINTER);
 	auto data_pointers = FlatVector::GetData<data_ptr_t>(addresses);
 
-	// scan the table for full cells starting from the scan position
-	idx_t entry = 0;
-	for (ptr = start; ptr < end && entry < STANDARD_VECTOR_SIZE; ptr += tuple_size) {
-		if (*ptr == FULL_CELL) {
-			// found entry
-			data_pointers[entry++] = ptr + FLAG_SIZE;
-		}
-	}
+	// fetch the rows starting from the scan position
+	idx_t entry = FetchRowPointers(scan_position, data_pointers);
 	if (entry == 0) {
 		return 0;
 	}
@@ -626,7 +867,6 @@ idx_t SuperLargeHashTable::Scan(idx_t &scan_position, DataChunk &groups, DataChu
 
 		VectorOperations::AddInPlace(addresses, aggr.payload_size, groups.size());
 	}
-	scan_position = ptr - data;
 	return entry;
 }
 } // namespace duckdb
@@ -0,0 +1,368 @@
+#include "duckdb/execution/buffered_chunk_collection.hpp"
+
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+using namespace std;
+
+//! Every column of a serialized chunk starts at an 8-byte aligned offset
+static idx_t AlignChunkOffset(idx_t offset) {
+	return (offset + 7) & ~(idx_t)7;
+}
+
+BufferedChunkCollection::BufferedChunkCollection(BufferManager &buffer_manager, vector<LogicalType> types_)
+    : buffer_manager(buffer_manager), types(move(types_)), count(0), unused_bytes(0) {
+	if (!TypesAreSupported(types)) {
+		in_memory = make_unique<ChunkCollection>();
+	} else {
+		tail.Initialize(types);
+	}
+}
+
+BufferedChunkCollection::~BufferedChunkCollection() {
+	Reset();
+}
+
+void BufferedChunkCollection::Reset() {
+	append_handle.reset();
+	for (auto &block : blocks) {
+		buffer_manager.DestroyBuffer(block.block_id);
+	}
+	blocks.clear();
+	chunks.clear();
+	count = 0;
+	unused_bytes = 0;
+	if (in_memory) {
+		in_memory->Reset();
+	} else {
+		tail.Reset();
+	}
+}
+
+void BufferedChunkCollection::Swap(BufferedChunkCollection &other) {
+	assert(&buffer_manager == &other.buffer_manager);
+	assert(types == other.types);
+	std::swap(count, other.count);
+	std::swap(unused_bytes, other.unused_bytes);
+	chunks.swap(other.chunks);
+	blocks.swap(other.blocks);
+	std::swap(append_handle, other.append_handle);
+	std::swap(in_memory, other.in_memory);
+	// DataChunk cannot be moved: exchange the vectors and cardinalities of the tail chunks instead
+	tail.data.swap(other.tail.data);
+	auto tail_count = tail.size();
+	tail.SetCardinality(other.tail.size());
+	other.tail.SetCardinality(tail_count);
+}
+
+idx_t BufferedChunkCollection::MemoryUsage() {
+	if (in_memory) {
+		return in_memory->MemoryUsage();
+	}
+	idx_t memory_usage = 0;
+	for (idx_t col_idx = 0; col_idx < types.size(); col_idx++) {
+		memory_usage += STANDARD_VECTOR_SIZE * GetTypeIdSize(types[col_idx].InternalType());
+		if (types[col_idx].InternalType() == PhysicalType::VARCHAR) {
+			memory_usage += StringVector::HeapSize(tail.data[col_idx]);
+		}
+	}
+	return memory_usage;
+}
+
+bool BufferedChunkCollection::TypesAreSupported(const vector<LogicalType> &types) {
+	for (auto &type : types) {
+		switch (type.InternalType()) {
+		case PhysicalType::BOOL:
+		case PhysicalType::INT8:
+		case PhysicalType::INT16:
+		case PhysicalType::INT32:
+		case PhysicalType::INT64:
+		case PhysicalType::INT128:
+		case PhysicalType::FLOAT:
+		case PhysicalType::DOUBLE:
+		case PhysicalType::INTERVAL:
+		case PhysicalType::HASH:
+		case PhysicalType::POINTER:
+		case PhysicalType::VARCHAR:
+			break;
+		default:
+			return false;
+		}
+	}
+	return true;
+}
+
+idx_t BufferedChunkCollection::SerializedSize(DataChunk &chunk, VectorData data[]) {
+	idx_t size = 0;
+	for (idx_t col_idx = 0; col_idx < chunk.column_count(); col_idx++) {
+		auto type = types[col_idx].InternalType();
+		chunk.data[col_idx].Orrify(chunk.size(), data[col_idx]);
+		// every column starts with its nullmask
+		size = AlignChunkOffset(size) + sizeof(nullmask_t);
+		if (type == PhysicalType::VARCHAR) {
+			// strings are stored as an array of lengths followed by the string data
+			size += chunk.size() * sizeof(uint32_t);
+			auto strings = (string_t *)data[col_idx].data;
+			for (idx_t i = 0; i < chunk.size(); i++) {
+				auto idx = data[col_idx].sel->get_index(i);
+				if (!(*data[col_idx].nullmask)[idx]) {
+					size += strings[idx].GetSize();
+				}
+			}
+		} else {
+			size += chunk.size() * GetTypeIdSize(type);
+		}
+	}
+	return AlignChunkOffset(size);
+}
+
+data_ptr_t BufferedChunkCollection::AllocateSpace(idx_t size, ChunkEntry &entry) {
+	if (blocks.empty() || blocks.back().size + size > blocks.back().capacity) {
+		// the chunk does not fit in the current block: allocate a new block that can hold at least this chunk
+		idx_t alloc_size = MaxValue<idx_t>(Storage::BLOCK_ALLOC_SIZE, size + Storage::BLOCK_HEADER_SIZE);
+		append_handle.reset();
+		append_handle = buffer_manager.Allocate(alloc_size);
+
+		BlockEntry block;
+		block.block_id = append_handle->block_id;
+		block.capacity = alloc_size - Storage::BLOCK_HEADER_SIZE;
+		block.size = 0;
+		blocks.push_back(block);
+	} else if (!append_handle) {
+		append_handle = buffer_manager.Pin(blocks.back().block_id);
+	}
+	auto &block = blocks.back();
+	entry.block_index = blocks.size() - 1;
+	entry.offset = block.size;
+	entry.size = size;
+	block.size += size;
+	return append_handle->node->buffer + entry.offset;
+}
+
+void BufferedChunkCollection::WriteChunk(DataChunk &chunk, VectorData data[], data_ptr_t base_ptr) {
+	idx_t offset = 0;
+	for (idx_t col_idx = 0; col_idx < chunk.column_count(); col_idx++) {
+		auto type = types[col_idx].InternalType();
+		auto &vdata = data[col_idx];
+		offset = AlignChunkOffset(offset);
+		// write the nullmask in flat order
+		auto nullmask = (nullmask_t *)(base_ptr + offset);
+		new (nullmask) nullmask_t();
+		for (idx_t i = 0; i < chunk.size(); i++) {
+			(*nullmask)[i] = (*vdata.nullmask)[vdata.sel->get_index(i)];
+		}
+		offset += sizeof(nullmask_t);
+		if (type == PhysicalType::VARCHAR) {
+			auto strings = (string_t *)vdata.data;
+			auto lengths = (uint32_t *)(base_ptr + offset);
+			auto string_data = base_ptr + offset + chunk.size() * sizeof(uint32_t);
+			for (idx_t i = 0; i < chunk.size(); i++) {
+				auto idx = vdata.sel->get_index(i);
+				if ((*vdata.nullmask)[idx]) {
+					lengths[i] = 0;
+					continue;
+				}
+				auto length = strings[idx].GetSize();
+				lengths[i] = length;
+				memcpy(string_data, strings[idx].GetData(), length);
+				string_data += length;
+			}
+			offset = string_data - base_ptr;
+		} else {
+			auto type_size = GetTypeIdSize(type);
+			auto target = base_ptr + offset;
+			for (idx_t i = 0; i < chunk.size(); i++) {
+				auto idx = vdata.sel->get_index(i);
+				memcpy(target + i * type_size, vdata.data + idx * type_size, type_size);
+			}
+			offset += chunk.size() * type_size;
+		}
+	}
+}
+
+void BufferedChunkCollection::FlushTail() {
+	auto data = unique_ptr<VectorData[]>(new VectorData[types.size()]);
+	auto size = SerializedSize(tail, data.get());
+
+	ChunkEntry entry;
+	entry.count = tail.size();
+	auto base_ptr = AllocateSpace(size, entry);
+	WriteChunk(tail, data.get(), base_ptr);
+	chunks.push_back(entry);
+	// unpin the block until the next flush, so that many collections that are appended to in turn (e.g. radix
+	// partitions) do not each keep a block pinned
+	append_handle.reset();
+
+	tail.Reset();
+}
+
+void BufferedChunkCollection::Append(DataChunk &chunk) {
+	if (chunk.size() == 0) {
+		return;
+	}
+	assert(chunk.column_count() == types.size());
+	count += chunk.size();
+	if (in_memory) {
+		in_memory->Append(chunk);
+		return;
+	}
+	// the chunk can be copied into the tail in several parts: normalify all of its rows first, as copying a part of a
+	// (e.g. sequence) vector would otherwise only normalify the rows of that part. This modifies the caller's chunk.
+	chunk.Normalify();
+	// gather the rows in the tail chunk, serializing it every time it fills up
+	idx_t offset = 0;
+	while (offset < chunk.size()) {
+		idx_t append_count = MinValue<idx_t>(chunk.size() - offset, STANDARD_VECTOR_SIZE - tail.size());
+		for (idx_t col_idx = 0; col_idx < types.size(); col_idx++) {
+			VectorOperations::Copy(chunk.data[col_idx], tail.data[col_idx], offset + append_count, offset,
+			                       tail.size());
+		}
+		tail.SetCardinality(tail.size() + append_count);
+		offset += append_count;
+		if (tail.size() == STANDARD_VECTOR_SIZE) {
+			FlushTail();
+		}
+	}
+}
+
+void BufferedChunkCollection::ReplaceChunk(idx_t chunk_index, DataChunk &source) {
+	assert(source.column_count() == types.size());
+	if (in_memory || chunk_index == chunks.size()) {
+		// the chunk is kept in memory: copy the source into it
+		auto &target = in_memory ? *in_memory->chunks[chunk_index] : tail;
+		assert(target.size() == source.size());
+		target.Reset();
+		for (idx_t col_idx = 0; col_idx < types.size(); col_idx++) {
+			VectorOperations::Copy(source.data[col_idx], target.data[col_idx], source.size(), 0, 0);
+		}
+		target.SetCardinality(source.size());
+		return;
+	}
+	assert(chunk_index < chunks.size());
+	auto &entry = chunks[chunk_index];
+	assert(entry.count == source.size());
+	auto data = unique_ptr<VectorData[]>(new VectorData[types.size()]);
+	auto size = SerializedSize(source, data.get());
+	if (size > entry.size) {
+		// the chunk no longer fits in its original location: serialize it into fresh space
+		unused_bytes += entry.size;
+		auto base_ptr = AllocateSpace(size, entry);
+		WriteChunk(source, data.get(), base_ptr);
+		idx_t used_bytes = 0;
+		for (auto &block : blocks) {
+			used_bytes += block.size;
+		}
+		if (unused_bytes * 2 > used_bytes) {
+			// more than half of the space in the blocks is no longer used: move the chunks into new blocks
+			Compact();
+		}
+		return;
+	}
+	// overwrite the chunk in place
+	auto handle = buffer_manager.Pin(blocks[entry.block_index].block_id);
+	WriteChunk(source, data.get(), handle->node->buffer + entry.offset);
+}
+
+void BufferedChunkCollection::Compact() {
+	auto old_blocks = move(blocks);
+	blocks.clear();
+	append_handle.reset();
+	for (auto &entry : chunks) {
+		auto handle = buffer_manager.Pin(old_blocks[entry.block_index].block_id);
+		ChunkEntry new_entry;
+		new_entry.count = entry.count;
+		auto base_ptr = AllocateSpace(entry.size, new_entry);
+		memcpy(base_ptr, handle->node->buffer + entry.offset, entry.size);
+		entry = new_entry;
+	}
+	append_handle.reset();
+	for (auto &block : old_blocks) {
+		buffer_manager.DestroyBuffer(block.block_id);
+	}
+	unused_bytes = 0;
+}
+
+void BufferedChunkCollection::FetchChunk(idx_t chunk_index, DataChunk &target) {
+	ReadChunk(chunk_index, target, vector<bool>());
+}
+
+void BufferedChunkCollection::FetchChunk(idx_t chunk_index, DataChunk &target, const vector<column_t> &column_ids) {
+	vector<bool> projection(types.size(), false);
+	for (auto &column_id : column_ids) {
+		if (column_id < types.size()) {
+			projection[column_id] = true;
+		}
+	}
+	ReadChunk(chunk_index, target, projection);
+}
+
+void BufferedChunkCollection::ReadChunk(idx_t chunk_index, DataChunk &target, const vector<bool> &projection) {
+	assert(target.column_count() == types.size());
+	if (in_memory) {
+		target.Reference(*in_memory->chunks[chunk_index]);
+		return;
+	}
+	if (chunk_index == chunks.size()) {
+		target.Reference(tail);
+		return;
+	}
+	assert(chunk_index < chunks.size());
+	target.Reset();
+	auto &entry = chunks[chunk_index];
+	auto &block = blocks[entry.block_index];
+	unique_ptr<BufferHandle> handle;
+	data_ptr_t base_ptr;
+	if (append_handle && entry.block_index == blocks.size() - 1) {
+		// the chunk is in the block we are appending to, which is already pinned
+		base_ptr = append_handle->node->buffer + entry.offset;
+	} else {
+		handle = buffer_manager.Pin(block.block_id);
+		base_ptr = handle->node->buffer + entry.offset;
+	}
+
+	idx_t offset = 0;
+	for (idx_t col_idx = 0; col_idx < types.size(); col_idx++) {
+		auto type = types[col_idx].InternalType();
+		auto &vector = target.data[col_idx];
+		offset = AlignChunkOffset(offset);
+		if (!projection.empty() && !projection[col_idx]) {
+			// the column is not projected: skip over it
+			offset += sizeof(nullmask_t);
+			if (type == PhysicalType::VARCHAR) {
+				auto lengths = (uint32_t *)(base_ptr + offset);
+				offset += entry.count * sizeof(uint32_t);
+				for (idx_t i = 0; i < entry.count; i++) {
+					offset += lengths[i];
+				}
+			} else {
+				offset += entry.count * GetTypeIdSize(type);
+			}
+			continue;
+		}
+		FlatVector::Nullmask(vector) = *((nullmask_t *)(base_ptr + offset));
+		offset += sizeof(nullmask_t);
+		if (type == PhysicalType::VARCHAR) {
+			auto lengths = (uint32_t *)(base_ptr + offset);
+			auto string_data = (const char *)(base_ptr + offset + entry.count * sizeof(uint32_t));
+			auto strings = FlatVector::GetData<string_t>(vector);
+			for (idx_t i = 0; i < entry.count; i++) {
+				if (lengths[i] > 0) {
+					// copy the string into the heap of the vector, the block is unpinned after the fetch
+					strings[i] = StringVector::AddStringOrBlob(vector, string_t(string_data, lengths[i]));
+				} else {
+					strings[i] = string_t(string_data, 0);
+				}
+				string_data += lengths[i];
+			}
+			offset = (data_ptr_t)string_data - base_ptr;
+		} else {
+			auto type_size = GetTypeIdSize(type);
+			memcpy(FlatVector::GetData(vector), base_ptr + offset, entry.count * type_size);
+			offset += entry.count * type_size;
+		}
+	}
+	target.SetCardinality(entry.count);
+}
+
+} // namespace duckdb
@@ -385,6 +385,14 @@ void JoinHashTable::InsertHashes(Vector &hashes, idx_t count, data_ptr_t key_loc
 	}
 }
 
+idx_t JoinHashTable::MemoryUsage() {
+	idx_t memory_usage = blocks.size() * block_capacity * entry_size;
+	if (hash_map) {
+		memory_usage += (bitmask + 1) * sizeof(data_ptr_t);
+	}
+	return memory_usage;
+}
+
 void JoinHashTable::Finalize() {
 	// the build has finished, now iterate over all the nodes and construct the final hash table
 	// select a HT that has at least 50% empty space
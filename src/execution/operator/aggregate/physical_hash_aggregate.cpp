@@ -5,6 +5,10 @@
 #include "duckdb/planner/expression/bound_aggregate_expression.hpp"
 #include "duckdb/planner/expression/bound_constant_expression.hpp"
 #include "duckdb/catalog/catalog_entry/aggregate_function_catalog_entry.hpp"
+#include "duckdb/execution/buffered_chunk_collection.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/buffer/memory_reservation.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 namespace duckdb {
 using namespace std;
@@ -50,17 +54,97 @@ PhysicalHashAggregate::PhysicalHashAggregate(vector<LogicalType> types, vector<u
 		}
 		aggregates.push_back(move(expr));
 	}
+	can_spill = all_combinable;
+	bool has_distinct = false, all_distinct = true, distinct_with_input = true;
+	for (auto &aggr : bindings) {
+		if (aggr->distinct) {
+			has_distinct = true;
+			can_spill = false;
+			if (aggr->children.size() == 0) {
+				distinct_with_input = false;
+			}
+		} else {
+			all_distinct = false;
+		}
+	}
+	// the thread-local HTs of the aggregates that are not DISTINCT are combined into the global HT
+	partition_distinct = has_distinct && distinct_with_input && (all_distinct || all_combinable);
+}
+
+//! The amount of radix bits used to partition the distinct sets of DISTINCT aggregates
+static constexpr idx_t DISTINCT_RADIX_BITS = 4;
+static constexpr idx_t DISTINCT_PARTITIONS = idx_t(1) << DISTINCT_RADIX_BITS;
+//! The amount of entries a thread-local distinct partition or HT can hold before it is merged into the global state
+static constexpr idx_t LOCAL_FLUSH_COUNT = 64 * STANDARD_VECTOR_SIZE;
+
+//! The distinct set of a DISTINCT aggregate holds the groups together with the aggregate input
+static vector<LogicalType> GetDistinctTypes(vector<LogicalType> &group_types, BoundAggregateExpression &aggr) {
+	vector<LogicalType> distinct_types(group_types);
+	for (auto &child : aggr.children) {
+		distinct_types.push_back(child->return_type);
+	}
+	return distinct_types;
+}
+
+//! The amount of radix bits used to partition the aggregate HT when it is spilled to disk
+static constexpr idx_t SPILL_RADIX_BITS = 5;
+static constexpr idx_t SPILL_PARTITIONS = idx_t(1) << SPILL_RADIX_BITS;
+
+static unique_ptr<SuperLargeHashTable> CreateDistinctSet(vector<LogicalType> distinct_types) {
+	return make_unique<SuperLargeHashTable>(STANDARD_VECTOR_SIZE, move(distinct_types), vector<LogicalType>(),
+	                                        vector<AggregateObject>());
+}
+
+//! The input of the DISTINCT aggregates is deduplicated in the distinct partitions: the aggregate HTs of an aggregate
+//! with partitioned distinct sets aggregate all their input
+static vector<AggregateObject> GetPartitionedAggregateObjects(vector<BoundAggregateExpression *> &bindings) {
+	auto aggregate_objects = AggregateObject::CreateAggregateObjects(bindings);
+	for (auto &aggr : aggregate_objects) {
+		aggr.distinct = false;
+	}
+	return aggregate_objects;
 }
 
 //===--------------------------------------------------------------------===//
 // Sink
 //===--------------------------------------------------------------------===//
+//! A partition of the global distinct set of a DISTINCT aggregate
+class DistinctPartition {
+public:
+	DistinctPartition(ClientContext &context, vector<LogicalType> distinct_types) : reservation(context) {
+		ht = CreateDistinctSet(move(distinct_types));
+	}
+
+	//! The lock for merging thread-local partitions into this partition
+	std::mutex lock;
+	//! The deduplicated (groups, input) tuples of this partition
+	unique_ptr<SuperLargeHashTable> ht;
+	//! The memory reserved for the partition
+	MemoryReservation reservation;
+};
+
 class HashAggregateGlobalState : public GlobalOperatorState {
 public:
-	HashAggregateGlobalState(vector<LogicalType> &group_types, vector<LogicalType> &payload_types,
-	                         vector<BoundAggregateExpression *> &bindings)
-	    : is_empty(true) {
-		ht = make_unique<SuperLargeHashTable>(1024, group_types, payload_types, bindings);
+	HashAggregateGlobalState(ClientContext &context, PhysicalHashAggregate &op)
+	    : is_empty(true), reservation(context), next_partition(0) {
+		if (!op.partition_distinct) {
+			ht = make_unique<SuperLargeHashTable>(1024, op.group_types, op.payload_types, op.bindings);
+			return;
+		}
+		ht = make_unique<SuperLargeHashTable>(1024, op.group_types, op.payload_types,
+		                                      GetPartitionedAggregateObjects(op.bindings));
+		for (auto &aggr : op.bindings) {
+			vector<LogicalType> distinct_types;
+			vector<unique_ptr<DistinctPartition>> partitions;
+			if (aggr->distinct) {
+				distinct_types = GetDistinctTypes(op.group_types, *aggr);
+				for (idx_t i = 0; i < DISTINCT_PARTITIONS; i++) {
+					partitions.push_back(make_unique<DistinctPartition>(context, distinct_types));
+				}
+			}
+			distinct_partitions.push_back(move(partitions));
+			this->distinct_types.push_back(move(distinct_types));
+		}
 	}
 
 	//! The lock for updating the global aggregate state
@@ -69,13 +153,49 @@ public:
 	unique_ptr<SuperLargeHashTable> ht;
 	//! Whether or not any tuples were added to the HT
 	bool is_empty;
+	//! The memory reserved for the aggregate HT
+	MemoryReservation reservation;
+	//! The types of the distinct sets of each aggregate (only used if the distinct sets are partitioned, empty for
+	//! aggregates that are not DISTINCT)
+	vector<vector<LogicalType>> distinct_types;
+	//! The partitioned distinct sets of each aggregate (empty for aggregates that are not DISTINCT)
+	vector<vector<unique_ptr<DistinctPartition>>> distinct_partitions;
+	//! The radix partitions the aggregate HT was spilled into (empty if the HT fit in memory)
+	vector<unique_ptr<BufferedChunkCollection>> partitions;
+	//! The next spilled partition to aggregate when scanning the result
+	idx_t next_partition;
+
+	//! Returns the amount of memory held by the spilled partitions outside of their (evictable) blocks
+	idx_t PartitionMemoryUsage() {
+		idx_t memory_usage = 0;
+		for (auto &partition : partitions) {
+			if (partition) {
+				memory_usage += partition->MemoryUsage();
+			}
+		}
+		return memory_usage;
+	}
+	//! Returns the amount of memory that has to be reserved for the aggregate HT and the spilled partitions
+	idx_t MemoryUsage() {
+		return ht->MemoryUsage() + PartitionMemoryUsage();
+	}
+
+	~HashAggregateGlobalState() {
+		// the aggregate states of partitions that were never scanned still have to be destroyed
+		for (auto &partition : partitions) {
+			if (partition) {
+				ht->DestroyPartition(*partition);
+			}
+		}
+	}
 };
 
 class HashAggregateLocalState : public LocalSinkState {
 public:
-	HashAggregateLocalState(vector<unique_ptr<Expression>> &groups, vector<BoundAggregateExpression *> &aggregates,
-	                        vector<LogicalType> &group_types, vector<LogicalType> &payload_types)
-	    : group_executor(groups) {
+	HashAggregateLocalState(ClientContext &context, vector<unique_ptr<Expression>> &groups,
+	                        vector<BoundAggregateExpression *> &aggregates, vector<LogicalType> &group_types,
+	                        vector<LogicalType> &payload_types)
+	    : group_executor(groups), reservation(context) {
 		for (auto &aggr : aggregates) {
 			if (aggr->children.size()) {
 				for (idx_t i = 0; i < aggr->children.size(); ++i) {
@@ -89,6 +209,44 @@ public:
 		}
 	}
 
+	void InitializeDistinct(vector<LogicalType> &group_types, vector<LogicalType> &payload_types,
+	                        vector<BoundAggregateExpression *> &aggregates) {
+		is_empty = true;
+		bool has_regular_aggregates = false;
+		for (auto &aggr : aggregates) {
+			if (aggr->distinct) {
+				distinct_types.push_back(GetDistinctTypes(group_types, *aggr));
+				distinct_sets.push_back(vector<unique_ptr<SuperLargeHashTable>>(DISTINCT_PARTITIONS));
+			} else {
+				distinct_types.push_back(vector<LogicalType>());
+				distinct_sets.push_back(vector<unique_ptr<SuperLargeHashTable>>());
+				has_regular_aggregates = true;
+			}
+			aggregate_filter.push_back(!aggr->distinct);
+		}
+		if (has_regular_aggregates) {
+			ht = make_unique<SuperLargeHashTable>(1024, group_types, payload_types,
+			                                      GetPartitionedAggregateObjects(aggregates));
+		}
+		partition_sel.resize(DISTINCT_PARTITIONS);
+		for (auto &sel : partition_sel) {
+			sel.Initialize(STANDARD_VECTOR_SIZE);
+		}
+	}
+
+	//! Returns the amount of memory used by the thread-local HT and distinct sets
+	idx_t MemoryUsage() {
+		idx_t memory_usage = ht ? ht->MemoryUsage() : 0;
+		for (auto &partitions : distinct_sets) {
+			for (auto &local_set : partitions) {
+				if (local_set) {
+					memory_usage += local_set->MemoryUsage();
+				}
+			}
+		}
+		return memory_usage;
+	}
+
 	//! Expression executor for the GROUP BY chunk
 	ExpressionExecutor group_executor;
 	//! Expression state for the payload
@@ -97,14 +255,154 @@ public:
 	DataChunk group_chunk;
 	//! The payload chunk
 	DataChunk payload_chunk;
+
+	//! Whether or not this thread has seen any input (only used if the distinct sets are partitioned)
+	bool is_empty;
+	//! The types of the distinct sets of each aggregate
+	vector<vector<LogicalType>> distinct_types;
+	//! The thread-local partitions of the distinct sets of each aggregate, created lazily and reused after they have
+	//! been merged into the global partitions
+	vector<vector<unique_ptr<SuperLargeHashTable>>> distinct_sets;
+	//! The selection vectors used to split an input chunk into partitions
+	vector<SelectionVector> partition_sel;
+	//! The thread-local HT computing the aggregates that are not DISTINCT (if any)
+	unique_ptr<SuperLargeHashTable> ht;
+	//! Whether or not each aggregate is computed in the thread-local HT
+	vector<bool> aggregate_filter;
+	//! The memory reserved for the thread-local HT and distinct sets
+	MemoryReservation reservation;
 };
 
 unique_ptr<GlobalOperatorState> PhysicalHashAggregate::GetGlobalState(ClientContext &context) {
-	return make_unique<HashAggregateGlobalState>(group_types, payload_types, bindings);
+	return make_unique<HashAggregateGlobalState>(context, *this);
 }
 
 unique_ptr<LocalSinkState> PhysicalHashAggregate::GetLocalSinkState(ExecutionContext &context) {
-	return make_unique<HashAggregateLocalState>(groups, bindings, group_types, payload_types);
+	auto state = make_unique<HashAggregateLocalState>(context.client, groups, bindings, group_types, payload_types);
+	if (partition_distinct) {
+		state->InitializeDistinct(group_types, payload_types, bindings);
+	}
+	return move(state);
+}
+
+//! Merges a thread-local distinct partition into the corresponding global partition
+static void FlushDistinctPartition(HashAggregateGlobalState &gstate, HashAggregateLocalState &lstate, idx_t aggr_idx,
+                                   idx_t partition_idx) {
+	auto &local_set = lstate.distinct_sets[aggr_idx][partition_idx];
+	if (!local_set || local_set->Size() == 0) {
+		return;
+	}
+	auto &partition = *gstate.distinct_partitions[aggr_idx][partition_idx];
+
+	DataChunk distinct_chunk, empty_chunk;
+	distinct_chunk.Initialize(lstate.distinct_types[aggr_idx]);
+	Vector addresses(LogicalType::POINTER);
+
+	lock_guard<mutex> plock(partition.lock);
+	idx_t scan_position = 0;
+	while (true) {
+		distinct_chunk.Reset();
+		if (local_set->Scan(scan_position, distinct_chunk, empty_chunk) == 0) {
+			break;
+		}
+		partition.ht->FindOrCreateGroups(distinct_chunk, addresses);
+	}
+	partition.reservation.Resize(partition.ht->MemoryUsage());
+	// empty the thread-local partition, keeping its memory allocated for the next tuples
+	local_set->Clear();
+}
+
+//! Combines the thread-local HT into the global aggregate HT
+static void FlushLocalHashTable(HashAggregateGlobalState &gstate, HashAggregateLocalState &lstate) {
+	if (!lstate.ht || lstate.ht->Size() == 0) {
+		return;
+	}
+	lock_guard<mutex> glock(gstate.lock);
+	gstate.ht->Combine(*lstate.ht);
+	gstate.reservation.Resize(gstate.MemoryUsage());
+	// the combine copies anything the thread-local states own: they can be destroyed
+	lstate.ht->Clear();
+}
+
+//! Adds the input of every DISTINCT aggregate to the thread-local partitions of its distinct set
+static void SinkDistinct(HashAggregateGlobalState &gstate, HashAggregateLocalState &lstate,
+                         vector<BoundAggregateExpression *> &aggregates) {
+	auto &group_chunk = lstate.group_chunk;
+	auto &payload_chunk = lstate.payload_chunk;
+	lstate.is_empty = false;
+
+	idx_t payload_idx = 0;
+	for (idx_t aggr_idx = 0; aggr_idx < aggregates.size(); aggr_idx++) {
+		idx_t child_count = aggregates[aggr_idx]->children.size();
+		if (!aggregates[aggr_idx]->distinct) {
+			payload_idx += MaxValue<idx_t>(child_count, 1);
+			continue;
+		}
+		auto &distinct_types = lstate.distinct_types[aggr_idx];
+
+		// construct the (groups, input) chunk of the aggregate
+		DataChunk distinct_chunk;
+		distinct_chunk.InitializeEmpty(distinct_types);
+		for (idx_t i = 0; i < group_chunk.column_count(); i++) {
+			distinct_chunk.data[i].Reference(group_chunk.data[i]);
+		}
+		for (idx_t i = 0; i < child_count; i++) {
+			distinct_chunk.data[group_chunk.column_count() + i].Reference(payload_chunk.data[payload_idx + i]);
+		}
+		distinct_chunk.SetCardinality(group_chunk);
+		payload_idx += child_count;
+
+		// radix partition the chunk on the upper bits of its (scrambled) hash
+		Vector hashes(LogicalType::HASH);
+		distinct_chunk.Hash(hashes);
+		VectorData hdata;
+		hashes.Orrify(distinct_chunk.size(), hdata);
+		auto hash_data = (hash_t *)hdata.data;
+		idx_t partition_count[DISTINCT_PARTITIONS];
+		memset(partition_count, 0, sizeof(partition_count));
+		for (idx_t i = 0; i < distinct_chunk.size(); i++) {
+			auto hash = hash_data[hdata.sel->get_index(i)] * UINT64_C(0x9E3779B97F4A7C15);
+			auto partition_idx = hash >> (64 - DISTINCT_RADIX_BITS);
+			lstate.partition_sel[partition_idx].set_index(partition_count[partition_idx]++, i);
+		}
+
+		// add the tuples of each partition to the thread-local distinct set
+		Vector addresses(LogicalType::POINTER);
+		DataChunk partition_chunk;
+		partition_chunk.InitializeEmpty(distinct_types);
+		for (idx_t partition_idx = 0; partition_idx < DISTINCT_PARTITIONS; partition_idx++) {
+			if (partition_count[partition_idx] == 0) {
+				continue;
+			}
+			auto &local_set = lstate.distinct_sets[aggr_idx][partition_idx];
+			if (!local_set) {
+				local_set = CreateDistinctSet(distinct_types);
+			}
+			partition_chunk.Slice(distinct_chunk, lstate.partition_sel[partition_idx], partition_count[partition_idx]);
+			local_set->FindOrCreateGroups(partition_chunk, addresses);
+			if (local_set->Size() >= LOCAL_FLUSH_COUNT) {
+				FlushDistinctPartition(gstate, lstate, aggr_idx, partition_idx);
+			}
+		}
+	}
+}
+
+//! Moves the groups of the aggregate HT into the spilled radix partitions, which live in buffer-managed blocks that
+//! can be evicted to the temporary directory
+static void SpillHashTable(ClientContext &context, HashAggregateGlobalState &gstate, vector<LogicalType> &group_types) {
+	if (gstate.partitions.empty()) {
+		vector<LogicalType> spill_types(group_types);
+		spill_types.push_back(LogicalType::BLOB);
+		for (idx_t i = 0; i < SPILL_PARTITIONS; i++) {
+			gstate.partitions.push_back(
+			    make_unique<BufferedChunkCollection>(BufferManager::GetBufferManager(context), spill_types));
+		}
+	}
+	// the memory of the HT is released by the spill: free its reservation first, so that the blocks and tail chunks of
+	// the partitions can be allocated within the memory limit
+	gstate.reservation.Resize(0);
+	gstate.ht->Spill(gstate.partitions, SPILL_RADIX_BITS);
+	gstate.reservation.Resize(gstate.MemoryUsage());
 }
 
 void PhysicalHashAggregate::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate,
@@ -137,9 +435,110 @@ void PhysicalHashAggregate::Sink(ExecutionContext &context, GlobalOperatorState
 	payload_chunk.Verify();
 	assert(payload_chunk.column_count() == 0 || group_chunk.size() == payload_chunk.size());
 
+	if (partition_distinct) {
+		// deduplicate the input of the DISTINCT aggregates in parallel before aggregating it, and compute the other
+		// aggregates in the thread-local HT
+		if (sink.ht) {
+			sink.ht->AddChunk(group_chunk, payload_chunk, sink.aggregate_filter);
+			if (sink.ht->Size() >= LOCAL_FLUSH_COUNT) {
+				FlushLocalHashTable(gstate, sink);
+			}
+		}
+		SinkDistinct(gstate, sink, bindings);
+		sink.reservation.Resize(sink.MemoryUsage());
+		return;
+	}
+
 	lock_guard<mutex> glock(gstate.lock);
 	gstate.ht->AddChunk(group_chunk, payload_chunk);
 	gstate.is_empty = false;
+	// the HT allocates the memory for growing while adding the next chunk: make sure there is room for it
+	if (can_spill &&
+	    !gstate.reservation.TryResize(gstate.ht->GrowthMemoryUsage() + gstate.PartitionMemoryUsage())) {
+		// the HT can no longer grow in memory: spill its groups to disk and continue with an empty HT
+		SpillHashTable(context.client, gstate, group_types);
+	}
+	gstate.reservation.Resize(gstate.MemoryUsage());
+}
+
+void PhysicalHashAggregate::Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate) {
+	if (!partition_distinct) {
+		return;
+	}
+	auto &gstate = (HashAggregateGlobalState &)state;
+	auto &sink = (HashAggregateLocalState &)lstate;
+	// merge the thread-local distinct sets and HT into the global state, and release their memory
+	for (idx_t aggr_idx = 0; aggr_idx < sink.distinct_sets.size(); aggr_idx++) {
+		for (idx_t partition_idx = 0; partition_idx < sink.distinct_sets[aggr_idx].size(); partition_idx++) {
+			FlushDistinctPartition(gstate, sink, aggr_idx, partition_idx);
+		}
+	}
+	FlushLocalHashTable(gstate, sink);
+	sink.distinct_sets.clear();
+	sink.ht.reset();
+	sink.reservation.Resize(0);
+	if (!sink.is_empty) {
+		lock_guard<mutex> glock(gstate.lock);
+		gstate.is_empty = false;
+	}
+}
+
+//===--------------------------------------------------------------------===//
+// Finalize
+//===--------------------------------------------------------------------===//
+//! Aggregates the deduplicated tuples of the distinct partitions into the aggregate HT
+static void FinalizeDistinct(HashAggregateGlobalState &gstate, vector<LogicalType> &group_types) {
+	for (idx_t aggr_idx = 0; aggr_idx < gstate.distinct_partitions.size(); aggr_idx++) {
+		auto &partitions = gstate.distinct_partitions[aggr_idx];
+		if (partitions.empty()) {
+			// not a DISTINCT aggregate: it was computed in the thread-local HTs
+			continue;
+		}
+		auto &distinct_types = gstate.distinct_types[aggr_idx];
+		vector<LogicalType> input_types(distinct_types.begin() + group_types.size(), distinct_types.end());
+
+		DataChunk distinct_chunk, empty_chunk, group_chunk, input_chunk;
+		distinct_chunk.Initialize(distinct_types);
+		group_chunk.InitializeEmpty(group_types);
+		input_chunk.InitializeEmpty(input_types);
+		for (auto &partition : partitions) {
+			idx_t scan_position = 0;
+			while (true) {
+				distinct_chunk.Reset();
+				if (partition->ht->Scan(scan_position, distinct_chunk, empty_chunk) == 0) {
+					break;
+				}
+				for (idx_t i = 0; i < group_types.size(); i++) {
+					group_chunk.data[i].Reference(distinct_chunk.data[i]);
+				}
+				for (idx_t i = 0; i < input_types.size(); i++) {
+					input_chunk.data[i].Reference(distinct_chunk.data[group_types.size() + i]);
+				}
+				group_chunk.SetCardinality(distinct_chunk);
+				input_chunk.SetCardinality(distinct_chunk);
+				gstate.ht->UpdateAggregate(group_chunk, aggr_idx, input_chunk);
+			}
+			// the partition has been aggregated: release its memory
+			partition.reset();
+			gstate.reservation.Resize(gstate.MemoryUsage());
+		}
+	}
+	gstate.distinct_partitions.clear();
+}
+
+void PhysicalHashAggregate::Finalize(ClientContext &context, unique_ptr<GlobalOperatorState> state) {
+	auto &gstate = (HashAggregateGlobalState &)*state;
+	if (partition_distinct) {
+		FinalizeDistinct(gstate, group_types);
+	}
+	if (!gstate.partitions.empty()) {
+		// the HT was spilled: spill the remaining groups as well, the partitions are aggregated one at a time when
+		// the result is scanned
+		SpillHashTable(context, gstate, group_types);
+	}
+	context.profiler.SetHashTableSize(this, gstate.ht->Size(), gstate.ht->MemoryUsage());
+
+	PhysicalSink::Finalize(context, move(state));
 }
 
 //===--------------------------------------------------------------------===//
@@ -164,14 +563,33 @@ public:
 	idx_t ht_scan_position;
 };
 
+//! Aggregates the next spilled partition into a new aggregate HT, releasing the HT of the previous partition
+static void AggregateNextPartition(HashAggregateGlobalState &gstate, PhysicalHashAggregate &op) {
+	// take ownership of the partition: its spilled states are consumed by the combine
+	auto partition = move(gstate.partitions[gstate.next_partition++]);
+	gstate.ht.reset();
+	gstate.ht = make_unique<SuperLargeHashTable>(1024, op.group_types, op.payload_types, op.bindings);
+	gstate.ht->CombinePartition(*partition);
+	gstate.reservation.Resize(gstate.MemoryUsage());
+}
+
 void PhysicalHashAggregate::GetChunkInternal(ExecutionContext &context, DataChunk &chunk,
                                              PhysicalOperatorState *state_) {
 	auto &gstate = (HashAggregateGlobalState &)*sink_state;
 	auto &state = (PhysicalHashAggregateState &)*state_;
 
-	state.group_chunk.Reset();
-	state.aggregate_chunk.Reset();
-	idx_t elements_found = gstate.ht->Scan(state.ht_scan_position, state.group_chunk, state.aggregate_chunk);
+	idx_t elements_found;
+	while (true) {
+		state.group_chunk.Reset();
+		state.aggregate_chunk.Reset();
+		elements_found = gstate.ht->Scan(state.ht_scan_position, state.group_chunk, state.aggregate_chunk);
+		if (elements_found > 0 || gstate.next_partition >= gstate.partitions.size()) {
+			break;
+		}
+		// the current HT has been scanned: continue with the next spilled partition
+		AggregateNextPartition(gstate, *this);
+		state.ht_scan_position = 0;
+	}
 
 	// special case hack to sort out aggregating from empty intermediates
 	// for aggregations without groups
@@ -1,6 +1,8 @@
 #include "duckdb/execution/operator/join/physical_cross_product.hpp"
 
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/execution/buffered_chunk_collection.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 namespace duckdb {
 using namespace std;
@@ -14,7 +16,10 @@ public:
 
 	idx_t left_position;
 	idx_t right_position;
-	ChunkCollection right_data;
+	//! The materialized right side, stored in buffer-managed blocks so it can exceed the memory limit
+	unique_ptr<BufferedChunkCollection> right_data;
+	//! The chunk of the right side that is currently being matched
+	DataChunk right_chunk;
 };
 
 PhysicalCrossProduct::PhysicalCrossProduct(vector<LogicalType> types, unique_ptr<PhysicalOperator> left,
@@ -28,9 +33,12 @@ void PhysicalCrossProduct::GetChunkInternal(ExecutionContext &context, DataChunk
                                             PhysicalOperatorState *state_) {
 	auto state = reinterpret_cast<PhysicalCrossProductOperatorState *>(state_);
 	// first we fully materialize the right child, if we haven't done that yet
-	if (state->right_data.column_count() == 0) {
+	if (!state->right_data) {
 		auto right_state = children[1]->GetOperatorState();
 		auto types = children[1]->GetTypes();
+		state->right_data =
+		    make_unique<BufferedChunkCollection>(BufferManager::GetBufferManager(context.client), types);
+		state->right_chunk.Initialize(types);
 
 		DataChunk new_chunk;
 		new_chunk.Initialize(types);
@@ -39,14 +47,15 @@ void PhysicalCrossProduct::GetChunkInternal(ExecutionContext &context, DataChunk
 			if (new_chunk.size() == 0) {
 				break;
 			}
-			state->right_data.Append(new_chunk);
+			state->right_data->Append(new_chunk);
 		} while (new_chunk.size() > 0);
 
-		if (state->right_data.count == 0) {
+		if (state->right_data->Count() == 0) {
 			return;
 		}
 		state->left_position = 0;
 		state->right_position = 0;
+		state->right_data->FetchChunk(state->right_position, state->right_chunk);
 		children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
 		state->child_chunk.Normalify();
 	}
@@ -56,7 +65,7 @@ void PhysicalCrossProduct::GetChunkInternal(ExecutionContext &context, DataChunk
 	}
 
 	auto &left_chunk = state->child_chunk;
-	auto &right_chunk = *state->right_data.chunks[state->right_position];
+	auto &right_chunk = state->right_chunk;
 	// now match the current row of the left relation with the current chunk
 	// from the right relation
 	chunk.SetCardinality(right_chunk.size());
@@ -77,12 +86,13 @@ void PhysicalCrossProduct::GetChunkInternal(ExecutionContext &context, DataChunk
 		// move to the next chunk on the right side
 		state->left_position = 0;
 		state->right_position++;
-		if (state->right_position >= state->right_data.chunks.size()) {
+		if (state->right_position >= state->right_data->ChunkCount()) {
 			state->right_position = 0;
 			// move to the next chunk on the left side
 			children[0]->GetChunk(context, state->child_chunk, state->child_state.get());
 			state->child_chunk.Normalify();
 		}
+		state->right_data->FetchChunk(state->right_position, state->right_chunk);
 	}
 }
 
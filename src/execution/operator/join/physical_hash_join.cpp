@@ -5,6 +5,7 @@
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/storage/buffer_manager.hpp"
 #include "duckdb/function/aggregate/distributive_functions.hpp"
+#include "duckdb/main/client_context.hpp"
 
 using namespace std;
 
@@ -134,6 +135,7 @@ void PhysicalHashJoin::Sink(ExecutionContext &context, GlobalOperatorState &stat
 void PhysicalHashJoin::Finalize(ClientContext &context, unique_ptr<GlobalOperatorState> state) {
 	auto &sink = (HashJoinGlobalState &)*state;
 	sink.hash_table->Finalize();
+	context.profiler.SetHashTableSize(this, sink.hash_table->size(), sink.hash_table->MemoryUsage());
 
 	PhysicalSink::Finalize(context, move(state));
 }
@@ -4,6 +4,7 @@
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/execution/nested_loop_join.hpp"
+#include "duckdb/storage/buffer/memory_reservation.hpp"
 
 using namespace std;
 
@@ -128,7 +129,7 @@ public:
 
 class NestedLoopJoinGlobalState : public GlobalOperatorState {
 public:
-	NestedLoopJoinGlobalState() : has_null(false), right_outer_position(0) {
+	NestedLoopJoinGlobalState(ClientContext &context) : has_null(false), right_outer_position(0), reservation(context) {
 	}
 
 	//! Materialized data of the RHS
@@ -141,6 +142,8 @@ public:
 	unique_ptr<bool[]> right_found_match;
 	//! The position in the RHS in the final scan of the FULL OUTER JOIN
 	idx_t right_outer_position;
+	//! The memory reserved for the materialized RHS
+	MemoryReservation reservation;
 };
 
 void PhysicalNestedLoopJoin::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate,
@@ -162,6 +165,7 @@ void PhysicalNestedLoopJoin::Sink(ExecutionContext &context, GlobalOperatorState
 	// append the data and the
 	gstate.right_data.Append(input);
 	gstate.right_chunks.Append(nlj_state.right_condition);
+	gstate.reservation.Resize(gstate.right_data.MemoryUsage() + gstate.right_chunks.MemoryUsage());
 }
 
 void PhysicalNestedLoopJoin::Finalize(ClientContext &context, unique_ptr<GlobalOperatorState> state) {
@@ -175,7 +179,7 @@ void PhysicalNestedLoopJoin::Finalize(ClientContext &context, unique_ptr<GlobalO
 }
 
 unique_ptr<GlobalOperatorState> PhysicalNestedLoopJoin::GetGlobalState(ClientContext &context) {
-	return make_unique<NestedLoopJoinGlobalState>();
+	return make_unique<NestedLoopJoinGlobalState>(context);
 }
 
 unique_ptr<LocalSinkState> PhysicalNestedLoopJoin::GetLocalSinkState(ExecutionContext &context) {
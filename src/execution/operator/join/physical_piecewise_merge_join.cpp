@@ -4,6 +4,7 @@
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/execution/merge_join.hpp"
 #include "duckdb/common/operator/comparison_operators.hpp"
+#include "duckdb/storage/buffer/memory_reservation.hpp"
 
 using namespace std;
 
@@ -47,7 +48,7 @@ public:
 
 class MergeJoinGlobalState : public GlobalOperatorState {
 public:
-	MergeJoinGlobalState() : has_null(false), right_outer_position(0) {
+	MergeJoinGlobalState(ClientContext &context) : has_null(false), right_outer_position(0), reservation(context) {
 	}
 
 	//! The materialized data of the RHS
@@ -62,10 +63,12 @@ public:
 	unique_ptr<bool[]> right_found_match;
 	//! The position in the RHS in the final scan of the FULL OUTER JOIN
 	idx_t right_outer_position;
+	//! The memory reserved for the materialized RHS
+	MemoryReservation reservation;
 };
 
 unique_ptr<GlobalOperatorState> PhysicalPiecewiseMergeJoin::GetGlobalState(ClientContext &context) {
-	return make_unique<MergeJoinGlobalState>();
+	return make_unique<MergeJoinGlobalState>(context);
 }
 
 unique_ptr<LocalSinkState> PhysicalPiecewiseMergeJoin::GetLocalSinkState(ExecutionContext &context) {
@@ -89,6 +92,7 @@ void PhysicalPiecewiseMergeJoin::Sink(ExecutionContext &context, GlobalOperatorS
 	// append the join keys and the chunk to the chunk collection
 	gstate.right_chunks.Append(input);
 	gstate.right_conditions.Append(mj_state.join_keys);
+	gstate.reservation.Resize(gstate.right_chunks.MemoryUsage() + gstate.right_conditions.MemoryUsage());
 }
 
 //===--------------------------------------------------------------------===//
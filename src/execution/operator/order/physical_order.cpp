@@ -4,6 +4,7 @@
 #include "duckdb/common/value_operations/value_operations.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
+#include "duckdb/storage/buffer/memory_reservation.hpp"
 #include "duckdb/storage/data_table.hpp"
 
 using namespace std;
@@ -23,16 +24,21 @@ public:
 //===--------------------------------------------------------------------===//
 class OrderByGlobalOperatorState : public GlobalOperatorState {
 public:
+	OrderByGlobalOperatorState(ClientContext &context) : reservation(context) {
+	}
+
 	//! The lock for updating the global aggregate state
 	mutex lock;
 	//! The sorted data
 	ChunkCollection sorted_data;
 	//! The sorted vector
 	unique_ptr<idx_t[]> sorted_vector;
+	//! The memory reserved for the materialized data
+	MemoryReservation reservation;
 };
 
 unique_ptr<GlobalOperatorState> PhysicalOrder::GetGlobalState(ClientContext &context) {
-	return make_unique<OrderByGlobalOperatorState>();
+	return make_unique<OrderByGlobalOperatorState>(context);
 }
 
 void PhysicalOrder::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate,
@@ -41,6 +47,7 @@ void PhysicalOrder::Sink(ExecutionContext &context, GlobalOperatorState &state,
 	auto &gstate = (OrderByGlobalOperatorState &)state;
 	lock_guard<mutex> glock(gstate.lock);
 	gstate.sorted_data.Append(input);
+	gstate.reservation.Resize(gstate.sorted_data.MemoryUsage());
 }
 
 //===--------------------------------------------------------------------===//
@@ -3,6 +3,7 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/gzip_stream.hpp"
+#include "duckdb/common/mapped_file_stream.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/vector_operations/unary_executor.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
@@ -122,12 +123,20 @@ unique_ptr<istream> BufferedCSVReader::OpenCSV(ClientContext &context, BufferedC
 		result = make_unique<GzipStream>(options.file_path);
 		plain_file_source = false;
 	} else {
+		plain_file_source = true;
+		// parse the file straight from the page cache if it can be memory mapped
+		auto &fs = FileSystem::GetFileSystem(context);
+		auto handle = fs.OpenFile(options.file_path, FileFlags::FILE_FLAGS_READ);
+		auto mapping = fs.MapFile(*handle);
+		if (mapping) {
+			file_size = mapping->size;
+			return make_unique<MappedFileStream>(move(mapping));
+		}
 		auto csv_local = make_unique<ifstream>();
 		csv_local->open(options.file_path);
 		result = move(csv_local);
 
 		// determine filesize
-		plain_file_source = true;
 		result->seekg(0, result->end);
 		file_size = (idx_t)result->tellg();
 		result->clear();
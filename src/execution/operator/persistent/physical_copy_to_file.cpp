@@ -1,7 +1,9 @@
 #include "duckdb/execution/operator/persistent/physical_copy_to_file.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/parallel/task_context.hpp"
 
 #include <algorithm>
+#include <atomic>
 
 using namespace std;
 
@@ -13,7 +15,7 @@ public:
 	    : rows_copied(0), global_state(move(global_state)) {
 	}
 
-	idx_t rows_copied;
+	std::atomic<idx_t> rows_copied;
 	unique_ptr<GlobalFunctionData> global_state;
 };
 
@@ -28,7 +30,7 @@ void PhysicalCopyToFile::GetChunkInternal(ExecutionContext &context, DataChunk &
 	auto &g = (CopyToFunctionGlobalState &)*sink_state;
 
 	chunk.SetCardinality(1);
-	chunk.SetValue(0, 0, Value::BIGINT(g.rows_copied));
+	chunk.SetValue(0, 0, Value::BIGINT(g.rows_copied.load()));
 
 	state->finished = true;
 }
@@ -59,7 +61,9 @@ void PhysicalCopyToFile::Finalize(ClientContext &context, unique_ptr<GlobalOpera
 }
 
 unique_ptr<LocalSinkState> PhysicalCopyToFile::GetLocalSinkState(ExecutionContext &context) {
-	return make_unique<CopyToFunctionLocalState>(function.copy_to_initialize_local(context.client, *bind_data));
+	auto local_state = function.copy_to_initialize_local(context.client, *bind_data);
+	local_state->batch_index = context.task.batch_index;
+	return make_unique<CopyToFunctionLocalState>(move(local_state));
 }
 unique_ptr<GlobalOperatorState> PhysicalCopyToFile::GetGlobalState(ClientContext &context) {
 	return make_unique<CopyToFunctionGlobalState>(function.copy_to_initialize_global(context, *bind_data));
@@ -2,6 +2,7 @@
 
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/storage/data_table.hpp"
@@ -15,24 +16,76 @@ namespace duckdb {
 //===--------------------------------------------------------------------===//
 class InsertGlobalState : public GlobalOperatorState {
 public:
-	InsertGlobalState() : insert_count(0) {
+	InsertGlobalState() : insert_count(0), next_batch(0) {
 	}
 
 	std::mutex lock;
 	idx_t insert_count;
+	//! The index of the next batch that is appended to the local storage
+	idx_t next_batch;
+	//! The rows of finished batches that cannot be appended yet because a preceding batch is still running
+	unordered_map<idx_t, unique_ptr<ChunkCollection>> pending_batches;
 };
 
+//! The amount of verified rows a thread buffers before appending them to the transaction local storage
+static constexpr idx_t INSERT_LOCAL_FLUSH_COUNT = 100 * STANDARD_VECTOR_SIZE;
+
 class InsertLocalState : public LocalSinkState {
 public:
-	InsertLocalState(vector<LogicalType> types, vector<unique_ptr<Expression>> &bound_defaults)
-	    : default_executor(bound_defaults) {
+	InsertLocalState(vector<LogicalType> types, vector<unique_ptr<Expression>> &bound_defaults, idx_t batch_index)
+	    : default_executor(bound_defaults), batch_index(batch_index), local_collection(make_unique<ChunkCollection>()) {
 		insert_chunk.Initialize(types);
 	}
 
 	DataChunk insert_chunk;
 	ExpressionExecutor default_executor;
+	//! The index of the batch (i.e. the task of the pipeline) this thread inserts
+	idx_t batch_index;
+	//! The rows that have been verified by this thread, but not yet appended to the local storage
+	unique_ptr<ChunkCollection> local_collection;
 };
 
+static void AppendBatch(ClientContext &context, TableCatalogEntry &table, InsertGlobalState &gstate,
+                        ChunkCollection &collection) {
+	table.storage->LocalAppend(context, collection);
+	gstate.insert_count += collection.count;
+}
+
+//! Appends the rows buffered so far to the local storage if all preceding batches have been appended, so that the
+//! rows are inserted in the order of the input
+static void FlushLocalCollection(ClientContext &context, TableCatalogEntry &table, InsertGlobalState &gstate,
+                                 InsertLocalState &istate) {
+	// the constraints have already been verified: only the append to the local storage happens under the lock
+	lock_guard<mutex> glock(gstate.lock);
+	if (istate.batch_index != gstate.next_batch) {
+		return;
+	}
+	AppendBatch(context, table, gstate, *istate.local_collection);
+	istate.local_collection->Reset();
+}
+
+//! Finishes a batch: its rows are appended once all preceding batches have been, followed by the finished batches that
+//! directly follow it
+static void FinishBatch(ClientContext &context, TableCatalogEntry &table, InsertGlobalState &gstate,
+                        InsertLocalState &istate) {
+	lock_guard<mutex> glock(gstate.lock);
+	if (istate.batch_index != gstate.next_batch) {
+		gstate.pending_batches[istate.batch_index] = move(istate.local_collection);
+		return;
+	}
+	AppendBatch(context, table, gstate, *istate.local_collection);
+	gstate.next_batch++;
+	while (true) {
+		auto entry = gstate.pending_batches.find(gstate.next_batch);
+		if (entry == gstate.pending_batches.end()) {
+			break;
+		}
+		AppendBatch(context, table, gstate, *entry->second);
+		gstate.pending_batches.erase(entry);
+		gstate.next_batch++;
+	}
+}
+
 void PhysicalInsert::Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate,
                           DataChunk &chunk) {
 	auto &gstate = (InsertGlobalState &)state;
@@ -64,9 +117,18 @@ void PhysicalInsert::Sink(ExecutionContext &context, GlobalOperatorState &state,
 		}
 	}
 
-	lock_guard<mutex> glock(gstate.lock);
-	table->storage->Append(*table, context.client, istate.insert_chunk);
-	gstate.insert_count += chunk.size();
+	// verify the constraints in parallel, and buffer the chunk in the thread-local collection
+	table->storage->VerifyAppend(*table, istate.insert_chunk);
+	istate.local_collection->Append(istate.insert_chunk);
+	if (istate.local_collection->count >= INSERT_LOCAL_FLUSH_COUNT) {
+		FlushLocalCollection(context.client, *table, gstate, istate);
+	}
+}
+
+void PhysicalInsert::Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate) {
+	auto &gstate = (InsertGlobalState &)state;
+	auto &istate = (InsertLocalState &)lstate;
+	FinishBatch(context.client, *table, gstate, istate);
 }
 
 unique_ptr<GlobalOperatorState> PhysicalInsert::GetGlobalState(ClientContext &context) {
@@ -74,7 +136,7 @@ unique_ptr<GlobalOperatorState> PhysicalInsert::GetGlobalState(ClientContext &co
 }
 
 unique_ptr<LocalSinkState> PhysicalInsert::GetLocalSinkState(ExecutionContext &context) {
-	return make_unique<InsertLocalState>(table->GetTypes(), bound_defaults);
+	return make_unique<InsertLocalState>(table->GetTypes(), bound_defaults, context.task.batch_index);
 }
 
 //===--------------------------------------------------------------------===//
@@ -69,9 +69,9 @@ void PhysicalUpdate::Sink(ExecutionContext &context, GlobalOperatorState &state,
 		}
 	}
 
-	lock_guard<mutex> glock(gstate.lock);
 	if (is_index_update) {
 		// index update, perform a delete and an append instead
+		lock_guard<mutex> glock(gstate.lock);
 		table.Delete(tableref, context.client, row_ids, update_chunk.size());
 		mock_chunk.SetCardinality(update_chunk);
 		for (idx_t i = 0; i < columns.size(); i++) {
@@ -79,8 +79,11 @@ void PhysicalUpdate::Sink(ExecutionContext &context, GlobalOperatorState &state,
 		}
 		table.Append(tableref, context.client, mock_chunk);
 	} else {
+		// the threads of a parallel update update disjoint rows: segments and the undo buffer of the transaction are
+		// locked while they are modified, so no global lock is needed
 		table.Update(tableref, context.client, row_ids, columns, update_chunk);
 	}
+	lock_guard<mutex> glock(gstate.lock);
 	gstate.updated_count += chunk.size();
 }
 
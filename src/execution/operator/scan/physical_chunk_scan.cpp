@@ -1,5 +1,7 @@
 #include "duckdb/execution/operator/scan/physical_chunk_scan.hpp"
 
+#include "duckdb/execution/buffered_chunk_collection.hpp"
+
 using namespace std;
 
 namespace duckdb {
@@ -15,6 +17,15 @@ public:
 
 void PhysicalChunkScan::GetChunkInternal(ExecutionContext &context, DataChunk &chunk, PhysicalOperatorState *state_) {
 	auto state = (PhysicalChunkScanState *)state_;
+	if (buffered_collection) {
+		assert(chunk.GetTypes() == buffered_collection->Types());
+		if (state->chunk_index >= buffered_collection->ChunkCount()) {
+			return;
+		}
+		buffered_collection->FetchChunk(state->chunk_index, chunk);
+		state->chunk_index++;
+		return;
+	}
 	assert(collection);
 	if (collection->count == 0) {
 		return;
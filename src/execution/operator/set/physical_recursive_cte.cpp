@@ -2,9 +2,9 @@
 
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 
-#include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/execution/aggregate_hashtable.hpp"
 #include "duckdb/parallel/pipeline.hpp"
+#include "duckdb/parallel/task_context.hpp"
 
 using namespace std;
 
@@ -68,14 +68,9 @@ void PhysicalRecursiveCTE::GetChunkInternal(ExecutionContext &context, DataChunk
 				break;
 			}
 
-			working_table->count = 0;
-			working_table->chunks.clear();
-
-			working_table->count = intermediate_table.count;
-			working_table->chunks = move(intermediate_table.chunks);
-
-			intermediate_table.count = 0;
-			intermediate_table.chunks.clear();
+			// the rows of this iteration become the working table of the next one
+			working_table->Swap(*intermediate_table);
+			intermediate_table->Reset();
 
 			ExecuteRecursivePipelines(context);
 			state->bottom_state = children[1]->GetOperatorState();
@@ -89,11 +84,11 @@ void PhysicalRecursiveCTE::GetChunkInternal(ExecutionContext &context, DataChunk
 			// intermediate tables.
 			idx_t match_count = ProbeHT(chunk, state);
 			if (match_count > 0) {
-				intermediate_table.Append(chunk);
+				intermediate_table->Append(chunk);
 				state->intermediate_empty = false;
 			}
 		} else {
-			intermediate_table.Append(chunk);
+			intermediate_table->Append(chunk);
 			state->intermediate_empty = false;
 		}
 
@@ -104,7 +99,9 @@ void PhysicalRecursiveCTE::GetChunkInternal(ExecutionContext &context, DataChunk
 void PhysicalRecursiveCTE::ExecuteRecursivePipelines(ExecutionContext &context) {
 	for(auto &pipeline : pipelines) {
 		pipeline->Reset(context.client);
-		pipeline->Execute(context.task);
+		// the pipelines are executed directly instead of being scheduled, so they get a task context of their own
+		TaskContext task;
+		pipeline->Execute(task);
 		pipeline->FinishTask();
 	}
 }
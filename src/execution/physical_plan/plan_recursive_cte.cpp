@@ -4,6 +4,7 @@
 #include "duckdb/planner/expression/bound_reference_expression.hpp"
 #include "duckdb/planner/operator/logical_recursive_cte.hpp"
 #include "duckdb/planner/operator/logical_cteref.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 namespace duckdb {
 using namespace std;
@@ -11,10 +12,12 @@ using namespace std;
 unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalRecursiveCTE &op) {
 	assert(op.children.size() == 2);
 
-	// Create the working_table that the PhysicalRecursiveCTE will use for evaluation.
-	auto working_table = std::make_shared<ChunkCollection>();
+	// Create the working_table that the PhysicalRecursiveCTE will use for evaluation. The working and intermediate
+	// tables are buffer-managed, so that the iterations of a recursive CTE can exceed the memory limit.
+	auto &buffer_manager = BufferManager::GetBufferManager(context);
+	auto working_table = std::make_shared<BufferedChunkCollection>(buffer_manager, op.types);
 
-	// Add the ChunkCollection to the context of this PhysicalPlanGenerator
+	// Add the working table to the context of this PhysicalPlanGenerator
 	rec_ctes[op.table_index] = working_table;
 
 	auto left = CreatePlan(*op.children[0]);
@@ -22,6 +25,7 @@ unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalRecursiveC
 
 	auto cte = make_unique<PhysicalRecursiveCTE>(op.types, op.union_all, move(left), move(right));
 	cte->working_table = working_table;
+	cte->intermediate_table = make_unique<BufferedChunkCollection>(buffer_manager, op.types);
 
 	return move(cte);
 }
@@ -36,7 +40,7 @@ unique_ptr<PhysicalOperator> PhysicalPlanGenerator::CreatePlan(LogicalCTERef &op
 	if (cte == rec_ctes.end()) {
 		throw Exception("Referenced recursive CTE does not exist.");
 	}
-	chunk_scan->collection = cte->second.get();
+	chunk_scan->buffered_collection = cte->second.get();
 	return move(chunk_scan);
 }
 
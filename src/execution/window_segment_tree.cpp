@@ -27,6 +27,26 @@ WindowSegmentTree::WindowSegmentTree(AggregateFunction &aggregate, LogicalType r
 	}
 }
 
+WindowSegmentTree::~WindowSegmentTree() {
+	if (!aggregate.destructor || !levels_flat_native) {
+		return;
+	}
+	// call the destructors of the states of the internal nodes of the tree
+	data_ptr_t address_data[STANDARD_VECTOR_SIZE];
+	Vector addresses(LogicalType::POINTER, (data_ptr_t)address_data);
+	idx_t count = 0;
+	for (idx_t i = 0; i < levels_flat_start.back(); i++) {
+		address_data[count++] = levels_flat_native.get() + i * state.size();
+		if (count == STANDARD_VECTOR_SIZE) {
+			aggregate.destructor(addresses, count);
+			count = 0;
+		}
+	}
+	if (count > 0) {
+		aggregate.destructor(addresses, count);
+	}
+}
+
 void WindowSegmentTree::AggregateInit() {
 	aggregate.initialize(state.data());
 }
@@ -38,7 +58,11 @@ Value WindowSegmentTree::AggegateFinal() {
 	ConstantVector::SetNull(result, false);
 	aggregate.finalize(statev, result, 1);
 
-	return result.GetValue(0);
+	auto value = result.GetValue(0);
+	if (aggregate.destructor) {
+		aggregate.destructor(statev, 1);
+	}
+	return value;
 }
 
 void WindowSegmentTree::WindowSegmentValue(idx_t l_idx, idx_t begin, idx_t end) {
@@ -64,13 +88,18 @@ void WindowSegmentTree::WindowSegmentValue(idx_t l_idx, idx_t begin, idx_t end)
 		} else {
 			// we cannot just slice the individual vector!
 			auto &chunk_a = input_ref->GetChunk(begin);
-			auto &chunk_b = input_ref->GetChunk(end);
 			idx_t chunk_a_count = chunk_a.size() - start_in_vector;
 			idx_t chunk_b_count = inputs.size() - chunk_a_count;
 			for (idx_t i = 0; i < input_count; ++i) {
 				auto &v = inputs.data[i];
+				// the vector might still reference an input chunk from a previous slice: give it its own buffer
+				// before copying into it, otherwise the input is overwritten
+				v.Initialize();
 				VectorOperations::Copy(chunk_a.data[i], v, chunk_a.size(), start_in_vector, 0);
-				VectorOperations::Copy(chunk_b.data[i], v, chunk_b_count, 0, chunk_a_count);
+				if (chunk_b_count > 0) {
+					auto &chunk_b = input_ref->GetChunk(end);
+					VectorOperations::Copy(chunk_b.data[i], v, chunk_b_count, 0, chunk_a_count);
+				}
 			}
 		}
 		aggregate.update(&inputs.data[0], input_count, s, inputs.size());
@@ -0,0 +1,112 @@
+#include "duckdb/function/aggregate/distributive_functions.hpp"
+#include "duckdb/common/types/hyperloglog.hpp"
+#include "duckdb/common/vector_operations/vector_operations.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+struct approx_distinct_count_state_t {
+	HyperLogLog *log;
+};
+
+struct ApproxCountDistinctFunction {
+	template <class STATE> static void Initialize(STATE *state) {
+		state->log = nullptr;
+	}
+
+	template <class STATE, class OP> static void Combine(STATE source, STATE *target) {
+		if (!source.log) {
+			return;
+		}
+		if (!target->log) {
+			// the source state is destroyed after the combine: copy the sketch
+			target->log = new HyperLogLog(*source.log);
+		} else {
+			target->log->Merge(*source.log);
+		}
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, STATE *state, T *target, nullmask_t &nullmask, idx_t idx) {
+		target[idx] = state->log ? state->log->Count() : 0;
+	}
+
+	template <class STATE> static void Destroy(STATE *state) {
+		if (state->log) {
+			delete state->log;
+		}
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+};
+
+static void approx_count_distinct_update(Vector inputs[], idx_t input_count, Vector &state_vector, idx_t count) {
+	assert(input_count == 1);
+	auto &input = inputs[0];
+
+	// hash the input values
+	Vector hash_vector(LogicalType::HASH);
+	VectorOperations::Hash(input, hash_vector, count);
+
+	VectorData idata, hdata, sdata;
+	input.Orrify(count, idata);
+	hash_vector.Orrify(count, hdata);
+	state_vector.Orrify(count, sdata);
+
+	auto hashes = (hash_t *)hdata.data;
+	auto states = (approx_distinct_count_state_t **)sdata.data;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = idata.sel->get_index(i);
+		if ((*idata.nullmask)[idx]) {
+			continue;
+		}
+		auto state = states[sdata.sel->get_index(i)];
+		if (!state->log) {
+			state->log = new HyperLogLog();
+		}
+		state->log->Add(hashes[hdata.sel->get_index(i)]);
+	}
+}
+
+static void approx_count_distinct_simple_update(Vector inputs[], idx_t input_count, data_ptr_t state_p, idx_t count) {
+	assert(input_count == 1);
+	auto &input = inputs[0];
+
+	// hash the input values
+	Vector hash_vector(LogicalType::HASH);
+	VectorOperations::Hash(input, hash_vector, count);
+
+	VectorData idata, hdata;
+	input.Orrify(count, idata);
+	hash_vector.Orrify(count, hdata);
+
+	auto hashes = (hash_t *)hdata.data;
+	auto state = (approx_distinct_count_state_t *)state_p;
+	for (idx_t i = 0; i < count; i++) {
+		auto idx = idata.sel->get_index(i);
+		if ((*idata.nullmask)[idx]) {
+			continue;
+		}
+		if (!state->log) {
+			state->log = new HyperLogLog();
+		}
+		state->log->Add(hashes[hdata.sel->get_index(i)]);
+	}
+}
+
+void ApproxCountDistinctFun::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(AggregateFunction(
+	    "approx_count_distinct", {LogicalType::ANY}, LogicalType::BIGINT,
+	    AggregateFunction::StateSize<approx_distinct_count_state_t>,
+	    AggregateFunction::StateInitialize<approx_distinct_count_state_t, ApproxCountDistinctFunction>,
+	    approx_count_distinct_update,
+	    AggregateFunction::StateCombine<approx_distinct_count_state_t, ApproxCountDistinctFunction>,
+	    AggregateFunction::StateFinalize<approx_distinct_count_state_t, int64_t, ApproxCountDistinctFunction>,
+	    approx_count_distinct_simple_update, nullptr,
+	    AggregateFunction::StateDestroy<approx_distinct_count_state_t, ApproxCountDistinctFunction>));
+}
+
+} // namespace duckdb
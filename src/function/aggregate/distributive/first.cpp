@@ -93,6 +93,15 @@ struct FirstFunctionString : public FirstFunctionBase {
 		}
 	}
 
+	template <class STATE, class OP> static void Combine(STATE source, STATE *target) {
+		if (source.is_set && !target->is_set) {
+			// the source state is destroyed after the combine: copy the string
+			nullmask_t nullmask;
+			nullmask[0] = IsNullValue<string_t>(source.value);
+			Operation<string_t, STATE, OP>(target, &source.value, nullmask, 0);
+		}
+	}
+
 	template <class STATE> static void Destroy(STATE *state) {
 		if (state->is_set && !state->value.IsInlined()) {
 			delete[] state->value.GetData();
@@ -164,8 +164,9 @@ struct StringMinMaxBase : public MinMaxBase {
 			return;
 		}
 		if (!target->isset) {
-			// target is NULL, use source value directly
-			*target = source;
+			// target is NULL, copy the source value: the source state is destroyed after the combine
+			Assign(target, source.value);
+			target->isset = true;
 		} else {
 			OP::template Execute<string_t, STATE>(target, source.value);
 		}
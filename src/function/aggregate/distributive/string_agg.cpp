@@ -8,67 +8,117 @@ using namespace std;
 
 namespace duckdb {
 
+//! The initial and maximum capacity of the buffers that hold the concatenated strings of a group
+static constexpr idx_t STRING_AGG_INITIAL_CAPACITY = 16;
+static constexpr idx_t STRING_AGG_MAXIMUM_CAPACITY = 8192;
+
+//! A buffer in the chain of buffers that holds the concatenated strings of a group. Buffers are never reallocated:
+//! when a buffer is full a new (larger) buffer is appended to the chain.
+struct StringAggBuffer {
+	StringAggBuffer(idx_t capacity) : size(0), capacity(capacity) {
+		data = unique_ptr<char[]>(new char[capacity]);
+	}
+
+	unique_ptr<char[]> data;
+	idx_t size;
+	idx_t capacity;
+	unique_ptr<StringAggBuffer> next;
+};
+
 struct string_agg_state_t {
-	char *dataptr;
+	//! The first buffer of the chain, owns the rest of the chain
+	StringAggBuffer *head;
+	//! The buffer that is currently appended to
+	StringAggBuffer *tail;
+	//! The total amount of bytes stored in the chain
 	idx_t size;
-	idx_t alloc_size;
+	//! Every string is stored together with the separator that precedes it; the separator of the first string is
+	//! skipped when the result is constructed
+	idx_t skip;
 };
 
 struct StringAggFunction {
 	template <class STATE> static void Initialize(STATE *state) {
-		state->dataptr = nullptr;
-		state->alloc_size = 0;
+		state->head = nullptr;
+		state->tail = nullptr;
 		state->size = 0;
+		state->skip = 0;
+	}
+
+	template <class STATE> static void AppendData(STATE *state, const char *data, idx_t len) {
+		if (!state->head) {
+			state->head = new StringAggBuffer(MaxValue<idx_t>(STRING_AGG_INITIAL_CAPACITY, NextPowerOfTwo(len)));
+			state->tail = state->head;
+		}
+		state->size += len;
+		while (true) {
+			auto tail = state->tail;
+			auto copy_count = MinValue<idx_t>(len, tail->capacity - tail->size);
+			memcpy(tail->data.get() + tail->size, data, copy_count);
+			tail->size += copy_count;
+			data += copy_count;
+			len -= copy_count;
+			if (len == 0) {
+				break;
+			}
+			// the buffer is full: append a new buffer to the chain
+			auto capacity = MaxValue<idx_t>(MinValue<idx_t>(tail->capacity * 2, STRING_AGG_MAXIMUM_CAPACITY), len);
+			tail->next = make_unique<StringAggBuffer>(capacity);
+			state->tail = tail->next.get();
+		}
 	}
 
 	template <class A_TYPE, class B_TYPE, class STATE, class OP>
 	static void Operation(STATE *state, A_TYPE *str_data, B_TYPE *sep_data, nullmask_t &str_nullmask,
 	                      nullmask_t &sep_nullmask, idx_t str_idx, idx_t sep_idx) {
-		auto str = str_data[str_idx].GetData();
-		auto sep = sep_data[sep_idx].GetData();
-		auto str_size = str_data[str_idx].GetSize() + 1;
-		auto sep_size = sep_data[sep_idx].GetSize();
+		auto &str = str_data[str_idx];
+		auto &sep = sep_data[sep_idx];
+		if (!state->head) {
+			state->skip = sep.GetSize();
+		}
+		AppendData<STATE>(state, sep.GetData(), sep.GetSize());
+		AppendData<STATE>(state, str.GetData(), str.GetSize());
+	}
 
-		if (state->dataptr == nullptr) {
-			// first iteration: allocate space for the string and copy it into the state
-			state->alloc_size = MaxValue<idx_t>(8, NextPowerOfTwo(str_size));
-			state->dataptr = new char[state->alloc_size];
-			state->size = str_size - 1;
-			memcpy(state->dataptr, str, str_size);
-		} else {
-			// subsequent iteration: first check if we have space to place the string and separator
-			idx_t required_size = state->size + str_size + sep_size;
-			if (required_size > state->alloc_size) {
-				// no space! allocate extra space
-				while (state->alloc_size < required_size) {
-					state->alloc_size *= 2;
-				}
-				auto new_data = new char[state->alloc_size];
-				memcpy(new_data, state->dataptr, state->size);
-				delete[] state->dataptr;
-				state->dataptr = new_data;
-			}
-			// copy the separator
-			memcpy(state->dataptr + state->size, sep, sep_size);
-			state->size += sep_size;
-			// copy the string
-			memcpy(state->dataptr + state->size, str, str_size);
-			state->size += str_size - 1;
+	template <class STATE, class OP> static void Combine(STATE source, STATE *target) {
+		if (!source.head) {
+			return;
+		}
+		if (!target->head) {
+			target->skip = source.skip;
+		}
+		for (auto buffer = source.head; buffer; buffer = buffer->next.get()) {
+			AppendData<STATE>(target, buffer->data.get(), buffer->size);
 		}
 	}
 
 	template <class T, class STATE>
 	static void Finalize(Vector &result, STATE *state, T *target, nullmask_t &nullmask, idx_t idx) {
-		if (!state->dataptr) {
+		if (!state->head) {
 			nullmask[idx] = true;
-		} else {
-			target[idx] = StringVector::AddString(result, state->dataptr, state->size);
+			return;
+		}
+		assert(state->size >= state->skip);
+		auto result_str = StringVector::EmptyString(result, state->size - state->skip);
+		auto result_data = result_str.GetData();
+		idx_t skip = state->skip;
+		for (auto buffer = state->head; buffer; buffer = buffer->next.get()) {
+			auto skip_count = MinValue<idx_t>(skip, buffer->size);
+			memcpy(result_data, buffer->data.get() + skip_count, buffer->size - skip_count);
+			result_data += buffer->size - skip_count;
+			skip -= skip_count;
 		}
+		result_str.Finalize();
+		target[idx] = result_str;
 	}
 
 	template <class STATE> static void Destroy(STATE *state) {
-		if (state->dataptr) {
-			delete[] state->dataptr;
+		// destroy the chain iteratively to avoid deep recursion for very large strings
+		auto buffer = state->head;
+		while (buffer) {
+			auto next = buffer->next.release();
+			delete buffer;
+			buffer = next;
 		}
 	}
 
@@ -83,7 +133,8 @@ void StringAggFun::RegisterFunction(BuiltinFunctions &set) {
 	    {LogicalType::VARCHAR, LogicalType::VARCHAR}, LogicalType::VARCHAR,
 	    AggregateFunction::StateSize<string_agg_state_t>,
 	    AggregateFunction::StateInitialize<string_agg_state_t, StringAggFunction>,
-	    AggregateFunction::BinaryScatterUpdate<string_agg_state_t, string_t, string_t, StringAggFunction>, nullptr,
+	    AggregateFunction::BinaryScatterUpdate<string_agg_state_t, string_t, string_t, StringAggFunction>,
+	    AggregateFunction::StateCombine<string_agg_state_t, StringAggFunction>,
 	    AggregateFunction::StateFinalize<string_agg_state_t, string_t, StringAggFunction>,
 	    AggregateFunction::BinaryUpdate<string_agg_state_t, string_t, string_t, StringAggFunction>, nullptr,
 	    AggregateFunction::StateDestroy<string_agg_state_t, StringAggFunction>));
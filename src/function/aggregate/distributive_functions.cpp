@@ -9,6 +9,7 @@ using namespace std;
 namespace duckdb {
 
 void BuiltinFunctions::RegisterDistributiveAggregates() {
+	Register<ApproxCountDistinctFun>();
 	Register<BitAndFun>();
 	Register<BitOrFun>();
 	Register<BitXorFun>();
@@ -0,0 +1,116 @@
+#include "duckdb/function/aggregate/holistic_functions.hpp"
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/types/tdigest.hpp"
+#include "duckdb/execution/expression_executor.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+struct approx_quantile_state_t {
+	TDigest *digest;
+	double quantile;
+};
+
+struct ApproximateQuantileOperation {
+	template <class STATE> static void Initialize(STATE *state) {
+		state->digest = nullptr;
+		state->quantile = 0.5;
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, INPUT_TYPE *input, nullmask_t &nullmask, idx_t idx) {
+		if (!Value::DoubleIsValid(input[idx])) {
+			return;
+		}
+		if (!state->digest) {
+			state->digest = new TDigest();
+		}
+		state->digest->Add(input[idx]);
+	}
+
+	template <class INPUT_TYPE, class STATE, class OP>
+	static void ConstantOperation(STATE *state, INPUT_TYPE *input, nullmask_t &nullmask, idx_t count) {
+		for (idx_t i = 0; i < count; i++) {
+			Operation<INPUT_TYPE, STATE, OP>(state, input, nullmask, 0);
+		}
+	}
+
+	template <class A_TYPE, class B_TYPE, class STATE, class OP>
+	static void Operation(STATE *state, A_TYPE *x_data, B_TYPE *q_data, nullmask_t &x_nullmask,
+	                      nullmask_t &q_nullmask, idx_t xidx, idx_t qidx) {
+		// the quantile is constant (this is verified in the bind), so we can just store it in the state
+		state->quantile = q_data[qidx];
+		Operation<A_TYPE, STATE, OP>(state, x_data, x_nullmask, xidx);
+	}
+
+	template <class STATE, class OP> static void Combine(STATE source, STATE *target) {
+		if (!source.digest) {
+			return;
+		}
+		target->quantile = source.quantile;
+		if (!target->digest) {
+			// the source state might still be used after the combine (e.g. by the window segment tree): copy it
+			target->digest = new TDigest(*source.digest);
+		} else {
+			target->digest->Merge(*source.digest);
+		}
+	}
+
+	template <class T, class STATE>
+	static void Finalize(Vector &result, STATE *state, T *target, nullmask_t &nullmask, idx_t idx) {
+		if (!state->digest) {
+			nullmask[idx] = true;
+		} else {
+			target[idx] = state->digest->Quantile(state->quantile);
+		}
+	}
+
+	template <class STATE> static void Destroy(STATE *state) {
+		if (state->digest) {
+			delete state->digest;
+		}
+	}
+
+	static bool IgnoreNull() {
+		return true;
+	}
+};
+
+static unique_ptr<FunctionData> bind_approx_quantile(ClientContext &context, AggregateFunction &function,
+                                                     vector<unique_ptr<Expression>> &arguments) {
+	if (!arguments[1]->IsScalar()) {
+		throw BinderException("APPROX_QUANTILE can only take a constant quantile parameter");
+	}
+	Value quantile_val = ExpressionExecutor::EvaluateScalar(*arguments[1]);
+	if (quantile_val.is_null) {
+		throw BinderException("APPROX_QUANTILE quantile parameter cannot be NULL");
+	}
+	auto quantile = quantile_val.CastAs(LogicalType::DOUBLE).GetValue<double>();
+	if (quantile < 0 || quantile > 1) {
+		throw BinderException("APPROX_QUANTILE can only take parameters in the range [0, 1]");
+	}
+	return nullptr;
+}
+
+void ApproximateQuantileFun::RegisterFunction(BuiltinFunctions &set) {
+	AggregateFunctionSet approx_quantile("approx_quantile");
+	auto fun = AggregateFunction::BinaryAggregate<approx_quantile_state_t, double, double, double,
+	                                              ApproximateQuantileOperation>(
+	    LogicalType::DOUBLE, LogicalType::DOUBLE, LogicalType::DOUBLE);
+	fun.bind = bind_approx_quantile;
+	fun.destructor = AggregateFunction::StateDestroy<approx_quantile_state_t, ApproximateQuantileOperation>;
+	approx_quantile.AddFunction(fun);
+	set.AddFunction(approx_quantile);
+}
+
+void MedianFun::RegisterFunction(BuiltinFunctions &set) {
+	AggregateFunctionSet median("median");
+	median.AddFunction(
+	    AggregateFunction::UnaryAggregateDestructor<approx_quantile_state_t, double, double,
+	                                                ApproximateQuantileOperation>(LogicalType::DOUBLE,
+	                                                                              LogicalType::DOUBLE));
+	set.AddFunction(median);
+}
+
+} // namespace duckdb
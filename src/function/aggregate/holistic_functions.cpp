@@ -0,0 +1,12 @@
+#include "duckdb/function/aggregate/holistic_functions.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+void BuiltinFunctions::RegisterHolisticAggregates() {
+	Register<ApproximateQuantileFun>();
+	Register<MedianFun>();
+}
+
+} // namespace duckdb
@@ -16,7 +16,13 @@ struct ListFunction {
 	}
 
 	template <class STATE, class OP> static void Combine(STATE source, STATE *target) {
-		throw NotImplementedException("COMBINE not implemented for LIST");
+		if (!source.cc) {
+			return;
+		}
+		if (!target->cc) {
+			target->cc = new ChunkCollection();
+		}
+		target->cc->Append(*source.cc);
 	}
 
 	template <class STATE> static void Destroy(STATE *state) {
@@ -67,7 +73,12 @@ static void list_finalize(Vector &state_vector, Vector &result, idx_t count) {
 	size_t total_len = 0;
 	for (idx_t i = 0; i < count; i++) {
 		auto state = states[sdata.sel->get_index(i)];
-		assert(state->cc);
+		if (!state->cc) {
+			FlatVector::SetNull(result, i, true);
+			list_struct_data[i].length = 0;
+			list_struct_data[i].offset = total_len;
+			continue;
+		}
 		auto &state_cc = *state->cc;
 		assert(state_cc.types.size() == 1);
 		list_struct_data[i].length = state_cc.count;
@@ -78,6 +89,9 @@ static void list_finalize(Vector &state_vector, Vector &result, idx_t count) {
 	auto list_child = make_unique<ChunkCollection>();
 	for (idx_t i = 0; i < count; i++) {
 		auto state = states[sdata.sel->get_index(i)];
+		if (!state->cc) {
+			continue;
+		}
 		auto &state_cc = *state->cc;
 		assert(state_cc.chunks[0]->column_count() == 1);
 		list_child->Append(state_cc);
@@ -100,7 +114,8 @@ unique_ptr<FunctionData> list_bind(ClientContext &context, AggregateFunction &fu
 void ListFun::RegisterFunction(BuiltinFunctions &set) {
 	auto agg = AggregateFunction(
 	    "list", {LogicalType::ANY}, LogicalType::LIST, AggregateFunction::StateSize<list_agg_state_t>,
-	    AggregateFunction::StateInitialize<list_agg_state_t, ListFunction>, list_update, nullptr, list_finalize,
+	    AggregateFunction::StateInitialize<list_agg_state_t, ListFunction>, list_update,
+	    AggregateFunction::StateCombine<list_agg_state_t, ListFunction>, list_finalize,
 	    nullptr, list_bind, AggregateFunction::StateDestroy<list_agg_state_t, ListFunction>);
 	set.AddFunction(agg);
 }
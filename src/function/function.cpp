@@ -32,6 +32,7 @@ void BuiltinFunctions::Initialize() {
 
 	RegisterAlgebraicAggregates();
 	RegisterDistributiveAggregates();
+	RegisterHolisticAggregates();
 	RegisterNestedAggregates();
 
 	RegisterDateFunctions();
@@ -1,4 +1,5 @@
 #include "duckdb/function/pragma/pragma_functions.hpp"
+#include "duckdb/catalog/catalog.hpp"
 
 #include "duckdb/common/operator/cast_operators.hpp"
 #include "duckdb/main/client_context.hpp"
@@ -45,6 +46,26 @@ static void pragma_disable_profiling(ClientContext &context, vector<Value> param
 	context.profiler.automatic_print_format = ProfilerPrintFormat::NONE;
 }
 
+static void pragma_enable_sampling_profiler_statement(ClientContext &context, vector<Value> parameters) {
+	context.profiler.EnableSampling(QueryProfiler::DEFAULT_SAMPLE_RATE);
+}
+
+static void pragma_enable_sampling_profiler_assignment(ClientContext &context, vector<Value> parameters) {
+	auto sample_rate = parameters[0].GetValue<int64_t>();
+	if (sample_rate < 1) {
+		throw ParserException("Sample rate of the sampling profiler must be at least 1");
+	}
+	context.profiler.EnableSampling(sample_rate);
+}
+
+static void pragma_disable_sampling_profiler(ClientContext &context, vector<Value> parameters) {
+	context.profiler.DisableSampling();
+}
+
+static void pragma_reset_sampling_profile(ClientContext &context, vector<Value> parameters) {
+	context.profiler.ResetSampledTimings();
+}
+
 static void pragma_profile_output(ClientContext &context, vector<Value> parameters) {
 	context.profiler.save_location = parameters[0].ToString();
 }
@@ -57,12 +78,18 @@ static void pragma_memory_limit(ClientContext &context, vector<Value> parameters
 	context.db.storage->buffer_manager->SetLimit(new_limit);
 }
 
+static void pragma_query_memory_limit(ClientContext &context, vector<Value> parameters) {
+	context.query_memory_limit = ParseMemoryLimit(parameters[0].ToString());
+}
+
 static void pragma_collation(ClientContext &context, vector<Value> parameters) {
 	auto collation_param = StringUtil::Lower(parameters[0].ToString());
 	// bind the collation to verify that it exists
 	ExpressionBinder::TestCollation(context, collation_param);
 	auto &config = DBConfig::GetConfig(context);
 	config.collation = collation_param;
+	// the default collation is applied when binding, so plans created with the old collation are stale
+	Catalog::GetCatalog(context).ModifyCatalog();
 }
 
 static void pragma_null_order(ClientContext &context, vector<Value> parameters) {
@@ -76,6 +103,7 @@ static void pragma_null_order(ClientContext &context, vector<Value> parameters)
 		throw ParserException("Unrecognized null order '%s', expected either NULLS FIRST or NULLS LAST",
 		                      new_null_order);
 	}
+	Catalog::GetCatalog(context).ModifyCatalog();
 }
 
 static void pragma_default_order(ClientContext &context, vector<Value> parameters) {
@@ -88,6 +116,7 @@ static void pragma_default_order(ClientContext &context, vector<Value> parameter
 	} else {
 		throw ParserException("Unrecognized order order '%s', expected either ASCENDING or DESCENDING", new_order);
 	}
+	Catalog::GetCatalog(context).ModifyCatalog();
 }
 
 static void pragma_set_threads(ClientContext &context, vector<Value> parameters) {
@@ -138,10 +167,20 @@ void PragmaFunctions::RegisterFunction(BuiltinFunctions &set) {
 	set.AddFunction(PragmaFunction::PragmaStatement("disable_profile", pragma_disable_profiling));
 	set.AddFunction(PragmaFunction::PragmaStatement("disable_profiling", pragma_disable_profiling));
 
+	vector<PragmaFunction> sampling_functions;
+	sampling_functions.push_back(PragmaFunction::PragmaStatement(string(), pragma_enable_sampling_profiler_statement));
+	sampling_functions.push_back(
+	    PragmaFunction::PragmaAssignment(string(), pragma_enable_sampling_profiler_assignment, LogicalType::BIGINT));
+	set.AddFunction("enable_sampling_profiler", sampling_functions);
+	set.AddFunction(PragmaFunction::PragmaStatement("disable_sampling_profiler", pragma_disable_sampling_profiler));
+	set.AddFunction(PragmaFunction::PragmaStatement("reset_sampling_profile", pragma_reset_sampling_profile));
+
 	set.AddFunction(PragmaFunction::PragmaAssignment("profile_output", pragma_profile_output, LogicalType::VARCHAR));
 	set.AddFunction(PragmaFunction::PragmaAssignment("profiling_output", pragma_profile_output, LogicalType::VARCHAR));
 
 	set.AddFunction(PragmaFunction::PragmaAssignment("memory_limit", pragma_memory_limit, LogicalType::VARCHAR));
+	set.AddFunction(
+	    PragmaFunction::PragmaAssignment("query_memory_limit", pragma_query_memory_limit, LogicalType::VARCHAR));
 
 	set.AddFunction(PragmaFunction::PragmaAssignment("collation", pragma_collation, LogicalType::VARCHAR));
 	set.AddFunction(PragmaFunction::PragmaAssignment("default_collation", pragma_collation, LogicalType::VARCHAR));
@@ -28,6 +28,10 @@ string pragma_show(ClientContext &context, vector<Value> parameters) {
 	    parameters[0].ToString());
 }
 
+string pragma_sampling_profile(ClientContext &context, vector<Value> parameters) {
+	return "SELECT * FROM pragma_sampling_profile() ORDER BY estimated_time DESC";
+}
+
 string pragma_version(ClientContext &context, vector<Value> parameters) {
 	return "SELECT * FROM pragma_version()";
 }
@@ -56,6 +60,7 @@ void PragmaQueries::RegisterFunction(BuiltinFunctions &set) {
 	set.AddFunction(PragmaFunction::PragmaStatement("collations", pragma_collations));
 	set.AddFunction(PragmaFunction::PragmaCall("show", pragma_show, {LogicalType::VARCHAR}));
 	set.AddFunction(PragmaFunction::PragmaStatement("version", pragma_version));
+	set.AddFunction(PragmaFunction::PragmaStatement("sampling_profile", pragma_sampling_profile));
 	set.AddFunction(PragmaFunction::PragmaCall("import_database", pragma_import_database, {LogicalType::VARCHAR}));
 }
 
@@ -6,6 +6,8 @@
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/common/types/string_type.hpp"
+#include "duckdb/common/types/numeric_helper.hpp"
+#include "duckdb/common/unordered_map.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 
 using namespace std;
@@ -42,6 +44,9 @@ struct BaseCSVData : public FunctionData {
 	void Finalize();
 };
 
+//! Writes the value at the given index of a vector directly to the serializer, without casting it to VARCHAR first
+typedef void (*csv_format_function_t)(Serializer &serializer, data_ptr_t data, idx_t idx, uint8_t scale);
+
 struct WriteCSVData : public BaseCSVData {
 	WriteCSVData(string file_path, vector<LogicalType> sql_types, vector<string> names)
 	    : BaseCSVData(move(file_path)), sql_types(move(sql_types)), names(move(names)) {
@@ -53,12 +58,15 @@ struct WriteCSVData : public BaseCSVData {
 	vector<string> names;
 	//! True, if column with that index must be quoted
 	vector<bool> force_quote;
+	//! The function used to format the values of the column with that index, or nullptr if the column is cast to
+	//! VARCHAR instead
+	vector<csv_format_function_t> format_functions;
 	//! The newline string to write
 	string newline = "\n";
 	//! Whether or not we are writing a simple CSV (delimiter, quote and escape are all 1 byte in length)
 	bool is_simple;
 	//! The size of the CSV file (in bytes) that we buffer before we flush it to disk
-	idx_t flush_size = 4096 * 8;
+	idx_t flush_size = 1024 * 1024;
 };
 
 struct ReadCSVData : public BaseCSVData {
@@ -221,6 +229,79 @@ static vector<bool> ParseColumnList(vector<Value> &set, vector<string> &names) {
 	return result;
 }
 
+static bool IsNumericCharacter(char c) {
+	return (c >= '0' && c <= '9') || c == '-' || c == '.';
+}
+
+//! Whether or not a formatted number can require quotes with the given options, which happens if the delimiter or
+//! quote contain characters that occur in numbers, or if a number could be equal to the NULL string
+static bool NumbersRequireQuotes(WriteCSVData &options) {
+	for (auto c : options.delimiter + options.quote) {
+		if (IsNumericCharacter(c)) {
+			return true;
+		}
+	}
+	if (options.null_str.empty()) {
+		return false;
+	}
+	for (auto c : options.null_str) {
+		if (!IsNumericCharacter(c)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <class SIGNED, class UNSIGNED>
+static void FormatInteger(Serializer &serializer, data_ptr_t data, idx_t idx, uint8_t scale) {
+	auto value = ((SIGNED *)data)[idx];
+	char buffer[32];
+	int sign = -(value < 0);
+	UNSIGNED unsigned_value = (value ^ sign) - sign;
+	auto end = buffer + sizeof(buffer);
+	auto start = NumericHelper::FormatUnsigned<UNSIGNED>(unsigned_value, end);
+	if (sign) {
+		*--start = '-';
+	}
+	serializer.WriteData((const_data_ptr_t)start, end - start);
+}
+
+template <class SIGNED, class UNSIGNED>
+static void FormatDecimal(Serializer &serializer, data_ptr_t data, idx_t idx, uint8_t scale) {
+	auto value = ((SIGNED *)data)[idx];
+	char buffer[32];
+	auto len = DecimalToString::DecimalLength<SIGNED, UNSIGNED>(value, scale);
+	DecimalToString::FormatDecimal<SIGNED, UNSIGNED>(value, scale, buffer, len);
+	serializer.WriteData((const_data_ptr_t)buffer, len);
+}
+
+//! Returns the function used to directly format values of the given type, or nullptr if there is none
+static csv_format_function_t GetFormatFunction(LogicalType &type) {
+	switch (type.id()) {
+	case LogicalTypeId::TINYINT:
+		return FormatInteger<int8_t, uint8_t>;
+	case LogicalTypeId::SMALLINT:
+		return FormatInteger<int16_t, uint16_t>;
+	case LogicalTypeId::INTEGER:
+		return FormatInteger<int32_t, uint32_t>;
+	case LogicalTypeId::BIGINT:
+		return FormatInteger<int64_t, uint64_t>;
+	case LogicalTypeId::DECIMAL:
+		switch (type.InternalType()) {
+		case PhysicalType::INT16:
+			return FormatDecimal<int16_t, uint16_t>;
+		case PhysicalType::INT32:
+			return FormatDecimal<int32_t, uint32_t>;
+		case PhysicalType::INT64:
+			return FormatDecimal<int64_t, uint64_t>;
+		default:
+			return nullptr;
+		}
+	default:
+		return nullptr;
+	}
+}
+
 static unique_ptr<FunctionData> write_csv_bind(ClientContext &context, CopyInfo &info, vector<string> &names,
                                                vector<LogicalType> &sql_types) {
 	auto bind_data = make_unique<WriteCSVData>(info.file_path, sql_types, names);
@@ -246,6 +327,15 @@ static unique_ptr<FunctionData> write_csv_bind(ClientContext &context, CopyInfo
 	bind_data->Finalize();
 	bind_data->is_simple =
 	    bind_data->delimiter.size() == 1 && bind_data->escape.size() == 1 && bind_data->quote.size() == 1;
+	// numbers can be formatted directly if they can never require quotes
+	bool numbers_require_quotes = NumbersRequireQuotes(*bind_data);
+	for (idx_t i = 0; i < sql_types.size(); i++) {
+		csv_format_function_t format_function = nullptr;
+		if (!numbers_require_quotes && !bind_data->force_quote[i]) {
+			format_function = GetFormatFunction(sql_types[i]);
+		}
+		bind_data->format_functions.push_back(format_function);
+	}
 	return move(bind_data);
 }
 
@@ -427,6 +517,8 @@ struct LocalReadCSVData : public LocalFunctionData {
 	BufferedSerializer serializer;
 	//! A chunk with VARCHAR columns to cast intermediates into
 	DataChunk cast_chunk;
+	//! The orrified columns that are written
+	vector<VectorData> columns;
 };
 
 struct GlobalWriteCSVData : public GlobalFunctionData {
@@ -440,11 +532,49 @@ struct GlobalWriteCSVData : public GlobalFunctionData {
 		fs.Write(*handle, (void *)data, size);
 	}
 
+	//! Writes the data buffered for the batch to the file if all preceding batches have been written, returns whether
+	//! or not the data was written
+	bool FlushBatch(idx_t batch_index, BufferedSerializer &serializer) {
+		lock_guard<mutex> flock(lock);
+		if (batch_index != next_batch) {
+			return false;
+		}
+		fs.Write(*handle, (void *)serializer.blob.data.get(), serializer.blob.size);
+		serializer.Reset();
+		return true;
+	}
+
+	//! Finishes a batch: if all preceding batches have been written the remaining data of the batch is written,
+	//! followed by the finished batches that directly follow it. Otherwise the data is kept until they have been.
+	void FinishBatch(idx_t batch_index, BufferedSerializer &serializer) {
+		lock_guard<mutex> flock(lock);
+		if (batch_index != next_batch) {
+			pending_batches[batch_index] = serializer.GetData();
+			return;
+		}
+		fs.Write(*handle, (void *)serializer.blob.data.get(), serializer.blob.size);
+		serializer.Reset();
+		next_batch++;
+		while (true) {
+			auto entry = pending_batches.find(next_batch);
+			if (entry == pending_batches.end()) {
+				break;
+			}
+			fs.Write(*handle, (void *)entry->second.data.get(), entry->second.size);
+			pending_batches.erase(entry);
+			next_batch++;
+		}
+	}
+
 	FileSystem &fs;
 	//! The mutex for writing to the physical file
 	mutex lock;
 	//! The file handle to write to
 	unique_ptr<FileHandle> handle;
+	//! The index of the next batch that is written to the file
+	idx_t next_batch = 0;
+	//! The data of finished batches that cannot be written yet because a preceding batch is still running
+	unordered_map<idx_t, BinaryData> pending_batches;
 };
 
 static unique_ptr<LocalFunctionData> write_csv_initialize_local(ClientContext &context, FunctionData &bind_data) {
@@ -456,6 +586,7 @@ static unique_ptr<LocalFunctionData> write_csv_initialize_local(ClientContext &c
 	types.resize(csv_data.names.size(), LogicalType::VARCHAR);
 
 	local_data->cast_chunk.Initialize(types);
+	local_data->columns.resize(csv_data.names.size());
 	return move(local_data);
 }
 
@@ -487,50 +618,53 @@ static void write_csv_sink(ClientContext &context, FunctionData &bind_data, Glob
 
 	// write data into the local buffer
 
-	// first cast the columns of the chunk to varchar
+	// first cast the columns of the chunk that we cannot format directly to varchar
 	auto &cast_chunk = local_data.cast_chunk;
 	cast_chunk.SetCardinality(input);
 	for (idx_t col_idx = 0; col_idx < input.column_count(); col_idx++) {
-		if (csv_data.sql_types[col_idx].id() == LogicalTypeId::VARCHAR ||
+		if (csv_data.format_functions[col_idx] || csv_data.sql_types[col_idx].id() == LogicalTypeId::VARCHAR ||
 		    csv_data.sql_types[col_idx].id() == LogicalTypeId::BLOB) {
-			// VARCHAR, just create a reference
-			cast_chunk.data[col_idx].Reference(input.data[col_idx]);
+			// VARCHAR or a column we can format directly, use the input data
+			input.data[col_idx].Orrify(input.size(), local_data.columns[col_idx]);
 		} else {
-			// non varchar column, perform the cast
+			// other column, perform the cast
 			VectorOperations::Cast(input.data[col_idx], cast_chunk.data[col_idx], input.size());
+			cast_chunk.data[col_idx].Orrify(input.size(), local_data.columns[col_idx]);
 		}
 	}
 
-	cast_chunk.Normalify();
 	auto &writer = local_data.serializer;
 	// now loop over the vectors and output the values
-	for (idx_t row_idx = 0; row_idx < cast_chunk.size(); row_idx++) {
+	for (idx_t row_idx = 0; row_idx < input.size(); row_idx++) {
 		// write values
-		for (idx_t col_idx = 0; col_idx < cast_chunk.column_count(); col_idx++) {
+		for (idx_t col_idx = 0; col_idx < input.column_count(); col_idx++) {
 			if (col_idx != 0) {
 				writer.WriteBufferData(csv_data.delimiter);
 			}
-			if (FlatVector::IsNull(cast_chunk.data[col_idx], row_idx)) {
+			auto &column = local_data.columns[col_idx];
+			auto idx = column.sel->get_index(row_idx);
+			if ((*column.nullmask)[idx]) {
 				// write null value
 				writer.WriteBufferData(csv_data.null_str);
 				continue;
 			}
+			if (csv_data.format_functions[col_idx]) {
+				// the value never requires quotes: format it directly
+				csv_data.format_functions[col_idx](writer, column.data, idx, csv_data.sql_types[col_idx].scale());
+				continue;
+			}
 
 			// non-null value, fetch the string value from the cast chunk
-			auto str_data = FlatVector::GetData<string_t>(cast_chunk.data[col_idx]);
-			auto str_value = str_data[row_idx];
-			// FIXME: we could gain some performance here by checking for certain types if they ever require quotes
-			// (e.g. integers only require quotes if the delimiter is a number, decimals only require quotes if the
-			// delimiter is a number or "." character)
+			auto str_value = ((string_t *)column.data)[idx];
 			WriteQuotedString(writer, csv_data, str_value.GetData(), str_value.GetSize(),
 			                  csv_data.force_quote[col_idx]);
 		}
 		writer.WriteBufferData(csv_data.newline);
 	}
 	// check if we should flush what we have currently written
+	// the data of a batch can only be written once all preceding batches are written, so that the order is preserved
 	if (writer.blob.size >= csv_data.flush_size) {
-		global_state.WriteData(writer.blob.data.get(), writer.blob.size);
-		writer.Reset();
+		global_state.FlushBatch(local_data.batch_index, writer);
 	}
 }
 
@@ -541,12 +675,8 @@ static void write_csv_combine(ClientContext &context, FunctionData &bind_data, G
                               LocalFunctionData &lstate) {
 	auto &local_data = (LocalReadCSVData &)lstate;
 	auto &global_state = (GlobalWriteCSVData &)gstate;
-	auto &writer = local_data.serializer;
 	// flush the local writer
-	if (writer.blob.size > 0) {
-		global_state.WriteData(writer.blob.data.get(), writer.blob.size);
-		writer.Reset();
-	}
+	global_state.FinishBatch(local_data.batch_index, local_data.serializer);
 }
 
 //===--------------------------------------------------------------------===//
@@ -1,21 +1,38 @@
 #include "duckdb/function/table/read_csv.hpp"
 #include "duckdb/execution/operator/persistent/buffered_csv_reader.hpp"
 #include "duckdb/function/function_set.hpp"
+#include "duckdb/common/file_system.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/database.hpp"
+#include "duckdb/parallel/task_context.hpp"
 
 using namespace std;
 
 namespace duckdb {
 
 struct ReadCSVFunctionData : public TableFunctionData {
-	ReadCSVFunctionData() : is_consumed(false) {
-	}
+	//! The files that are read, the glob pattern given to the function is expanded at bind time
+	vector<string> files;
+	//! The options of the CSV readers, including the dialect that was detected on the first file (if any)
+	BufferedCSVReaderOptions options;
+	//! The types of the columns of the files
+	vector<LogicalType> sql_types;
+};
 
-	//! The CSV reader
+//! The state of a scan over one or more of the files
+struct ReadCSVOperatorData : public FunctionOperatorData {
+	//! The CSV reader of the file that is currently being read
 	unique_ptr<BufferedCSVReader> csv_reader;
-	//! Whether or not the CSV has already been read completely
-	bool is_consumed;
+	//! The index of the file that is currently being read
+	idx_t file_index;
+	//! The index of the file at which the scan stops
+	idx_t file_end;
+};
+
+//! A parallel task that reads a single file
+class ReadCSVTaskInfo : public OperatorTaskInfo {
+public:
+	idx_t file_index;
 };
 
 static unique_ptr<FunctionData> read_csv_bind(ClientContext &context, vector<Value> &inputs,
@@ -23,8 +40,19 @@ static unique_ptr<FunctionData> read_csv_bind(ClientContext &context, vector<Val
                                               vector<LogicalType> &return_types, vector<string> &names) {
 	auto result = make_unique<ReadCSVFunctionData>();
 
+	auto &file_pattern = inputs[0].str_value;
+	if (FileSystem::HasGlob(file_pattern)) {
+		auto &fs = FileSystem::GetFileSystem(context);
+		result->files = fs.Glob(file_pattern);
+		if (result->files.empty()) {
+			throw IOException("No files found that match the pattern \"%s\"", file_pattern);
+		}
+	} else {
+		result->files.push_back(file_pattern);
+	}
+
 	BufferedCSVReaderOptions options;
-	options.file_path = inputs[0].str_value;
+	options.file_path = result->files[0];
 	options.auto_detect = false;
 	options.header = false;
 	options.delimiter = ",";
@@ -91,29 +119,64 @@ static unique_ptr<FunctionData> read_csv_bind(ClientContext &context, vector<Val
 	if (!options.auto_detect && return_types.size() == 0) {
 		throw BinderException("Specifying CSV options requires columns to be specified as well (for now)");
 	}
-	if (return_types.size() > 0) {
+	if (return_types.size() > 0 && !options.auto_detect) {
 		// return types specified: no auto detect
-		result->csv_reader = make_unique<BufferedCSVReader>(context, move(options), return_types);
-	} else {
-		// auto detect options
-		result->csv_reader = make_unique<BufferedCSVReader>(context, move(options));
-
-		return_types.assign(result->csv_reader->sql_types.begin(), result->csv_reader->sql_types.end());
-		names.assign(result->csv_reader->col_names.begin(), result->csv_reader->col_names.end());
+		result->options = move(options);
+		result->sql_types = return_types;
+		return move(result);
 	}
+	// detect the dialect (and the types if none were specified) on the first file, all files are read with it
+	BufferedCSVReader reader(context, move(options), return_types);
+	if (return_types.empty()) {
+		return_types.assign(reader.sql_types.begin(), reader.sql_types.end());
+		names.assign(reader.col_names.begin(), reader.col_names.end());
+	}
+	result->options = reader.options;
+	result->options.auto_detect = false;
+	result->sql_types = reader.sql_types;
 	return move(result);
 }
 
+//! Opens a CSV reader for the file at the given index
+static unique_ptr<BufferedCSVReader> open_csv_file(ClientContext &context, const ReadCSVFunctionData &bind_data,
+                                                   idx_t file_index) {
+	auto options = bind_data.options;
+	options.file_path = bind_data.files[file_index];
+	return make_unique<BufferedCSVReader>(context, move(options), bind_data.sql_types);
+}
+
 static unique_ptr<FunctionOperatorData> read_csv_init(ClientContext &context, const FunctionData *bind_data_,
                                                       OperatorTaskInfo *task_info, vector<column_t> &column_ids,
                                                       unordered_map<idx_t, vector<TableFilter>> &table_filters) {
-	auto &bind_data = (ReadCSVFunctionData &)*bind_data_;
-	if (bind_data.is_consumed) {
-		bind_data.csv_reader =
-		    make_unique<BufferedCSVReader>(context, bind_data.csv_reader->options, bind_data.csv_reader->sql_types);
+	auto &bind_data = (const ReadCSVFunctionData &)*bind_data_;
+	auto result = make_unique<ReadCSVOperatorData>();
+	if (task_info) {
+		// parallel scan: only read the file assigned to this task
+		auto &info = (ReadCSVTaskInfo &)*task_info;
+		result->file_index = info.file_index;
+		result->file_end = info.file_index + 1;
+	} else {
+		result->file_index = 0;
+		result->file_end = bind_data.files.size();
+	}
+	result->csv_reader = open_csv_file(context, bind_data, result->file_index);
+	return move(result);
+}
+
+static void read_csv_parallel(ClientContext &context, const FunctionData *bind_data_, vector<column_t> &column_ids,
+                              unordered_map<idx_t, vector<TableFilter>> &table_filters,
+                              std::function<void(unique_ptr<OperatorTaskInfo>)> callback) {
+	auto &bind_data = (const ReadCSVFunctionData &)*bind_data_;
+	if (bind_data.files.size() <= 1) {
+		// a single file is read sequentially
+		return;
+	}
+	// create one task per file
+	for (idx_t file_idx = 0; file_idx < bind_data.files.size(); file_idx++) {
+		auto task = make_unique<ReadCSVTaskInfo>();
+		task->file_index = file_idx;
+		callback(move(task));
 	}
-	bind_data.is_consumed = true;
-	return nullptr;
 }
 
 static unique_ptr<FunctionData> read_csv_auto_bind(ClientContext &context, vector<Value> &inputs,
@@ -123,10 +186,17 @@ static unique_ptr<FunctionData> read_csv_auto_bind(ClientContext &context, vecto
 	return read_csv_bind(context, inputs, named_parameters, return_types, names);
 }
 
-static void read_csv_function(ClientContext &context, const FunctionData *bind_data,
+static void read_csv_function(ClientContext &context, const FunctionData *bind_data_,
                               FunctionOperatorData *operator_state, DataChunk &output) {
-	auto &data = (ReadCSVFunctionData &)*bind_data;
+	auto &bind_data = (const ReadCSVFunctionData &)*bind_data_;
+	auto &data = (ReadCSVOperatorData &)*operator_state;
 	data.csv_reader->ParseCSV(output);
+	while (output.size() == 0 && data.file_index + 1 < data.file_end) {
+		// move on to the next file: it is read with the dialect and types that were detected on the first file
+		data.file_index++;
+		data.csv_reader = open_csv_file(context, bind_data, data.file_index);
+		data.csv_reader->ParseCSV(output);
+	}
 }
 
 static void add_named_parameters(TableFunction &table_function) {
@@ -146,12 +216,13 @@ static void add_named_parameters(TableFunction &table_function) {
 
 void ReadCSVTableFunction::RegisterFunction(BuiltinFunctions &set) {
 
-	TableFunction read_csv("read_csv", {LogicalType::VARCHAR}, read_csv_function, read_csv_bind, read_csv_init);
+	TableFunction read_csv("read_csv", {LogicalType::VARCHAR}, read_csv_function, read_csv_bind, read_csv_init,
+	                       nullptr, read_csv_parallel);
 	add_named_parameters(read_csv);
 	set.AddFunction(read_csv);
 
 	TableFunction read_csv_auto("read_csv_auto", {LogicalType::VARCHAR}, read_csv_function, read_csv_auto_bind,
-	                            read_csv_init);
+	                            read_csv_init, nullptr, read_csv_parallel);
 	add_named_parameters(read_csv_auto);
 	set.AddFunction(read_csv_auto);
 }
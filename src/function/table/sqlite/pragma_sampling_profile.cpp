@@ -0,0 +1,82 @@
+#include "duckdb/function/table/sqlite_functions.hpp"
+
+#include "duckdb/common/cycle_counter.hpp"
+#include "duckdb/main/client_context.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+struct PragmaSamplingProfileData : public FunctionOperatorData {
+	PragmaSamplingProfileData() : offset(0) {
+	}
+
+	vector<pair<PhysicalOperatorType, SampledOperatorTiming>> entries;
+	idx_t offset;
+};
+
+static unique_ptr<FunctionData> pragma_sampling_profile_bind(ClientContext &context, vector<Value> &inputs,
+                                                             unordered_map<string, Value> &named_parameters,
+                                                             vector<LogicalType> &return_types, vector<string> &names) {
+	names.push_back("operator");
+	return_types.push_back(LogicalType::VARCHAR);
+
+	names.push_back("chunks");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.push_back("cardinality");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.push_back("sampled_chunks");
+	return_types.push_back(LogicalType::BIGINT);
+
+	names.push_back("sampled_time");
+	return_types.push_back(LogicalType::DOUBLE);
+
+	names.push_back("estimated_time");
+	return_types.push_back(LogicalType::DOUBLE);
+
+	return nullptr;
+}
+
+static unique_ptr<FunctionOperatorData>
+pragma_sampling_profile_init(ClientContext &context, const FunctionData *bind_data, OperatorTaskInfo *task_info,
+                             vector<column_t> &column_ids, unordered_map<idx_t, vector<TableFilter>> &table_filters) {
+	auto result = make_unique<PragmaSamplingProfileData>();
+	result->entries = context.profiler.GetSampledTimings();
+	return move(result);
+}
+
+static void pragma_sampling_profile(ClientContext &context, const FunctionData *bind_data,
+                                    FunctionOperatorData *operator_state, DataChunk &output) {
+	auto &data = (PragmaSamplingProfileData &)*operator_state;
+	if (data.offset >= data.entries.size()) {
+		// finished returning values
+		return;
+	}
+	auto ticks_per_second = CycleCounter::TicksPerSecond();
+	idx_t next = min(data.offset + STANDARD_VECTOR_SIZE, (idx_t)data.entries.size());
+	output.SetCardinality(next - data.offset);
+	for (idx_t i = data.offset; i < next; i++) {
+		auto index = i - data.offset;
+		auto &timing = data.entries[i].second;
+		double sampled_time = timing.sampled_cycles / ticks_per_second;
+		// extrapolate the sampled time to all chunks produced by the operator
+		double estimated_time = timing.sampled_chunks == 0 ? 0 : sampled_time * timing.chunks / timing.sampled_chunks;
+		output.SetValue(0, index, Value(PhysicalOperatorToString(data.entries[i].first)));
+		output.SetValue(1, index, Value::BIGINT(timing.chunks));
+		output.SetValue(2, index, Value::BIGINT(timing.elements));
+		output.SetValue(3, index, Value::BIGINT(timing.sampled_chunks));
+		output.SetValue(4, index, Value::DOUBLE(sampled_time));
+		output.SetValue(5, index, Value::DOUBLE(estimated_time));
+	}
+
+	data.offset = next;
+}
+
+void PragmaSamplingProfile::RegisterFunction(BuiltinFunctions &set) {
+	set.AddFunction(TableFunction("pragma_sampling_profile", {}, pragma_sampling_profile, pragma_sampling_profile_bind,
+	                              pragma_sampling_profile_init));
+}
+
+} // namespace duckdb
@@ -16,6 +16,7 @@ void BuiltinFunctions::RegisterSQLiteFunctions() {
 	PragmaTableInfo::RegisterFunction(*this);
 	SQLiteMaster::RegisterFunction(*this);
 	PragmaDatabaseList::RegisterFunction(*this);
+	PragmaSamplingProfile::RegisterFunction(*this);
 
 	// CreateViewInfo info;
 	// info.schema = DEFAULT_SCHEMA;
@@ -93,20 +93,52 @@ typedef struct {
 	char *error_message;
 } duckdb_result;
 
-// typedef struct {
-// 	void *data;
-// 	bool *nullmask;
-// } duckdb_column_data;
+//! A string value in a result chunk. Strings of at most 11 bytes are stored inline in the struct itself, strings of 12
+//! bytes or longer point to their data. Use duckdb_string_data to obtain a pointer to the characters of the string,
+//! which are not necessarily null-terminated.
+typedef struct {
+	uint32_t length;
+	char prefix[4];
+	union {
+		char inlined[8];
+		char *ptr;
+	} value;
+} duckdb_string_t;
 
-// typedef struct {
-// 	int column_count;
-// 	int count;
-// 	duckdb_column_data *columns;
-// } duckdb_chunk;
+typedef struct {
+	//! The values of the column, stored in the internal representation of the type:
+	//! BOOLEAN: bool, TINYINT-BIGINT: int8_t-int64_t, HUGEINT: duckdb_hugeint, FLOAT: float, DOUBLE: double,
+	//! DATE: int32_t (see duckdb_from_date), TIME: int32_t (see duckdb_from_time),
+	//! TIMESTAMP: int64_t (see duckdb_from_timestamp), INTERVAL: duckdb_interval, VARCHAR: duckdb_string_t.
+	//! NULL for columns of an unsupported type.
+	void *data;
+	//! Whether or not each of the values is NULL, or NULL if none of the values in the chunk are NULL
+	bool *nullmask;
+} duckdb_column_data;
+
+typedef struct {
+	idx_t column_count;
+	//! The amount of rows in the chunk, zero if the end of the result has been reached
+	idx_t count;
+	duckdb_column_data *columns;
+	void *internal_data;
+} duckdb_chunk;
+
+typedef struct {
+	//! The type of the values, only BOOLEAN, TINYINT-BIGINT, HUGEINT, FLOAT, DOUBLE and VARCHAR are supported
+	duckdb_type type;
+	//! The values of the column as an array of the type (duckdb_hugeint for HUGEINT and const char * for VARCHAR)
+	void *data;
+	//! Whether or not each of the values is NULL, or NULL if none of the values are NULL. A NULL pointer in a VARCHAR
+	//! array is also treated as a NULL value.
+	bool *nullmask;
+} duckdb_column_array;
 
 typedef void *duckdb_database;
 typedef void *duckdb_connection;
 typedef void *duckdb_prepared_statement;
+typedef void *duckdb_streaming_result;
+typedef void *duckdb_appender;
 
 typedef enum { DuckDBSuccess = 0, DuckDBError = 1 } duckdb_state;
 
@@ -151,6 +183,41 @@ double duckdb_value_double(duckdb_result *result, idx_t col, idx_t row);
 //! Converts the specified value to a string. Returns nullptr on failure or NULL. The result must be freed with free.
 char *duckdb_value_varchar(duckdb_result *result, idx_t col, idx_t row);
 
+// Streaming results
+// Instead of materializing and converting the entire result, a streaming result hands out the result one chunk at a
+// time, pointing directly to the vectors of the chunk. Only one streaming result can be open per connection: issuing
+// another query on the connection closes it.
+
+//! Executes the specified SQL query in the specified connection handle, without materializing the result. The result
+//! must be destroyed with duckdb_destroy_stream, also when the query fails. [OUT: streaming result]
+duckdb_state duckdb_query_stream(duckdb_connection connection, const char *query,
+                                 duckdb_streaming_result *out_result);
+//! Returns the error message of a failed streaming result, or NULL if there is no error
+const char *duckdb_stream_error(duckdb_streaming_result result);
+//! Returns the amount of columns of the streaming result
+idx_t duckdb_stream_column_count(duckdb_streaming_result result);
+//! Returns the type of the specified column of the streaming result
+duckdb_type duckdb_stream_column_type(duckdb_streaming_result result, idx_t col);
+//! Returns the name of the specified column of the streaming result. The name does not need to be freed.
+const char *duckdb_stream_column_name(duckdb_streaming_result result, idx_t col);
+//! Fetches the next chunk of the streaming result. When the end of the result has been reached, the count of the chunk
+//! is zero. The chunk stays valid until it is destroyed with duckdb_destroy_chunk, also after fetching the next chunk.
+//! [OUT: chunk]
+duckdb_state duckdb_stream_fetch_chunk(duckdb_streaming_result result, duckdb_chunk *out_chunk);
+//! Destroys the specified chunk
+void duckdb_destroy_chunk(duckdb_chunk *chunk);
+//! Destroys the specified streaming result
+void duckdb_destroy_stream(duckdb_streaming_result *result);
+
+//! Returns a pointer to the characters of a string in a result chunk
+const char *duckdb_string_data(duckdb_string_t *string);
+//! Converts a DATE value in a result chunk to a duckdb_date
+duckdb_date duckdb_from_date(int32_t date);
+//! Converts a TIME value in a result chunk to a duckdb_time
+duckdb_time duckdb_from_time(int32_t time);
+//! Converts a TIMESTAMP value in a result chunk to a duckdb_timestamp
+duckdb_timestamp duckdb_from_timestamp(int64_t timestamp);
+
 // Prepared Statements
 
 //! prepares the specified SQL query in the specified connection handle. [OUT: prepared statement descriptor]
@@ -173,9 +240,54 @@ duckdb_state duckdb_bind_null(duckdb_prepared_statement prepared_statement, idx_
 //! Executes the prepared statements with currently bound parameters
 duckdb_state duckdb_execute_prepared(duckdb_prepared_statement prepared_statement, duckdb_result *out_result);
 
+//! Executes the prepared statement once for every row of parameters, where params contains one array of count values
+//! for each of the parameters. All executions run in a single transaction: if one of them fails, none of their
+//! changes are kept (unless a transaction was already started on the connection). [OUT: result of the last
+//! execution, or the error of the failing one]
+duckdb_state duckdb_execute_prepared_batch(duckdb_prepared_statement prepared_statement, duckdb_column_array *params,
+                                           idx_t count, duckdb_result *out_result);
+
 //! Destroys the specified prepared statement descriptor
 void duckdb_destroy_prepare(duckdb_prepared_statement *prepared_statement);
 
+// Appender
+// The appender loads data into a table without going through the parser and planner. Values are collected in chunks
+// and appended in bulk; they are only guaranteed to be in the table after a flush or after the appender is closed.
+
+//! Creates an appender for the specified table, schema can be NULL for the default schema. If creating the appender
+//! fails it must still be destroyed with duckdb_appender_destroy. [OUT: appender]
+duckdb_state duckdb_appender_create(duckdb_connection connection, const char *schema, const char *table,
+                                    duckdb_appender *out_appender);
+//! Returns the error message of the last failed call on the appender, or NULL if there is no error
+const char *duckdb_appender_error(duckdb_appender appender);
+//! Begins a new row, after which every column has to be appended to before calling duckdb_appender_end_row
+duckdb_state duckdb_appender_begin_row(duckdb_appender appender);
+//! Finishes the current row
+duckdb_state duckdb_appender_end_row(duckdb_appender appender);
+
+//! Appends a value to the current column of the current row, converting it to the type of the column if needed
+duckdb_state duckdb_append_bool(duckdb_appender appender, bool value);
+duckdb_state duckdb_append_int8(duckdb_appender appender, int8_t value);
+duckdb_state duckdb_append_int16(duckdb_appender appender, int16_t value);
+duckdb_state duckdb_append_int32(duckdb_appender appender, int32_t value);
+duckdb_state duckdb_append_int64(duckdb_appender appender, int64_t value);
+duckdb_state duckdb_append_float(duckdb_appender appender, float value);
+duckdb_state duckdb_append_double(duckdb_appender appender, double value);
+duckdb_state duckdb_append_varchar(duckdb_appender appender, const char *val);
+duckdb_state duckdb_append_varchar_length(duckdb_appender appender, const char *val, idx_t length);
+duckdb_state duckdb_append_null(duckdb_appender appender);
+
+//! Appends count rows at once, where columns contains one array of count values for every column of the table. The
+//! values are converted to the types of the columns if needed. Must not be called in the middle of a row.
+duckdb_state duckdb_appender_append_columns(duckdb_appender appender, duckdb_column_array *columns, idx_t count);
+
+//! Appends all buffered rows to the table
+duckdb_state duckdb_appender_flush(duckdb_appender appender);
+//! Flushes the appender and closes it, after which no more values can be appended
+duckdb_state duckdb_appender_close(duckdb_appender appender);
+//! Closes the appender and destroys it
+duckdb_state duckdb_appender_destroy(duckdb_appender *appender);
+
 #ifdef __cplusplus
 }
 #endif
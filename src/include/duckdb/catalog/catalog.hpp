@@ -11,6 +11,8 @@
 #include "duckdb/catalog/catalog_entry.hpp"
 #include "duckdb/common/mutex.hpp"
 
+#include <atomic>
+
 namespace duckdb {
 struct CreateSchemaInfo;
 struct DropInfo;
@@ -58,6 +60,16 @@ public:
 	//! Get the ClientContext from the Catalog
 	static Catalog &GetCatalog(ClientContext &context);
 
+	//! Returns the version of the catalog, which changes whenever an entry of the catalog is created, altered or
+	//! dropped, or such a change is committed or rolled back
+	idx_t GetCatalogVersion() {
+		return catalog_version;
+	}
+	//! Increments the version of the catalog, invalidating any plans that were created against the previous version
+	void ModifyCatalog() {
+		catalog_version++;
+	}
+
 	//! Creates a schema in the catalog.
 	CatalogEntry *CreateSchema(ClientContext &context, CreateSchemaInfo *info);
 	//! Creates a table in the catalog.
@@ -97,6 +109,9 @@ public:
 	static void ParseRangeVar(string input, string &schema, string &name);
 
 private:
+	//! The version of the catalog
+	std::atomic<idx_t> catalog_version;
+
 	void DropSchema(ClientContext &context, DropInfo *info);
 };
 
@@ -47,6 +47,8 @@ public:
 	//! Rollback <entry> to be the currently valid entry for a certain catalog
 	//! entry
 	void Undo(CatalogEntry *entry);
+	//! Increments the version of the catalog for a change that replaced <entry> by its parent
+	void ModifyCatalog(CatalogEntry &entry);
 
 	//! Scan the catalog set, invoking the callback method for every entry
 	template <class T> void Scan(Transaction &transaction, T &&callback) {
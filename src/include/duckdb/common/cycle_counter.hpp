@@ -0,0 +1,43 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/cycle_counter.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/constants.hpp"
+
+#include <chrono>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DUCKDB_HAS_RDTSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace duckdb {
+
+//! The CycleCounter reads a cheap, monotonically increasing tick counter. On x86 this is the time stamp counter,
+//! on other platforms it falls back to the steady clock (in nanoseconds).
+class CycleCounter {
+public:
+	static inline uint64_t Tick() {
+#ifdef DUCKDB_HAS_RDTSC
+		return __rdtsc();
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		           std::chrono::steady_clock::now().time_since_epoch())
+		    .count();
+#endif
+	}
+
+	//! Returns the amount of ticks per second; the first call calibrates the counter against the steady clock
+	static double TicksPerSecond();
+};
+
+} // namespace duckdb
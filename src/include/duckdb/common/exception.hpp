@@ -71,7 +71,8 @@ enum class ExceptionType {
 	FATAL = 30, // Fatal exception: fatal exceptions are non-recoverable, and render the entire DB in an unusable state
 	INTERNAL =
 	    31, // Internal exception: exception that indicates something went wrong internally (i.e. bug in the code base)
-	INVALID_INPUT = 32 // Input or arguments error
+	INVALID_INPUT = 32, // Input or arguments error
+	OUT_OF_MEMORY = 33  // Memory limit exceeded
 };
 
 enum class ExceptionFormatValueType : uint8_t {
@@ -288,6 +289,15 @@ public:
 	}
 };
 
+class OutOfMemoryException : public Exception {
+public:
+	OutOfMemoryException(string msg);
+
+	template <typename... Args>
+	OutOfMemoryException(string msg, Args... params) : OutOfMemoryException(ConstructMessage(msg, params...)) {
+	}
+};
+
 class CastException : public Exception {
 public:
 	CastException(const PhysicalType origType, const PhysicalType newType);
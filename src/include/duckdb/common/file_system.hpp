@@ -10,6 +10,7 @@
 
 #include "duckdb/common/constants.hpp"
 #include "duckdb/common/file_buffer.hpp"
+#include "duckdb/common/vector.hpp"
 
 #include <functional>
 
@@ -42,6 +43,20 @@ public:
 	string path;
 };
 
+//! A read-only mapping of the contents of a file into memory
+struct MappedFile {
+public:
+	MappedFile(data_ptr_t data, idx_t size) : data(data), size(size) {
+	}
+	MappedFile(const MappedFile &) = delete;
+	~MappedFile();
+
+	//! The contents of the file
+	data_ptr_t data;
+	//! The size of the mapping in bytes
+	idx_t size;
+};
+
 enum class FileLockType : uint8_t { NO_LOCK = 0, READ_LOCK = 1, WRITE_LOCK = 2 };
 
 class FileFlags {
@@ -72,8 +87,8 @@ public:
 	unique_ptr<FileHandle> OpenFile(string &path, uint8_t flags, FileLockType lock = FileLockType::NO_LOCK) {
 		return OpenFile(path.c_str(), flags, lock);
 	}
-	//! Read exactly nr_bytes from the specified location in the file. Fails if nr_bytes could not be read. This is
-	//! equivalent to calling SetFilePointer(location) followed by calling Read().
+	//! Read exactly nr_bytes from the specified location in the file. Fails if nr_bytes could not be read. Where
+	//! supported this is a positional read that does not move the file pointer.
 	virtual void Read(FileHandle &handle, void *buffer, int64_t nr_bytes, idx_t location);
 	//! Write exactly nr_bytes to the specified location in the file. Fails if nr_bytes could not be read. This is
 	//! equivalent to calling SetFilePointer(location) followed by calling Write().
@@ -86,6 +101,9 @@ public:
 
 	//! Returns the file size of a file handle, returns -1 on error
 	virtual int64_t GetFileSize(FileHandle &handle);
+	//! Map the contents of a file opened for reading into memory, so it can be read directly from the page cache.
+	//! Returns nullptr if the file cannot be mapped (e.g. because it is empty); it has to be read with Read instead.
+	virtual unique_ptr<MappedFile> MapFile(FileHandle &handle);
 	//! Truncate a file to a maximum size of new_size, new_size should be smaller than or equal to the current size of
 	//! the file
 	virtual void Truncate(FileHandle &handle, int64_t new_size);
@@ -109,6 +127,11 @@ public:
 	virtual string PathSeparator();
 	//! Join two paths together
 	virtual string JoinPath(const string &a, const string &path);
+	//! Returns the sorted list of files matching the glob pattern; the wildcards *, ? and [...] can be used in every
+	//! component of the path. Returns an empty list if no file matches.
+	virtual vector<string> Glob(const string &pattern);
+	//! Whether or not the path contains any glob wildcards
+	static bool HasGlob(const string &str);
 	//! Sync a file handle to disk
 	virtual void FileSync(FileHandle &handle);
 
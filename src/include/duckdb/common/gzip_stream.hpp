@@ -9,35 +9,69 @@
 #pragma once
 
 #include "duckdb/common/constants.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/thread.hpp"
 
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <sstream>
 
 namespace duckdb {
 
+//! A block of decompressed data
+struct GzipBlock {
+	unique_ptr<data_t[]> data;
+	idx_t size = 0;
+};
+
+//! GzipStreamBuf reads a GZIP file that consists of one or more members. The file is decompressed in a background
+//! thread, so that decompression and the consumer of the stream (e.g. the CSV parser) run concurrently.
 class GzipStreamBuf : public std::streambuf {
 public:
 	GzipStreamBuf(std::string filename) : filename(filename) {
 	}
 
 	GzipStreamBuf(const GzipStreamBuf &) = delete;
-	GzipStreamBuf(GzipStreamBuf &&) = default;
 	GzipStreamBuf &operator=(const GzipStreamBuf &) = delete;
-	GzipStreamBuf &operator=(GzipStreamBuf &&) = default;
 
 	~GzipStreamBuf();
 
 	std::streambuf::int_type underflow() override;
 
+	//! The size of the blocks of decompressed data that are handed to the consumer
+	static constexpr idx_t BLOCK_SIZE = 262144;
+	//! The maximum amount of decompressed blocks that are buffered ahead of the consumer
+	static constexpr idx_t MAX_QUEUED_BLOCKS = 4;
+
 private:
+	//! Starts the background thread that decompresses the file
 	void initialize();
-	std::fstream input;
-	idx_t data_start = 0;
-	void *mz_stream_ptr = nullptr; // void* so we don't have to include the header
-	data_ptr_t in_buff = nullptr, in_buff_start, in_buff_end, out_buff = nullptr; // various buffers & pointers
-	bool is_initialized = false;
+	//! Decompresses the file, runs in the background thread
+	void Decompress();
+	//! Inflates all members of the file, returns early if the stream is destroyed
+	void InflateMembers(std::fstream &input);
+	//! Hands a block of decompressed data to the consumer, waiting while too many blocks are queued. Returns false if
+	//! the stream was destroyed in the meantime.
+	bool PushBlock(GzipBlock block);
+
 	std::string filename;
-	idx_t BUFFER_SIZE = 1024;
+	bool is_initialized = false;
+	//! The thread that decompresses the file
+	unique_ptr<thread> decompress_thread;
+	//! Lock and condition variable protecting the shared state below
+	mutex lock;
+	std::condition_variable cv;
+	//! Decompressed blocks that have not been read yet
+	std::deque<GzipBlock> blocks;
+	//! Whether or not the background thread has finished
+	bool finished = false;
+	//! Whether or not the stream is being destroyed
+	bool cancelled = false;
+	//! The error that occurred while decompressing the file (if any)
+	std::string error;
+	//! The block that is currently being read
+	GzipBlock current_block;
 };
 
 class GzipStream : public std::istream {
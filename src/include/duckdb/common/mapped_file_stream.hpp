@@ -0,0 +1,43 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/mapped_file_stream.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/file_system.hpp"
+
+#include <istream>
+
+namespace duckdb {
+
+//! Stream buffer that reads directly from a memory mapped file, without an intermediate buffer or system calls
+class MappedFileStreamBuf : public std::streambuf {
+public:
+	MappedFileStreamBuf(unique_ptr<MappedFile> mapping);
+
+	MappedFileStreamBuf(const MappedFileStreamBuf &) = delete;
+	MappedFileStreamBuf &operator=(const MappedFileStreamBuf &) = delete;
+
+protected:
+	pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+	pos_type seekpos(pos_type position, std::ios_base::openmode which) override;
+
+private:
+	unique_ptr<MappedFile> mapping;
+};
+
+class MappedFileStream : public std::istream {
+public:
+	MappedFileStream(unique_ptr<MappedFile> mapping) : std::istream(nullptr), buffer(std::move(mapping)) {
+		rdbuf(&buffer);
+	}
+
+private:
+	MappedFileStreamBuf buffer;
+};
+
+} // namespace duckdb
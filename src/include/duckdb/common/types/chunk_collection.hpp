@@ -23,7 +23,7 @@ namespace duckdb {
 */
 class ChunkCollection {
 public:
-	ChunkCollection() : count(0) {
+	ChunkCollection() : count(0), string_heap_size(0) {
 	}
 
 	//! The total amount of elements in the collection
@@ -44,6 +44,18 @@ public:
 	//! Append another ChunkCollection directly to this ChunkCollection
 	void Append(ChunkCollection &other);
 
+	//! Removes all chunks from the ChunkCollection
+	void Reset() {
+		count = 0;
+		chunks.clear();
+		types.clear();
+		string_heap_size = 0;
+	}
+
+	//! Returns an estimate of the amount of memory used by the collection in bytes, including the data of non-inlined
+	//! strings
+	idx_t MemoryUsage();
+
 	void Verify();
 
 	//! Gets the value of the column at the specified index
@@ -82,5 +94,13 @@ public:
 
 	void Heap(vector<OrderType> &desc, vector<OrderByNullType> &null_order, idx_t heap[], idx_t heap_size);
 	idx_t MaterializeHeapChunk(DataChunk &target, idx_t order[], idx_t start_offset, idx_t heap_size);
+
+private:
+	//! Returns the amount of memory allocated by the string heaps of the chunk in bytes
+	static idx_t StringHeapSize(DataChunk &chunk);
+
+	//! The amount of memory allocated by the string heaps of all chunks except the last one. Non-inlined strings are
+	//! copied into these heaps when they are appended.
+	idx_t string_heap_size;
 };
 } // namespace duckdb
@@ -0,0 +1,40 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/types/hyperloglog.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+
+namespace duckdb {
+
+//! The HyperLogLog is a fixed-size sketch that estimates the amount of distinct hashes added to it. Two sketches can
+//! be merged, which makes it usable for parallel (partial) aggregation. With 2^14 registers the standard error of the
+//! estimate is roughly 0.8%.
+class HyperLogLog {
+public:
+	//! The amount of bits of the hash that are used to select a register
+	static constexpr idx_t PRECISION = 14;
+	//! The amount of registers of the sketch
+	static constexpr idx_t REGISTER_COUNT = idx_t(1) << PRECISION;
+	//! The amount of hash bits that are used to compute the rank
+	static constexpr idx_t RANK_BITS = 64 - PRECISION;
+
+	HyperLogLog();
+
+	//! Adds a hash value to the sketch
+	void Add(hash_t hash);
+	//! Merges another sketch into this sketch
+	void Merge(const HyperLogLog &other);
+	//! Returns the estimated amount of distinct hashes that have been added to the sketch
+	idx_t Count() const;
+
+private:
+	uint8_t registers[REGISTER_COUNT];
+};
+
+} // namespace duckdb
@@ -22,13 +22,21 @@ public:
 	void Destroy() {
 		tail = nullptr;
 		chunk = nullptr;
+		allocated_size = 0;
 	}
 
 	void Move(StringHeap &other) {
 		assert(!other.chunk);
 		other.tail = tail;
 		other.chunk = move(chunk);
+		other.allocated_size = allocated_size;
 		tail = nullptr;
+		allocated_size = 0;
+	}
+
+	//! Returns the amount of memory allocated by the string heap in bytes
+	idx_t AllocatedSize() const {
+		return allocated_size;
 	}
 
 	//! Add a string to the string heap, returns a pointer to the string
@@ -67,6 +75,8 @@ private:
 	};
 	StringChunk *tail;
 	unique_ptr<StringChunk> chunk;
+	//! The total size of all string chunks
+	idx_t allocated_size;
 };
 
 } // namespace duckdb
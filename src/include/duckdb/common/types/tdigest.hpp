@@ -0,0 +1,64 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/common/types/tdigest.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/vector.hpp"
+
+namespace duckdb {
+
+//! The TDigest is a compact sketch for estimating quantiles of a stream of values (see Dunning & Ertl, "Computing
+//! extremely accurate quantiles using t-digests"). Values are summarized as a bounded set of weighted centroids that
+//! are small near the tails of the distribution, which makes extreme quantiles very accurate. Two digests can be
+//! merged, which makes the sketch usable for parallel and windowed aggregation.
+class TDigest {
+public:
+	//! The default compression; the digest keeps at most ~compression centroids
+	static constexpr double DEFAULT_COMPRESSION = 100;
+
+	TDigest(double compression = DEFAULT_COMPRESSION);
+
+	//! Adds a value to the digest
+	void Add(double value, double weight = 1);
+	//! Merges another digest into this digest
+	void Merge(const TDigest &other);
+	//! Returns the estimated value at the given quantile (between 0 and 1). The digest must not be empty.
+	double Quantile(double quantile);
+
+	//! Returns the total weight of the values added to the digest
+	double TotalWeight() const {
+		return total_weight;
+	}
+
+private:
+	struct Centroid {
+		Centroid(double mean, double weight) : mean(mean), weight(weight) {
+		}
+
+		double mean;
+		double weight;
+	};
+
+	//! Merges the unmerged values into the centroids
+	void Compress();
+
+	//! The compression of the digest
+	double compression;
+	//! The merged centroids, sorted by mean
+	vector<Centroid> centroids;
+	//! Values (or centroids of other digests) that have not been merged yet
+	vector<Centroid> unmerged;
+	//! The total weight of both the merged and the unmerged centroids
+	double total_weight;
+	//! The minimum and maximum value added to the digest
+	double min;
+	double max;
+};
+
+} // namespace duckdb
@@ -244,6 +244,9 @@ struct StringVector {
 
 	//! Add a reference from this vector to the string heap of the provided vector
 	static void AddHeapReference(Vector &vector, Vector &other);
+	//! Returns the amount of memory allocated by the string heap of the vector in bytes, excluding the heaps of other
+	//! vectors it references
+	static idx_t HeapSize(Vector &vector);
 };
 
 struct StructVector {
@@ -94,6 +94,11 @@ public:
 		references.push_back(move(heap));
 	}
 
+	//! Returns the amount of memory allocated by the string heap of this buffer in bytes
+	idx_t AllocatedSize() const {
+		return heap.AllocatedSize();
+	}
+
 private:
 	//! The string heap of this buffer
 	StringHeap heap;
@@ -16,6 +16,7 @@
 
 namespace duckdb {
 class BoundAggregateExpression;
+class BufferedChunkCollection;
 
 struct AggregateObject {
 	AggregateObject(AggregateFunction function, idx_t child_count, idx_t payload_size, bool distinct,
@@ -33,6 +34,16 @@ struct AggregateObject {
 	static vector<AggregateObject> CreateAggregateObjects(vector<BoundAggregateExpression *> bindings);
 };
 
+//! An entry in the pointer array of the aggregate HT
+struct aggr_ht_entry_t {
+	//! The salt of the hash of the group, compared before the groups themselves are compared
+	uint16_t salt;
+	//! The offset of the row within its row block
+	uint16_t block_offset;
+	//! The index of the row block plus one, zero marks an empty entry
+	uint32_t block_nr;
+};
+
 //! SuperLargeHashTable is a linear probing HT that is used for computing
 //! aggregates
 /*!
@@ -40,6 +51,11 @@ struct AggregateObject {
    as input the set of groups and the types of the aggregates to compute and
    stores them in the HT. It uses linear probing for collision resolution, and
    supports both parallel and sequential modes.
+
+   The rows of the HT ([HASH][GROUPS][PAYLOAD]) are appended to fixed-size row
+   blocks and never move. The linear probing happens on a compact array of
+   (salt, location) entries that point into the row blocks, so resizing the HT
+   only requires rebuilding that array from the stored hashes.
 */
 class SuperLargeHashTable {
 public:
@@ -56,6 +72,11 @@ public:
 	//! data in the group chunk. When resize = true, aggregates will not be
 	//! computed but instead just assigned.
 	void AddChunk(DataChunk &groups, DataChunk &payload);
+	//! Add the given data to the HT, only updating the aggregates for which the filter is set
+	void AddChunk(DataChunk &groups, DataChunk &payload, const vector<bool> &aggregate_filter);
+	//! Update only the aggregate at the given index with the given input for the specified groups, ignoring any
+	//! DISTINCT modifier of the aggregate.
+	void UpdateAggregate(DataChunk &groups, idx_t aggr_idx, DataChunk &input);
 	//! Scan the HT starting from the scan_position until the result and group
 	//! chunks are filled. scan_position will be updated by this function.
 	//! Returns the amount of elements found.
@@ -70,11 +91,36 @@ public:
 	idx_t FindOrCreateGroups(DataChunk &groups, Vector &addresses, SelectionVector &new_groups);
 	void FindOrCreateGroups(DataChunk &groups, Vector &addresses);
 
+	//! Returns the amount of groups stored in the HT
+	idx_t Size() {
+		return entries;
+	}
+	//! Returns the amount of memory used by the HT in bytes, including its string heap and distinct tables
+	idx_t MemoryUsage();
+	//! Returns the amount of memory used by the HT after it grows while adding the next chunk of groups, i.e. after
+	//! resizing its pointer array and allocating a new row block
+	idx_t GrowthMemoryUsage();
+
+	//! Moves all groups of the HT together with their aggregate states into radix partitions on the hash of the
+	//! groups, after which the HT is empty again. The partitions hold the group columns followed by a BLOB column
+	//! with the raw aggregate states. Not supported for HTs with DISTINCT aggregates. Only the fixed-size states are
+	//! spilled: memory the states point to (e.g. non-inlined strings, string_agg buffers or sketches) stays on the
+	//! heap and is not counted against the memory limit of the query.
+	void Spill(vector<unique_ptr<BufferedChunkCollection>> &partitions, idx_t radix_bits);
+	//! Combines the groups and aggregate states of a spilled partition into the HT, consuming the spilled states
+	void CombinePartition(BufferedChunkCollection &partition);
+	//! Calls the destructors of the aggregate states of a spilled partition that is not going to be combined
+	void DestroyPartition(BufferedChunkCollection &partition);
+	//! Combines the groups and aggregate states of another HT with the same layout into this HT. The states of the
+	//! other HT are left as they are and are destroyed together with it.
+	void Combine(SuperLargeHashTable &other);
+	//! Removes all groups from the HT, keeping the pointer array and the first row block allocated for reuse
+	void Clear();
+
 	//! The stringheap of the AggregateHashTable
 	StringHeap string_heap;
 
 private:
-	void HashGroups(DataChunk &groups, Vector &addresses);
 
 	//! The aggregates to be computed
 	vector<AggregateObject> aggregates;
@@ -88,15 +134,20 @@ private:
 	idx_t payload_width;
 	//! The total tuple size
 	idx_t tuple_size;
+	//! The amount of tuples that fit in a row block
+	idx_t tuples_per_block;
 	//! The capacity of the HT. This can be increased using
 	//! SuperLargeHashTable::Resize
 	idx_t capacity;
 	//! The amount of entries stored in the HT currently
 	idx_t entries;
-	//! The data of the HT
-	data_ptr_t data;
-	//! The endptr of the hashtable
-	data_ptr_t endptr;
+	//! The pointer array of the HT, holding "capacity" entries
+	unique_ptr<aggr_ht_entry_t[]> ht_entries;
+	//! The row blocks holding the groups and aggregate states, the rows are stored in order of insertion
+	vector<unique_ptr<data_t[]>> row_blocks;
+	//! The amount of rows the first row block has room for. The first block starts small and grows geometrically up to
+	//! tuples_per_block, so that small HTs (e.g. the per-thread distinct sets) do not allocate a full block.
+	idx_t first_block_capacity;
 	//! Whether or not the HT has to support parallel insertion operations
 	bool parallel = false;
 	//! The empty payload data
@@ -106,21 +157,30 @@ private:
 
 	vector<unique_ptr<SuperLargeHashTable>> distinct_hashes;
 
-	//! The size of the initial flag for each cell
-	static constexpr int FLAG_SIZE = sizeof(uint8_t);
-	//! Flag indicating a cell is empty
-	static constexpr int EMPTY_CELL = 0x00;
-	//! Flag indicating a cell is full
-	static constexpr int FULL_CELL = 0xFF;
+	//! The size of the hash stored in front of each row
+	static constexpr idx_t HASH_WIDTH = sizeof(hash_t);
 
 	SuperLargeHashTable(const SuperLargeHashTable &) = delete;
 
-	//! unique_ptr to indicate the ownership
-	unique_ptr<data_t[]> owned_data;
-
 private:
 	void Destroy();
+	//! Returns a pointer to the row the given entry points to
+	data_ptr_t GetRow(aggr_ht_entry_t &entry);
+	//! Grows the first row block so that it can hold the given amount of additional rows (up to a full block). Moves
+	//! the rows of the first block, so it may not be called while pointers to rows are in use.
+	void ReserveRows(idx_t count);
+	//! Appends a new row with the given hash and an empty payload to the row blocks and points the entry to it
+	data_ptr_t CreateRow(aggr_ht_entry_t &entry, hash_t hash, uint16_t salt);
+	//! Fetches pointers to the groups of the rows starting at the given row position, returns the amount of rows
+	//! fetched. The position is moved past the fetched rows.
+	idx_t FetchRowPointers(idx_t &position, data_ptr_t pointers[]);
 	void CallDestructors(Vector &state_vector, idx_t count);
+	bool HasDestructors();
+	//! Copies the spilled aggregate states in the BLOB column of a partition chunk into the state buffer, which holds
+	//! STANDARD_VECTOR_SIZE states of SpilledStateWidth() bytes, and points the state vector to the copies
+	void GetSpilledStates(DataChunk &spilled, data_ptr_t state_buffer, Vector &state_vector);
+	//! The width of a spilled aggregate state in the state buffer, rounded up so that every state is 8-byte aligned
+	idx_t SpilledStateWidth();
 	void ScatterGroups(DataChunk &groups, unique_ptr<VectorData[]> &group_data, Vector &addresses,
 	                   const SelectionVector &sel, idx_t count);
 };
@@ -0,0 +1,113 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/execution/buffered_chunk_collection.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
+#include "duckdb/storage/buffer/buffer_handle.hpp"
+
+namespace duckdb {
+class BufferManager;
+
+//! A BufferedChunkCollection is a set of DataChunks that is stored in blocks allocated through the BufferManager.
+//! Unpinned blocks can be evicted to the temporary directory, so the collection can grow beyond the memory limit.
+//! Appended rows are gathered in an in-memory tail chunk; once it is full, it is serialized column-wise into a block.
+//! Like in the ChunkCollection, every chunk except the last one holds exactly STANDARD_VECTOR_SIZE rows.
+//! Collections with nested types (LIST/STRUCT) cannot be serialized and are kept in memory instead.
+class BufferedChunkCollection {
+public:
+	BufferedChunkCollection(BufferManager &buffer_manager, vector<LogicalType> types);
+	~BufferedChunkCollection();
+
+	//! Append a DataChunk to the collection. The chunk is normalified in place.
+	void Append(DataChunk &chunk);
+	//! Fetch the chunk at the given index into the target chunk, which must be initialized with the types of the
+	//! collection
+	void FetchChunk(idx_t chunk_index, DataChunk &target);
+	//! Fetch only the given columns of the chunk at the given index into the target chunk, which must be initialized
+	//! with the types of the collection. The other columns of the target are left empty; column ids that do not refer
+	//! to a column of the collection (e.g. the row id) are ignored.
+	void FetchChunk(idx_t chunk_index, DataChunk &target, const vector<column_t> &column_ids);
+	//! Overwrite the chunk at the given index with the (equally sized) source chunk. If the chunk no longer fits in
+	//! its original location it is moved, and the blocks are compacted once too much of their space is unused.
+	void ReplaceChunk(idx_t chunk_index, DataChunk &source);
+	//! Removes all chunks from the collection and releases its blocks
+	void Reset();
+	//! Exchanges the contents of this collection with the contents of another collection of the same types
+	void Swap(BufferedChunkCollection &other);
+
+	//! The types of the collection
+	vector<LogicalType> &Types() {
+		return types;
+	}
+	//! The total amount of rows in the collection
+	idx_t Count() {
+		return count;
+	}
+	//! The amount of chunks in the collection
+	idx_t ChunkCount() {
+		if (in_memory) {
+			return in_memory->chunks.size();
+		}
+		return chunks.size() + (tail.size() > 0 ? 1 : 0);
+	}
+	//! Returns the amount of memory the collection holds outside of its blocks, i.e. the tail chunk (or the in-memory
+	//! fallback). Unlike the blocks, this memory cannot be evicted.
+	idx_t MemoryUsage();
+
+	//! Whether or not the given types can be stored in buffer-managed blocks
+	static bool TypesAreSupported(const vector<LogicalType> &types);
+
+private:
+	//! The location of a serialized chunk
+	struct ChunkEntry {
+		idx_t block_index;
+		idx_t offset;
+		//! The amount of bytes reserved for the chunk
+		idx_t size;
+		idx_t count;
+	};
+	//! A block allocated through the buffer manager
+	struct BlockEntry {
+		block_id_t block_id;
+		idx_t capacity;
+		idx_t size;
+	};
+
+	//! Computes the amount of bytes required to serialize the given chunk
+	idx_t SerializedSize(DataChunk &chunk, VectorData data[]);
+	//! Returns a pointer to a (pinned) region of the given size to serialize a chunk into
+	data_ptr_t AllocateSpace(idx_t size, ChunkEntry &entry);
+	//! Serialize a chunk into the given region
+	void WriteChunk(DataChunk &chunk, VectorData data[], data_ptr_t target);
+	//! Serialize the tail chunk into a block and start a new tail chunk
+	void FlushTail();
+	//! Deserialize the chunk at the given index, only deserializing the columns for which the projection is set (or
+	//! all columns if the projection is empty)
+	void ReadChunk(idx_t chunk_index, DataChunk &target, const vector<bool> &projection);
+	//! Moves all serialized chunks into new blocks, releasing the space of chunks that were moved by ReplaceChunk
+	void Compact();
+
+	BufferManager &buffer_manager;
+	vector<LogicalType> types;
+	idx_t count;
+	vector<ChunkEntry> chunks;
+	vector<BlockEntry> blocks;
+	//! The amount of bytes in the blocks that is no longer used by any chunk
+	idx_t unused_bytes;
+	//! The last, not yet full, chunk of the collection
+	DataChunk tail;
+	//! The handle of the block that is currently being appended to
+	unique_ptr<BufferHandle> append_handle;
+	//! The in-memory fallback for collections with types that cannot be serialized
+	unique_ptr<ChunkCollection> in_memory;
+};
+
+} // namespace duckdb
@@ -36,7 +36,8 @@ public:
 	ClientContext &context;
 
 public:
-	void Initialize(unique_ptr<PhysicalOperator> physical_plan);
+	//! Execute the plan of a query. The plan is not owned by the executor, and has to be kept alive until Reset().
+	void Initialize(PhysicalOperator *physical_plan);
 	void BuildPipelines(PhysicalOperator *op, Pipeline *parent);
 
 	void Reset();
@@ -52,8 +53,10 @@ public:
 	void Flush(ThreadContext &context);
 
 private:
-	unique_ptr<PhysicalOperator> physical_plan;
+	PhysicalOperator *physical_plan;
 	unique_ptr<PhysicalOperatorState> physical_state;
+	//! The thread context used to fetch the result chunks of the query
+	unique_ptr<ThreadContext> result_thread;
 
 	mutex executor_lock;
 	//! The pipelines of the current query
@@ -137,6 +137,8 @@ public:
 	idx_t size() {
 		return count;
 	}
+	//! Returns the amount of memory used by the data blocks and the hash map of the HT in bytes
+	idx_t MemoryUsage();
 
 	//! The stringheap of the JoinHashTable
 	StringHeap string_heap;
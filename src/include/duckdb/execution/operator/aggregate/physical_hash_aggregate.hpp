@@ -32,6 +32,13 @@ public:
 	bool is_implicit_aggr;
 	//! Whether or not all aggregates are combinable
 	bool all_combinable;
+	//! Whether or not the input of the DISTINCT aggregates is deduplicated in parallel into radix-partitioned distinct
+	//! sets, after which only the distinct values are aggregated in the Finalize. The other aggregates are computed in
+	//! thread-local HTs that are combined, which requires all aggregates to be combinable.
+	bool partition_distinct;
+	//! Whether or not the aggregate HT can be spilled to disk in radix partitions once it no longer fits in memory.
+	//! This requires all aggregates to be combinable and none of them to be DISTINCT.
+	bool can_spill;
 
 	//! The group types
 	vector<LogicalType> group_types;
@@ -45,6 +52,8 @@ public:
 
 public:
 	void Sink(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate, DataChunk &input) override;
+	void Combine(ExecutionContext &context, GlobalOperatorState &state, LocalSinkState &lstate) override;
+	void Finalize(ClientContext &context, unique_ptr<GlobalOperatorState> gstate) override;
 
 	unique_ptr<LocalSinkState> GetLocalSinkState(ExecutionContext &context) override;
 	unique_ptr<GlobalOperatorState> GetGlobalState(ClientContext &context) override;
@@ -12,6 +12,7 @@
 #include "duckdb/execution/physical_operator.hpp"
 
 namespace duckdb {
+class BufferedChunkCollection;
 
 //! The PhysicalChunkCollectionScan scans a Chunk Collection
 class PhysicalChunkScan : public PhysicalOperator {
@@ -28,6 +29,8 @@ public:
 	ChunkCollection *collection;
 	//! Owned chunk collection, if any
 	unique_ptr<ChunkCollection> owned_collection;
+	//! The buffer-managed chunk collection to scan instead of the chunk collection (if any)
+	BufferedChunkCollection *buffered_collection = nullptr;
 };
 
 } // namespace duckdb
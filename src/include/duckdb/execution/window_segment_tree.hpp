@@ -17,6 +17,8 @@ namespace duckdb {
 class WindowSegmentTree {
 public:
 	WindowSegmentTree(AggregateFunction &aggregate, LogicalType result_type, ChunkCollection *input);
+	~WindowSegmentTree();
+
 	Value Compute(idx_t start, idx_t end);
 
 private:
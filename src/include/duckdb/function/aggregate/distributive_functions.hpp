@@ -14,6 +14,10 @@
 
 namespace duckdb {
 
+struct ApproxCountDistinctFun {
+	static void RegisterFunction(BuiltinFunctions &set);
+};
+
 struct BitAndFun {
 	static void RegisterFunction(BuiltinFunctions &set);
 };
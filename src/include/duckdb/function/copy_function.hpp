@@ -17,6 +17,9 @@ class ExecutionContext;
 struct LocalFunctionData {
 	virtual ~LocalFunctionData() {
 	}
+
+	//! The batch of the input that is sunk into this local state (see TaskContext::batch_index)
+	idx_t batch_index = 0;
 };
 
 struct GlobalFunctionData {
@@ -52,6 +55,8 @@ public:
 	copy_to_initialize_local_t copy_to_initialize_local;
 	copy_to_initialize_global_t copy_to_initialize_global;
 	copy_to_sink_t copy_to_sink;
+	//! Finishes the output of a local state. Copy functions with a combine are sunk into in parallel: they have to
+	//! write the output of the local states in the order of their batch index.
 	copy_to_combine_t copy_to_combine;
 	copy_to_finalize_t copy_to_finalize;
 
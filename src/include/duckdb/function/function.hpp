@@ -172,6 +172,7 @@ private:
 	// aggregates
 	void RegisterAlgebraicAggregates();
 	void RegisterDistributiveAggregates();
+	void RegisterHolisticAggregates();
 	void RegisterNestedAggregates();
 
 	// scalar functions
@@ -56,6 +56,10 @@ public:
 		AppendRowRecursive(args...);
 	}
 
+	//! Append a chunk with the types of the table at once. Rows that are still buffered in the appender are flushed
+	//! first, so the chunk cannot be appended in the middle of a row.
+	void AppendChunk(DataChunk &input);
+
 	//! Commit the changes made by the appender.
 	void Flush();
 	//! Flush the changes made by the appender and close it. The appender cannot be used after this point
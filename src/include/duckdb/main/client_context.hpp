@@ -13,18 +13,19 @@
 #include "duckdb/common/unordered_set.hpp"
 #include "duckdb/execution/executor.hpp"
 #include "duckdb/main/prepared_statement.hpp"
+#include "duckdb/main/prepared_statement_data.hpp"
 #include "duckdb/main/query_profiler.hpp"
 #include "duckdb/main/stream_query_result.hpp"
 #include "duckdb/main/table_description.hpp"
 #include "duckdb/transaction/transaction_context.hpp"
 
+#include <atomic>
 #include <random>
 
 namespace duckdb {
 class Appender;
 class Catalog;
 class DuckDB;
-class PreparedStatementData;
 class Relation;
 class BufferedFileWriter;
 
@@ -42,6 +43,10 @@ public:
 	TransactionContext transaction;
 	//! Whether or not the query is interrupted
 	bool interrupted;
+	//! The maximum amount of memory that operators of a single query can reserve (in bytes)
+	idx_t query_memory_limit = (idx_t)-1;
+	//! The amount of memory currently reserved by the operators of the running query (in bytes)
+	std::atomic<idx_t> query_memory_usage;
 	//! Whether or not the ClientContext has been invalidated because the underlying database is destroyed
 	bool is_invalidated = false;
 	//! Lock on using the ClientContext in parallel
@@ -62,6 +67,8 @@ public:
 	bool enable_optimizer = true;
 	//! Force parallelism of small tables, used for testing
 	bool force_parallelism = false;
+	//! Whether or not temporary objects have been created in this connection
+	bool has_temporary_objects = false;
 	//! Output only the logical_opt explain output, used for optimization verification
 	bool explain_output_optimized_only = false;
 	//! The writer used to log queries (if logging is enabled)
@@ -88,8 +95,10 @@ public:
 	unique_ptr<QueryResult> Query(string query, bool allow_stream_result);
 	//! Fetch a query from the current result set (if any)
 	unique_ptr<DataChunk> Fetch();
-	//! Cleanup the result set (if any).
+	//! Cleanup the connection: closes the result set (if any) and invalidates the prepared statements and appenders
 	void Cleanup();
+	//! Close the result set (if any), finalizing its query
+	void CleanupResult();
 	//! Invalidate the client context. The current query will be interrupted and the client context will be invalidated,
 	//! making it impossible for future queries to run.
 	void Invalidate();
@@ -144,21 +153,34 @@ private:
 	                                      bool allow_stream_result);
 	//! Internally prepare and execute a prepared SQL statement. Caller must hold the context_lock.
 	unique_ptr<QueryResult> RunStatement(const string &query, unique_ptr<SQLStatement> statement,
-	                                     bool allow_stream_result);
+	                                     bool allow_stream_result, bool use_plan_cache = false,
+	                                     unique_ptr<PreparedStatementData> cached_plan = nullptr);
 
 	//! Internally prepare a SQL statement. Caller must hold the context_lock.
 	unique_ptr<PreparedStatementData> CreatePreparedStatement(const string &query, unique_ptr<SQLStatement> statement);
-	//! Internally execute a prepared SQL statement. Caller must hold the context_lock.
-	unique_ptr<QueryResult> ExecutePreparedStatement(const string &query, PreparedStatementData &statement,
+	//! Internally execute a prepared SQL statement. The prepared statement is kept alive until the query is
+	//! finalized. Caller must hold the context_lock.
+	unique_ptr<QueryResult> ExecutePreparedStatement(const string &query, unique_ptr<PreparedStatementData> prepared,
 	                                                 vector<Value> bound_values, bool allow_stream_result);
-	//! Call CreatePreparedStatement() and ExecutePreparedStatement() without any bound values
+	//! Call CreatePreparedStatement() and ExecutePreparedStatement() without any bound values. If use_plan_cache is
+	//! set, the plan is added to the plan cache after the query has finished. The cached_plan is executed instead
+	//! of the statement if it is valid for the current transaction.
 	unique_ptr<QueryResult> RunStatementInternal(const string &query, unique_ptr<SQLStatement> statement,
-	                                             bool allow_stream_result);
+	                                             bool allow_stream_result, bool use_plan_cache = false,
+	                                             unique_ptr<PreparedStatementData> cached_plan = nullptr);
+
+	//! Whether or not the plans of this connection can be shared with other connections through the plan cache
+	bool UsePlanCache();
+	//! Prepare the query using a plan from the plan cache, returns nullptr if there is no valid cached plan. Caller
+	//! must hold the context_lock.
+	unique_ptr<PreparedStatement> PrepareCachedPlan(const string &query);
 
 private:
 	idx_t prepare_count = 0;
 	//! The currently opened StreamQueryResult (if any)
 	StreamQueryResult *open_result = nullptr;
+	//! The prepared statement of the running query, which owns the plan that the executor executes
+	unique_ptr<PreparedStatementData> running_statement;
 	//! Prepared statement objects that were created using the ClientContext::Prepare method
 	unordered_set<PreparedStatement *> prepared_statement_objects;
 	//! Appenders that were attached to this client context
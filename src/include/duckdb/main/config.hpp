@@ -48,6 +48,8 @@ public:
 	OrderByNullType default_null_order = OrderByNullType::NULLS_FIRST;
 	//! enable COPY and related commands
 	bool enable_copy = true;
+	//! The maximum amount of plans kept in the database-wide plan cache (0 disables the cache)
+	idx_t plan_cache_size = 256;
 
 public:
 	static DBConfig &GetConfig(ClientContext &context);
@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/main/plan_cache.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+#include <list>
+#include <mutex>
+
+namespace duckdb {
+class Catalog;
+class LogicalOperator;
+class PreparedStatementData;
+
+//! The PlanCache is a database-wide cache of the physical plans of SELECT statements, indexed by their query string.
+//! It is shared by all connections, so that queries that are issued repeatedly do not have to be parsed, bound,
+//! optimized and planned again. A cached plan is only valid for the version of the catalog it was created against.
+//! Because the parameters of a plan are bound in place, a plan is executed by a single query at a time: it is
+//! removed from the cache by Lookup() and returned to the cache by Insert() when the query has finished.
+class PlanCache {
+	struct CachedPlan {
+		unique_ptr<PreparedStatementData> plan;
+		//! The position of the query in the LRU list
+		std::list<string>::iterator lru_position;
+	};
+
+public:
+	PlanCache(Catalog &catalog, idx_t capacity);
+	~PlanCache();
+
+	//! Removes the plan of the query from the cache and returns it, or returns nullptr if there is no plan of the
+	//! query that was created against the current version of the catalog
+	unique_ptr<PreparedStatementData> Lookup(const string &query);
+	//! Adds the plan of the query to the cache, evicting the least recently used plan if the cache is full. The plan
+	//! is discarded if the catalog has changed since it was created, or if the cache already holds a plan of the query.
+	void Insert(const string &query, unique_ptr<PreparedStatementData> plan);
+
+	//! Returns whether or not the physical plan of the logical plan can be shared between connections and executions.
+	//! Plans that call functions with side effects or scan table functions other than base tables cannot be cached, as
+	//! they refer to the connection that bound them or to state that is only read when planning. The check is done
+	//! both before and after optimizing, because the optimizer folds functions that read the current time and
+	//! introduces index scans.
+	static bool CanCache(LogicalOperator &plan);
+
+private:
+	Catalog &catalog;
+	std::mutex cache_lock;
+	//! The maximum amount of plans in the cache
+	idx_t capacity;
+	//! The cached plans
+	unordered_map<string, CachedPlan> plans;
+	//! The queries of the cached plans, from most recently to least recently used
+	std::list<string> lru;
+};
+
+} // namespace duckdb
@@ -40,6 +40,10 @@ public:
 	//! Whether or not the statement requires a valid transaction. Almost all statements require this, with the
 	//! exception of
 	bool requires_valid_transaction;
+	//! The version of the catalog the statement was planned against
+	idx_t catalog_version;
+	//! Whether or not the plan can be shared with other connections and executions through the plan cache
+	bool cacheable;
 
 public:
 	//! Bind a set of values to the prepared statement data
@@ -9,49 +9,136 @@
 #pragma once
 
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/cycle_counter.hpp"
 #include "duckdb/common/profiler.hpp"
 #include "duckdb/common/string_util.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/unordered_map.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/enums/profiler_format.hpp"
 #include "duckdb/execution/physical_operator.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
 
 #include <stack>
 #include <unordered_map>
 
 namespace duckdb {
+class ClientContext;
 class PhysicalOperator;
 class SQLStatement;
 
 struct OperatorTimingInformation {
 	double time = 0;
 	idx_t elements = 0;
+	//! The amount of entries in the hash table built by the operator (if any)
+	idx_t hash_table_entries = 0;
+	//! The size of the hash table built by the operator in bytes (if any)
+	idx_t hash_table_size = 0;
 
 	OperatorTimingInformation(double time_ = 0, idx_t elements_ = 0) : time(time_), elements(elements_) {
 	}
 };
 
+//! The timing information of the tasks of a single pipeline that were executed on a single thread
+struct PipelineThreadTimingInformation {
+	//! The amount of tasks executed by the thread
+	idx_t tasks = 0;
+	//! The total time spent executing the tasks
+	double time = 0;
+	//! The total time the tasks spent waiting in the scheduler queue before they were picked up
+	double wait_time = 0;
+	//! The amount of tuples pushed into the sink of the pipeline
+	idx_t elements = 0;
+};
+
+//! The timing information of a pipeline, broken down per thread
+struct PipelineTimingInformation {
+	//! The textual representation of the pipeline (e.g. SEQ_SCAN -> HASH_GROUP_BY)
+	string name;
+	//! The timings of the pipeline per thread, indexed by the (query-local) thread index
+	vector<PipelineThreadTimingInformation> threads;
+};
+
+//! The sampled timings of a single physical operator type
+struct SampledOperatorTiming {
+	//! The total amount of chunks produced by the operator
+	idx_t chunks = 0;
+	//! The total amount of tuples produced by the operator
+	idx_t elements = 0;
+	//! The amount of chunks for which the timing was sampled
+	idx_t sampled_chunks = 0;
+	//! The amount of cycles spent in the operator (excluding its children) over all sampled chunks
+	uint64_t sampled_cycles = 0;
+};
+
 //! The OperatorProfiler measures timings of individual operators
 class OperatorProfiler {
 	friend class QueryProfiler;
 
+	//! The maximum nesting depth of operators for which sampled timings are gathered
+	static constexpr idx_t SAMPLE_MAX_DEPTH = 64;
+
+	struct SampleStackEntry {
+		PhysicalOperatorType type;
+		uint64_t start;
+		uint64_t child_cycles;
+	};
+
 public:
-	OperatorProfiler(bool enabled);
+	//! The sampled operator timings are indexed by the PhysicalOperatorType
+	static constexpr idx_t SAMPLED_OPERATOR_TYPES = 256;
+
+	//! Creates an operator profiler. If sample_rate is larger than zero, the profiler runs in sampling mode and times
+	//! every sample_rate-th chunk; the sampling mode takes precedence over the detailed timings.
+	OperatorProfiler(bool enabled, idx_t sample_rate = 0);
+
+	bool IsEnabled() {
+		return enabled;
+	}
 
 	void StartOperator(PhysicalOperator *phys_op);
 	void EndOperator(DataChunk *chunk);
 
+	//! Start timing a task of the pipeline with the given sink; wait_time is the time the task spent in the queue
+	void StartTask(PhysicalOperator *sink, string pipeline_name, double wait_time);
+	//! Finish timing the current task, elements is the amount of tuples that were pushed into the sink
+	void EndTask(idx_t elements);
+
 private:
 	void AddTiming(PhysicalOperator *op, double time, idx_t elements);
 
+	void StartSample(PhysicalOperator *phys_op);
+	void EndSample(DataChunk *chunk);
+
 	//! Whether or not the profiler is enabled
 	bool enabled;
 	//! The timer used to time the execution time of the individual Physical Operators
 	Profiler op;
+	//! The timer used to time the execution of the current task
+	Profiler task;
+	//! The sink of the pipeline of the current task, or nullptr if no task was started
+	PhysicalOperator *task_sink;
+	//! The name of the pipeline of the current task
+	string task_pipeline;
+	//! The timing of the current task
+	PipelineThreadTimingInformation task_timing;
 	//! The stack of Physical Operators that are currently active
 	std::stack<PhysicalOperator *> execution_stack;
 	//! A mapping of physical operators to recorded timings
 	unordered_map<PhysicalOperator *, OperatorTimingInformation> timings;
+
+	//! Sample every sample_rate-th chunk (0 = sampling disabled)
+	idx_t sample_rate;
+	//! The amount of chunks since the last sampled chunk
+	idx_t sample_counter;
+	//! Whether or not the chunk currently flowing through the operators is sampled
+	bool sample_current;
+	//! The current nesting depth of operators
+	idx_t sample_depth;
+	//! The stack of active operators in sampling mode
+	SampleStackEntry sample_stack[SAMPLE_MAX_DEPTH];
+	//! The sampled timings, indexed by operator type (only allocated in sampling mode)
+	unique_ptr<SampledOperatorTiming[]> sampled_timings;
 };
 
 //! The QueryProfiler can be used to measure timings of queries
@@ -75,7 +162,12 @@ private:
 	static string RenderTree(TreeNode &node);
 
 public:
-	QueryProfiler() : automatic_print_format(ProfilerPrintFormat::NONE), enabled(false), running(false) {
+	//! The default sample rate of the sampling profiler
+	static constexpr idx_t DEFAULT_SAMPLE_RATE = 64;
+
+	QueryProfiler(ClientContext &context)
+	    : automatic_print_format(ProfilerPrintFormat::NONE), context(context), enabled(false), running(false),
+	      sample_rate(0) {
 	}
 
 	void Enable() {
@@ -90,11 +182,25 @@ public:
 		return enabled;
 	}
 
-	void StartQuery(string query, SQLStatement &statement);
+	//! Enable sampling mode: every sample_rate-th chunk is timed and aggregated over all queries. While sampling is
+	//! enabled, no detailed operator timings are gathered.
+	void EnableSampling(idx_t sample_rate);
+	void DisableSampling();
+	idx_t SampleRate() {
+		return sample_rate;
+	}
+	//! Returns the sampled timings of all operator types that produced at least one chunk
+	vector<std::pair<PhysicalOperatorType, SampledOperatorTiming>> GetSampledTimings();
+	//! Clear the aggregated sampled timings
+	void ResetSampledTimings();
+
+	void StartQuery(string query);
 	void EndQuery();
 
 	//! Adds the timings gathered by an OperatorProfiler to this query profiler
 	void Flush(OperatorProfiler &profiler);
+	//! Record the size of the hash table built by the given operator
+	void SetHashTableSize(PhysicalOperator *op, idx_t entries, idx_t size);
 
 	void StartPhase(string phase);
 	void EndPhase();
@@ -114,6 +220,7 @@ public:
 	string save_location;
 
 private:
+	ClientContext &context;
 	//! Whether or not query profiling is enabled
 	bool enabled;
 	//! Whether or not the query profiler is running
@@ -130,6 +237,22 @@ private:
 	Profiler main_query;
 	//! A map of a Physical Operator pointer to a tree node
 	unordered_map<PhysicalOperator *, TreeNode *> tree_map;
+	//! Lock protecting the operator and pipeline timings that are flushed from multiple threads
+	mutex flush_lock;
+	//! A map of the sink of a pipeline to the timings of that pipeline, ordered by first flush
+	unordered_map<PhysicalOperator *, idx_t> pipeline_map;
+	vector<PipelineTimingInformation> pipeline_timings;
+	//! A map of thread ids to query-local thread indices
+	unordered_map<size_t, idx_t> thread_map;
+	//! The buffer manager statistics at the start of the query
+	BufferManagerStatistics start_statistics;
+	//! The buffer manager statistics gathered while running the query
+	BufferManagerStatistics query_statistics;
+
+	//! The sample rate of the sampling mode (0 = sampling disabled)
+	idx_t sample_rate;
+	//! The sampled timings aggregated over all queries, indexed by operator type
+	unique_ptr<SampledOperatorTiming[]> sampled_timings;
 
 	//! The timer used to time the individual phases of the planning process
 	Profiler phase_profiler;
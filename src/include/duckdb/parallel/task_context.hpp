@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/profiler.hpp"
 #include "duckdb/common/unordered_map.hpp"
 
 namespace duckdb {
@@ -28,6 +29,14 @@ public:
 
 	//! Per-operator task info
 	unordered_map<PhysicalOperator *, unique_ptr<OperatorTaskInfo>> task_info;
+	//! The index of the task within its pipeline; tasks are numbered in the order in which the source of the pipeline
+	//! produces its data, which allows sinks to preserve the order of the input
+	idx_t batch_index = 0;
+	//! Whether or not the task was scheduled through the task scheduler; tasks that are executed directly (e.g. the
+	//! pipelines of a recursive CTE) do not wait in the queue
+	bool scheduled = false;
+	//! Timer measuring the time between scheduling the task and the start of its execution
+	Profiler queue_timer;
 };
 
 } // namespace duckdb
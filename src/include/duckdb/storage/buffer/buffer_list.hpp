@@ -43,6 +43,14 @@ public:
 	unique_ptr<BufferEntry> Erase(BufferEntry *entry);
 	//! Insert an entry to the back of the list
 	void Append(unique_ptr<BufferEntry> entry);
+	//! Returns the first element (root) of the buffer list, or nullptr if the list is empty
+	BufferEntry *First() {
+		return root.get();
+	}
+	//! Returns the amount of entries in the list
+	idx_t Count() const {
+		return count;
+	}
 
 private:
 	//! Root pointer
@@ -0,0 +1,43 @@
+//===----------------------------------------------------------------------===//
+//                         DuckDB
+//
+// duckdb/storage/buffer/memory_reservation.hpp
+//
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "duckdb/common/common.hpp"
+
+namespace duckdb {
+class BufferManager;
+class ClientContext;
+
+//! A MemoryReservation accounts for memory that an operator allocates outside of the buffer manager (e.g. hash
+//! tables, string heaps or materialized chunks). The reserved memory counts both against the memory limit of the
+//! buffer manager and against the memory limit of the query. The reservation is released when it is destroyed.
+class MemoryReservation {
+public:
+	MemoryReservation(ClientContext &context);
+	~MemoryReservation();
+
+	//! Resize the reservation to the given size. Throws an OutOfMemoryException if the query or the database memory
+	//! limit would be exceeded.
+	void Resize(idx_t new_size);
+	//! Resize the reservation to the given size. Returns false (and leaves the reservation unchanged) if a memory
+	//! limit would be exceeded; operators that are able to spill to disk should do so in that case.
+	bool TryResize(idx_t new_size);
+
+	idx_t GetSize() const {
+		return size;
+	}
+
+private:
+	ClientContext &context;
+	BufferManager &buffer_manager;
+	//! The currently reserved amount of memory in bytes
+	idx_t size;
+};
+
+} // namespace duckdb
@@ -19,6 +19,34 @@
 
 namespace duckdb {
 
+//! Cumulative counters of the activity of the buffer manager
+struct BufferManagerStatistics {
+	//! The amount of times a block or buffer was pinned
+	idx_t pins = 0;
+	//! The amount of pins that had to load the block or buffer from disk
+	idx_t misses = 0;
+	//! The amount of blocks or buffers that were evicted from memory
+	idx_t evictions = 0;
+	//! The amount of bytes read from the database file or the temporary directory
+	idx_t bytes_read = 0;
+	//! The amount of bytes written to the temporary directory
+	idx_t bytes_written = 0;
+	//! The amount of bytes allocated through BufferManager::Allocate
+	idx_t bytes_allocated = 0;
+
+	//! Returns the difference between this set of counters and an earlier snapshot
+	BufferManagerStatistics Subtract(const BufferManagerStatistics &other) const {
+		BufferManagerStatistics result;
+		result.pins = pins - other.pins;
+		result.misses = misses - other.misses;
+		result.evictions = evictions - other.evictions;
+		result.bytes_read = bytes_read - other.bytes_read;
+		result.bytes_written = bytes_written - other.bytes_written;
+		result.bytes_allocated = bytes_allocated - other.bytes_allocated;
+		return result;
+	}
+};
+
 //! The buffer manager is in charge of handling memory management for the database. It hands out memory buffers that can
 //! be used by the database internally.
 class BufferManager {
@@ -42,6 +70,19 @@ public:
 	//! blocks can be evicted
 	void SetLimit(idx_t limit = (idx_t)-1);
 
+	//! Reserve memory for an allocation that is made outside of the buffer manager, evicting unpinned blocks if
+	//! required. Returns false if the reservation would exceed the memory limit and not enough blocks can be evicted.
+	bool TryReserveMemory(idx_t size);
+	//! Release memory that was reserved through TryReserveMemory
+	void FreeReservedMemory(idx_t size);
+	//! Returns the maximum amount of memory the buffer manager can keep (in bytes)
+	idx_t GetMaxMemory() {
+		return maximum_memory;
+	}
+
+	//! Returns a snapshot of the cumulative buffer manager counters
+	BufferManagerStatistics GetStatistics();
+
 	static BufferManager &GetBufferManager(ClientContext &context);
 
 private:
@@ -54,6 +95,9 @@ private:
 	//! Evict the least recently used block from the buffer manager, or throws an exception if there are no blocks
 	//! available to evict
 	unique_ptr<Block> EvictBlock();
+	//! Returns the least recently used entry that can be evicted, or nullptr if there is none. Without a temporary
+	//! directory only blocks of the database file can be evicted, since they can be read back from the file.
+	BufferEntry *GetEvictionCandidate();
 
 	//! Add a reference to the refcount of a buffer entry
 	void AddReference(BufferEntry *entry);
@@ -87,5 +131,7 @@ private:
 	BufferList lru;
 	//! The temporary id used for managed buffers
 	block_id_t temporary_id;
+	//! The cumulative counters of the buffer manager, protected by the block_lock
+	BufferManagerStatistics statistics;
 };
 } // namespace duckdb
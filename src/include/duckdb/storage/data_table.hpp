@@ -23,6 +23,7 @@
 #include <mutex>
 
 namespace duckdb {
+class ChunkCollection;
 class ClientContext;
 class ColumnDefinition;
 class DataTable;
@@ -93,6 +94,10 @@ public:
 
 	//! Append a DataChunk to the table. Throws an exception if the columns don't match the tables' columns.
 	void Append(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk);
+	//! Verify that a DataChunk can be appended to the table without appending it. Can be called in parallel.
+	void VerifyAppend(TableCatalogEntry &table, DataChunk &chunk);
+	//! Append a set of chunks that were verified with VerifyAppend to the transaction local storage
+	void LocalAppend(ClientContext &context, ChunkCollection &collection);
 	//! Delete the entries with the specified row identifier from the table
 	void Delete(TableCatalogEntry &table, ClientContext &context, Vector &row_ids, idx_t count);
 	//! Update the entries with the specified row identifier from the table
@@ -134,6 +139,10 @@ private:
 	                              unordered_map<idx_t, vector<TableFilter>> *table_filters, idx_t offset);
 	bool CheckZonemap(TableScanState &state, unordered_map<idx_t, vector<TableFilter>> &table_filters,
 	                  idx_t &current_row);
+	//! Checks the per-vector zone maps of the next "count" rows of a scan, returns false if none of the rows can
+	//! satisfy the filters
+	bool CheckZonemapRange(TableScanState &state, unordered_map<idx_t, vector<TableFilter>> &table_filters,
+	                       idx_t count);
 	bool ScanBaseTable(Transaction &transaction, DataChunk &result, TableScanState &state,
 	                   const vector<column_t> &column_ids, idx_t &current_row, idx_t max_row, idx_t base_row,
 	                   VersionManager &manager, unordered_map<idx_t, vector<TableFilter>> &table_filters);
@@ -10,6 +10,9 @@
 
 #include "duckdb/storage/uncompressed_segment.hpp"
 
+#include <atomic>
+#include <mutex>
+
 namespace duckdb {
 
 class NumericSegment : public UncompressedSegment {
@@ -32,6 +35,9 @@ public:
 	//! Rollback a previous update
 	void RollbackUpdate(UpdateInfo *info) override;
 
+	//! Checks the zone map of the vector at "vector_index" against a set of filters
+	bool CheckZonemap(idx_t vector_index, vector<TableFilter> &filters, bool initialize) override;
+
 protected:
 	void Update(ColumnData &data, SegmentStatistics &stats, Transaction &transaction, Vector &update, row_t *ids,
 	            idx_t count, idx_t vector_index, idx_t vector_offset, UpdateInfo *node) override;
@@ -53,6 +59,10 @@ public:
 	typedef void (*rollback_update_function_t)(UpdateInfo *info, data_ptr_t base_data);
 	typedef void (*merge_update_function_t)(SegmentStatistics &stats, UpdateInfo *node, data_ptr_t target,
 	                                        Vector &update, row_t *ids, idx_t count, idx_t vector_offset);
+	typedef void (*zonemap_initialize_function_t)(data_ptr_t zonemap);
+	typedef void (*zonemap_update_function_t)(data_ptr_t zonemap, bool &has_null, data_ptr_t source, idx_t offset,
+	                                          idx_t count);
+	typedef bool (*zonemap_check_function_t)(data_ptr_t zonemap, vector<TableFilter> &filters);
 
 private:
 	append_function_t append_function;
@@ -61,6 +71,27 @@ private:
 	update_info_append_function_t append_from_update_info;
 	rollback_update_function_t rollback_update;
 	merge_update_function_t merge_update_function;
+	zonemap_initialize_function_t zonemap_initialize;
+	zonemap_update_function_t zonemap_update;
+	zonemap_check_function_t zonemap_check;
+
+	//! The zone maps of the vectors of the segment: the minimum and maximum value of every vector, stored as
+	//! [min, max] pairs of type_size bytes each
+	unique_ptr<data_t[]> zonemap;
+	//! Whether or not each of the vectors of the segment contains NULL values
+	unique_ptr<bool[]> zonemap_has_null;
+	//! Whether or not the zone maps have been computed; the zone maps of segments that are loaded from disk are only
+	//! computed when they are first needed
+	std::atomic<bool> zonemap_initialized;
+	//! The lock used to compute the zone maps
+	std::mutex zonemap_lock;
+
+	//! Returns the zone map entry of the vector at "vector_index"
+	data_ptr_t GetZonemap(idx_t vector_index) {
+		return zonemap.get() + vector_index * 2 * type_size;
+	}
+	//! Computes the zone maps from the data in the block, if this has not happened yet
+	void InitializeZonemap();
 };
 
 template <class F1, class F2, class F3>
@@ -77,6 +77,9 @@ public:
 	//! Executes filter in this column
 	virtual void Select(Transaction &transaction, ColumnScanState &state, Vector &result, SelectionVector &sel,
 	                    idx_t &approved_tuple_count, vector<TableFilter> &tableFilter) = 0;
+	//! Checks the zone map of the vector at "vector_index" against a set of filters. Returns false if no tuple in the
+	//! vector can satisfy all of the filters.
+	virtual bool CheckZonemap(idx_t vector_index, vector<TableFilter> &filters) = 0;
 	//! Fetch the base table vector index that belongs to this row
 	virtual void Fetch(ColumnScanState &state, idx_t vector_index, Vector &result) = 0;
 	//! Fetch a value of the specific row id and append it to the result
@@ -41,6 +41,8 @@ public:
 	//! Executes the filters directly in the table's data
 	void Select(Transaction &transaction, ColumnScanState &state, Vector &result, SelectionVector &sel,
 	            idx_t &approved_tuple_count, vector<TableFilter> &tableFilter) override;
+	//! Checks the zone map of the vector at "vector_index" against a set of filters
+	bool CheckZonemap(idx_t vector_index, vector<TableFilter> &filters) override;
 	//! Fetch the base table vector index that belongs to this row
 	void Fetch(ColumnScanState &state, idx_t vector_index, Vector &result) override;
 	//! Fetch a value of the specific row id and append it to the result
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/common/common.hpp"
+#include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/storage/buffer/buffer_handle.hpp"
 #include "duckdb/storage/storage_lock.hpp"
 #include "duckdb/storage/table/column_segment.hpp"
@@ -60,6 +61,8 @@ struct LocalScanState {
 	idx_t chunk_index;
 	idx_t max_index;
 	idx_t last_chunk_count;
+	//! The chunk of the local storage that is currently being scanned
+	unique_ptr<DataChunk> chunk;
 };
 
 class TableScanState {
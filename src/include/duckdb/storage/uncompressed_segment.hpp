@@ -63,6 +63,12 @@ public:
 	//! Executes the filters directly in the table's data
 	void Select(Transaction &transaction, Vector &result, vector<TableFilter> &tableFilters, SelectionVector &sel,
 	            idx_t &approved_tuple_count, ColumnScanState &state);
+	//! Checks the zone map of the vector at "vector_index" against a set of filters. Returns false if no tuple in the
+	//! vector can satisfy all of the filters. If "initialize" is false, zone maps that have not been computed yet are
+	//! not computed, and the vector is assumed to pass.
+	virtual bool CheckZonemap(idx_t vector_index, vector<TableFilter> &filters, bool initialize) {
+		return true;
+	}
 	//! Fetch a single vector from the base table
 	void Fetch(ColumnScanState &state, idx_t vector_index, Vector &result);
 	//! Fetch a single value and append it to the vector
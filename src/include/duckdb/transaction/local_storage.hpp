@@ -8,7 +8,7 @@
 
 #pragma once
 
-#include "duckdb/common/types/chunk_collection.hpp"
+#include "duckdb/execution/buffered_chunk_collection.hpp"
 #include "duckdb/storage/table/scan_state.hpp"
 #include "duckdb/storage/index.hpp"
 
@@ -22,8 +22,9 @@ public:
 	LocalTableStorage(DataTable &table);
 	~LocalTableStorage();
 
-	//! The main chunk collection holding the data
-	ChunkCollection collection;
+	//! The main chunk collection holding the data; it is stored in buffer-managed blocks, so large transaction-local
+	//! appends can be offloaded to the temporary directory
+	unique_ptr<BufferedChunkCollection> collection;
 	//! The set of unique indexes
 	vector<unique_ptr<Index>> indexes;
 	//! The set of deleted entries
@@ -58,7 +59,10 @@ public:
 	//! Update a set of rows in the local storage
 	void Update(DataTable *table, Vector &row_ids, vector<column_t> &column_ids, DataChunk &data);
 
-	//! Commits the local storage, writing it to the WAL and completing the commit
+	//! Commits the local storage, writing it to the WAL and completing the commit. The rows are appended to the table
+	//! and to the WAL chunk by chunk, instead of linking the blocks of the local collections into the table: the
+	//! blocks use a different format than the column segments, and WAL replay re-creates the row ids of the table
+	//! (which the logged deletes and updates refer to) by replaying the inserts in commit order.
 	void Commit(LocalStorage::CommitState &commit_state, Transaction &transaction, WriteAheadLog *log,
 	            transaction_t commit_id);
 	//! Revert the commit made so far by the LocalStorage
@@ -67,6 +71,10 @@ public:
 	bool ChangesMade() noexcept {
 		return table_storage.size() > 0;
 	}
+	//! Whether or not any local changes have been made to the specified table
+	bool HasStorage(DataTable *table) {
+		return table_storage.find(table) != table_storage.end();
+	}
 
 	void AddColumn(DataTable *old_dt, DataTable *new_dt, ColumnDefinition &new_column, Expression *default_value);
 	void ChangeType(DataTable *old_dt, DataTable *new_dt, idx_t changed_idx, LogicalType target_type,
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "duckdb/catalog/catalog_entry/sequence_catalog_entry.hpp"
+#include "duckdb/common/mutex.hpp"
 #include "duckdb/common/types/data_chunk.hpp"
 #include "duckdb/common/unordered_map.hpp"
 #include "duckdb/transaction/undo_buffer.hpp"
@@ -50,6 +51,8 @@ public:
 	transaction_t active_query;
 	//! The timestamp when the transaction started
 	timestamp_t start_timestamp;
+	//! The version of the catalog when the transaction started
+	idx_t catalog_version = 0;
 	//! The set of uncommitted appends for the transaction
 	LocalStorage storage;
 	//! Map of all sequences that were used during the transaction and the value they had in this transaction
@@ -80,12 +83,15 @@ public:
 
 	void PushDelete(DataTable *table, ChunkInfo *vinfo, row_t rows[], idx_t count, idx_t base_row);
 
+	//! Creates the undo buffer entry of an update, can be called concurrently by the threads of a parallel UPDATE
 	UpdateInfo *CreateUpdateInfo(idx_t type_size, idx_t entries);
 
 private:
 	//! The undo buffer is used to store old versions of rows that are updated
 	//! or deleted
 	UndoBuffer undo_buffer;
+	//! The lock protecting the undo buffer against concurrent updates of different segments
+	mutex undo_lock;
 
 	Transaction(const Transaction &) = delete;
 };
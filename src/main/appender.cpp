@@ -183,6 +183,28 @@ void Appender::Flush() {
 	column = 0;
 }
 
+void Appender::AppendChunk(DataChunk &input) {
+	CheckInvalidated();
+	if (input.column_count() != chunk.column_count()) {
+		InvalidateException("Column count of appended chunk does not match the table!");
+	}
+	for (idx_t i = 0; i < input.column_count(); i++) {
+		if (input.data[i].type != chunk.data[i].type) {
+			InvalidateException("Type of appended chunk does not match the table!");
+		}
+	}
+	Flush();
+	if (input.size() == 0) {
+		return;
+	}
+	try {
+		con.Append(*description, input);
+	} catch (Exception &ex) {
+		Invalidate(ex.what());
+		throw ex;
+	}
+}
+
 void Appender::Close() {
 	if (!invalidated_msg.empty()) {
 		return;
@@ -6,6 +6,7 @@
 #include "duckdb/execution/physical_plan_generator.hpp"
 #include "duckdb/main/database.hpp"
 #include "duckdb/main/materialized_query_result.hpp"
+#include "duckdb/main/plan_cache.hpp"
 #include "duckdb/main/query_result.hpp"
 #include "duckdb/main/stream_query_result.hpp"
 #include "duckdb/optimizer/optimizer.hpp"
@@ -17,6 +18,7 @@
 #include "duckdb/parser/statement/prepare_statement.hpp"
 #include "duckdb/parser/statement/select_statement.hpp"
 #include "duckdb/planner/operator/logical_execute.hpp"
+#include "duckdb/planner/operator/logical_prepare.hpp"
 #include "duckdb/planner/planner.hpp"
 #include "duckdb/transaction/transaction_manager.hpp"
 #include "duckdb/transaction/transaction.hpp"
@@ -25,6 +27,7 @@
 #include "duckdb/main/relation.hpp"
 #include "duckdb/planner/expression_binder/where_binder.hpp"
 #include "duckdb/parser/statement/relation_statement.hpp"
+#include "duckdb/catalog/catalog_entry/prepared_statement_catalog_entry.hpp"
 #include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/common/serializer/buffered_file_writer.hpp"
 
@@ -35,8 +38,9 @@ using namespace std;
 namespace duckdb {
 
 ClientContext::ClientContext(DuckDB &database)
-    : db(database), transaction(*database.transaction_manager), interrupted(false), executor(*this),
-      catalog(*database.catalog), temporary_objects(make_unique<SchemaCatalogEntry>(db.catalog.get(), TEMP_SCHEMA)),
+    : profiler(*this), db(database), transaction(*database.transaction_manager), interrupted(false),
+      query_memory_usage(0), executor(*this), catalog(*database.catalog),
+      temporary_objects(make_unique<SchemaCatalogEntry>(db.catalog.get(), TEMP_SCHEMA)),
       prepared_statements(make_unique<CatalogSet>(*db.catalog)), open_result(nullptr) {
 	random_device rd;
 	random_engine.seed(rd());
@@ -65,6 +69,14 @@ void ClientContext::Cleanup() {
 	CleanupInternal();
 }
 
+void ClientContext::CleanupResult() {
+	lock_guard<mutex> client_guard(context_lock);
+	if (is_invalidated) {
+		return;
+	}
+	CleanupInternal();
+}
+
 void ClientContext::RegisterAppender(Appender *appender) {
 	lock_guard<mutex> client_guard(context_lock);
 	if (is_invalidated) {
@@ -111,6 +123,13 @@ string ClientContext::FinalizeQuery(bool success) {
 	profiler.EndQuery();
 
 	executor.Reset();
+	if (running_statement) {
+		if (success && running_statement->cacheable) {
+			// the executor no longer refers to the plan: other queries can now execute it
+			db.plan_cache->Insert(query, move(running_statement));
+		}
+		running_statement = nullptr;
+	}
 
 	string error;
 	if (transaction.HasActiveTransaction()) {
@@ -157,6 +176,17 @@ unique_ptr<DataChunk> ClientContext::FetchInternal() {
 	return executor.FetchChunk();
 }
 
+//! Clears the cacheable flag of the statement (or of the statement prepared by a PREPARE) if its plan cannot be cached
+static void CheckPlanCache(LogicalOperator &plan, PreparedStatementData &statement) {
+	if (plan.type == LogicalOperatorType::PREPARE) {
+		CheckPlanCache(*plan.children[0], *((LogicalPrepare &)plan).prepared);
+		return;
+	}
+	if (statement.cacheable) {
+		statement.cacheable = statement.statement_type == StatementType::SELECT_STATEMENT && PlanCache::CanCache(plan);
+	}
+}
+
 unique_ptr<PreparedStatementData> ClientContext::CreatePreparedStatement(const string &query,
                                                                          unique_ptr<SQLStatement> statement) {
 	StatementType statement_type = statement->type;
@@ -175,6 +205,17 @@ unique_ptr<PreparedStatementData> ClientContext::CreatePreparedStatement(const s
 	result->names = planner.names;
 	result->types = planner.types;
 	result->value_map = move(planner.value_map);
+	result->catalog_version = ActiveTransaction().catalog_version;
+	result->cacheable = UsePlanCache();
+	if (plan->type == LogicalOperatorType::PREPARE) {
+		// the plan of a PREPARE is cached as the plan of the prepared statement
+		auto &prepared = *((LogicalPrepare &)*plan).prepared;
+		prepared.catalog_version = result->catalog_version;
+		prepared.cacheable = result->cacheable;
+		result->cacheable = false;
+	}
+	// check if the plan can be cached before the optimizer folds the calls of functions that read the current time
+	CheckPlanCache(*plan, *result);
 
 #ifdef DEBUG
 	if (enable_optimizer) {
@@ -187,6 +228,8 @@ unique_ptr<PreparedStatementData> ClientContext::CreatePreparedStatement(const s
 #ifdef DEBUG
 	}
 #endif
+	// the optimizer can introduce index scans, which cannot be cached either
+	CheckPlanCache(*plan, *result);
 
 	profiler.StartPhase("physical_planner");
 	// now convert logical query plan into a physical query plan
@@ -199,8 +242,13 @@ unique_ptr<PreparedStatementData> ClientContext::CreatePreparedStatement(const s
 	return result;
 }
 
-unique_ptr<QueryResult> ClientContext::ExecutePreparedStatement(const string &query, PreparedStatementData &statement,
+unique_ptr<QueryResult> ClientContext::ExecutePreparedStatement(const string &query,
+                                                                unique_ptr<PreparedStatementData> prepared,
                                                                 vector<Value> bound_values, bool allow_stream_result) {
+	// the plan is owned by the running statement until the query is finalized
+	executor.Reset();
+	running_statement = move(prepared);
+	auto &statement = *running_statement;
 	if (ActiveTransaction().is_invalidated && statement.requires_valid_transaction) {
 		throw Exception("Current transaction is aborted (please ROLLBACK)");
 	}
@@ -215,7 +263,7 @@ unique_ptr<QueryResult> ClientContext::ExecutePreparedStatement(const string &qu
 	bool create_stream_result = statement.statement_type == StatementType::SELECT_STATEMENT && allow_stream_result;
 
 	// store the physical plan in the context for calls to Fetch()
-	executor.Initialize(move(statement.plan));
+	executor.Initialize(statement.plan.get());
 
 	auto types = executor.GetTypes();
 	assert(types == statement.types);
@@ -273,6 +321,10 @@ unique_ptr<PreparedStatement> ClientContext::Prepare(string query) {
 	try {
 		InitialCleanup();
 
+		auto prepared_object = PrepareCachedPlan(query);
+		if (prepared_object) {
+			return prepared_object;
+		}
 		// first parse the query
 		idx_t n_prepared_parameters;
 		auto statements = ParseStatements(query, &n_prepared_parameters);
@@ -296,8 +348,8 @@ unique_ptr<PreparedStatement> ClientContext::Prepare(string query) {
 			throw Exception(result->error);
 		}
 		auto prepared_catalog = (PreparedStatementCatalogEntry *)prepared_statements->GetRootEntry(prepare_name);
-		auto prepared_object = make_unique<PreparedStatement>(this, prepare_name, query, *prepared_catalog->prepared,
-		                                                      n_prepared_parameters);
+		prepared_object = make_unique<PreparedStatement>(this, prepare_name, query, *prepared_catalog->prepared,
+		                                                 n_prepared_parameters);
 		prepared_statement_objects.insert(prepared_object.get());
 		return prepared_object;
 	} catch (Exception &ex) {
@@ -305,6 +357,42 @@ unique_ptr<PreparedStatement> ClientContext::Prepare(string query) {
 	}
 }
 
+unique_ptr<PreparedStatement> ClientContext::PrepareCachedPlan(const string &query) {
+	if (!UsePlanCache()) {
+		return nullptr;
+	}
+	auto cached_plan = db.plan_cache->Lookup(query);
+	if (!cached_plan) {
+		return nullptr;
+	}
+	string prepare_name = "____duckdb_internal_prepare_" + to_string(prepare_count);
+	PreparedStatementData *prepared = nullptr;
+	RunFunctionInTransactionInternal([&]() {
+		if (ActiveTransaction().catalog_version != cached_plan->catalog_version) {
+			// the transaction started before the plan was created, and might not see the objects it refers to
+			return;
+		}
+		// store the cached plan as the prepared statement, like PhysicalPrepare does for a newly created plan
+		auto entry = make_unique<PreparedStatementCatalogEntry>(prepare_name, move(cached_plan));
+		entry->catalog = &catalog;
+		prepared = entry->prepared.get();
+		auto &dependencies = entry->prepared->dependencies;
+		if (!prepared_statements->CreateEntry(ActiveTransaction(), prepare_name, move(entry), dependencies)) {
+			throw Exception("Failed to prepare statement");
+		}
+	});
+	if (!prepared) {
+		// the plan is still valid for other transactions
+		db.plan_cache->Insert(query, move(cached_plan));
+		return nullptr;
+	}
+	prepare_count++;
+	auto prepared_object =
+	    make_unique<PreparedStatement>(this, prepare_name, query, *prepared, prepared->value_map.size());
+	prepared_statement_objects.insert(prepared_object.get());
+	return prepared_object;
+}
+
 unique_ptr<QueryResult> ClientContext::Execute(string name, vector<Value> &values, bool allow_stream_result,
                                                string query) {
 	lock_guard<mutex> client_guard(context_lock);
@@ -335,6 +423,18 @@ void ClientContext::RemovePreparedStatement(PreparedStatement *statement) {
 	}
 	// erase the object from the list of prepared statements
 	prepared_statement_objects.erase(statement);
+	if (!transaction.HasActiveTransaction()) {
+		// return the plan to the plan cache, so it can be prepared again by this or a different connection; the drop of
+		// the catalog entry cannot be rolled back outside of a transaction, so nothing refers to the plan afterwards
+		// after a rollback of the PREPARE, the root entry is the deleted placeholder entry
+		auto root_entry = prepared_statements->GetRootEntry(statement->name);
+		if (root_entry && !root_entry->deleted && root_entry->type == CatalogType::PREPARED_STATEMENT) {
+			auto &entry = (PreparedStatementCatalogEntry &)*root_entry;
+			if (entry.prepared && entry.prepared->cacheable) {
+				db.plan_cache->Insert(statement->query, move(entry.prepared));
+			}
+		}
+	}
 	// drop it from the catalog
 	auto deallocate_statement = make_unique<DropStatement>();
 	deallocate_statement->info->type = CatalogType::PREPARED_STATEMENT;
@@ -344,17 +444,37 @@ void ClientContext::RemovePreparedStatement(PreparedStatement *statement) {
 }
 
 unique_ptr<QueryResult> ClientContext::RunStatementInternal(const string &query, unique_ptr<SQLStatement> statement,
-                                                            bool allow_stream_result) {
-	// prepare the query for execution
-	auto prepared = CreatePreparedStatement(query, move(statement));
+                                                            bool allow_stream_result, bool use_plan_cache,
+                                                            unique_ptr<PreparedStatementData> cached_plan) {
+	unique_ptr<PreparedStatementData> prepared;
+	if (cached_plan && cached_plan->catalog_version == ActiveTransaction().catalog_version) {
+		// the query has been planned before against the catalog this transaction sees: reuse the plan
+		prepared = move(cached_plan);
+	} else {
+		if (cached_plan) {
+			// the transaction started before the plan was created, but the plan is still valid for other transactions
+			db.plan_cache->Insert(query, move(cached_plan));
+		}
+		if (!statement) {
+			// the query was not parsed because a plan was cached: parse it now
+			auto statements = ParseStatements(query);
+			assert(statements.size() == 1);
+			statement = move(statements[0]);
+		}
+		// prepare the query for execution
+		prepared = CreatePreparedStatement(query, move(statement));
+		// only the plans of queries that consist of a single statement can be found by their query string
+		prepared->cacheable = prepared->cacheable && use_plan_cache;
+	}
 	// by default, no values are bound
 	vector<Value> bound_values;
 	// execute the prepared statement
-	return ExecutePreparedStatement(query, *prepared, move(bound_values), allow_stream_result);
+	return ExecutePreparedStatement(query, move(prepared), move(bound_values), allow_stream_result);
 }
 
 unique_ptr<QueryResult> ClientContext::RunStatement(const string &query, unique_ptr<SQLStatement> statement,
-                                                    bool allow_stream_result) {
+                                                    bool allow_stream_result, bool use_plan_cache,
+                                                    unique_ptr<PreparedStatementData> cached_plan) {
 	this->query = query;
 
 	unique_ptr<QueryResult> result;
@@ -363,7 +483,7 @@ unique_ptr<QueryResult> ClientContext::RunStatement(const string &query, unique_
 		transaction.BeginTransaction();
 	}
 	ActiveTransaction().active_query = db.transaction_manager->GetQueryNumber();
-	if (statement->type == StatementType::SELECT_STATEMENT && query_verification_enabled) {
+	if (statement && statement->type == StatementType::SELECT_STATEMENT && query_verification_enabled) {
 		// query verification is enabled:
 		// create a copy of the statement and verify the original statement
 		auto copied_statement = ((SelectStatement &)*statement).Copy();
@@ -377,9 +497,9 @@ unique_ptr<QueryResult> ClientContext::RunStatement(const string &query, unique_
 		statement = move(copied_statement);
 	}
 	// start the profiler
-	profiler.StartQuery(query, *statement);
+	profiler.StartQuery(query);
 	try {
-		result = RunStatementInternal(query, move(statement), allow_stream_result);
+		result = RunStatementInternal(query, move(statement), allow_stream_result, use_plan_cache, move(cached_plan));
 	} catch (StandardException &ex) {
 		// standard exceptions do not invalidate the current transaction
 		result = make_unique<MaterializedQueryResult>(ex.what());
@@ -418,10 +538,12 @@ unique_ptr<QueryResult> ClientContext::RunStatements(const string &query, vector
 	// iterate over them and execute them one by one
 	unique_ptr<QueryResult> result;
 	QueryResult *last_result = nullptr;
+	bool use_plan_cache = statements.size() == 1;
 	for (idx_t i = 0; i < statements.size(); i++) {
 		auto &statement = statements[i];
 		bool is_last_statement = i + 1 == statements.size();
-		auto current_result = RunStatement(query, move(statement), allow_stream_result && is_last_statement);
+		auto current_result =
+		    RunStatement(query, move(statement), allow_stream_result && is_last_statement, use_plan_cache);
 		// now append the result to the list of results
 		if (!last_result) {
 			// first result of the query
@@ -446,13 +568,27 @@ unique_ptr<QueryResult> ClientContext::Query(string query, bool allow_stream_res
 	}
 
 	vector<unique_ptr<SQLStatement>> statements;
+	unique_ptr<PreparedStatementData> cached_plan;
 	try {
 		InitialCleanup();
-		// parse the query and transform it into a set of statements
-		statements = ParseStatements(query);
+		if (UsePlanCache()) {
+			// if the query has been planned before, it does not have to be parsed
+			cached_plan = db.plan_cache->Lookup(query);
+			if (cached_plan && !cached_plan->value_map.empty()) {
+				// the plan was cached by a prepared statement, it cannot be executed without parameters
+				db.plan_cache->Insert(query, move(cached_plan));
+			}
+		}
+		if (!cached_plan) {
+			// parse the query and transform it into a set of statements
+			statements = ParseStatements(query);
+		}
 	} catch (std::exception &ex) {
 		return make_unique<MaterializedQueryResult>(ex.what());
 	}
+	if (cached_plan) {
+		return RunStatement(query, nullptr, allow_stream_result, true, move(cached_plan));
+	}
 
 	if (statements.size() == 0) {
 		// no statements, return empty successful result
@@ -656,6 +792,12 @@ string ClientContext::VerifyQuery(string query, unique_ptr<SQLStatement> stateme
 	return "";
 }
 
+bool ClientContext::UsePlanCache() {
+	// plans of other connections do not know the temporary objects of this connection, and verified queries are
+	// planned in different ways on purpose
+	return !has_temporary_objects && !query_verification_enabled && enable_optimizer;
+}
+
 void ClientContext::RegisterFunction(CreateFunctionInfo *info) {
 	RunFunctionInTransaction([&]() { temporary_objects.get()->CreateFunction(*this, info); });
 }
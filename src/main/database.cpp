@@ -4,6 +4,7 @@
 #include "duckdb/common/file_system.hpp"
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/connection_manager.hpp"
+#include "duckdb/main/plan_cache.hpp"
 #include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/transaction/transaction_manager.hpp"
@@ -44,6 +45,7 @@ DuckDB::DuckDB(const char *path, DBConfig *new_config) {
 	transaction_manager = make_unique<TransactionManager>(*storage);
 	scheduler = make_unique<TaskScheduler>();
 	connection_manager = make_unique<ConnectionManager>();
+	plan_cache = make_unique<PlanCache>(*catalog, config.plan_cache_size);
 	// initialize the database
 	storage->Initialize();
 }
@@ -78,6 +80,7 @@ void DuckDB::Configure(DBConfig &new_config) {
 	config.default_order_type = new_config.default_order_type;
 	config.default_null_order = new_config.default_null_order;
 	config.enable_copy = new_config.enable_copy;
+	config.plan_cache_size = new_config.plan_cache_size;
 }
 
 DBConfig &DBConfig::GetConfig(ClientContext &context) {
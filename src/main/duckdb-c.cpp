@@ -2,6 +2,7 @@
 #include "duckdb/common/types/time.hpp"
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/main/appender.hpp"
 #include "duckdb.h"
 #include "duckdb.hpp"
 
@@ -15,6 +16,7 @@ using namespace duckdb;
 
 static duckdb_type ConvertCPPTypeToC(LogicalType type);
 static idx_t GetCTypeSize(duckdb_type type);
+static LogicalType ConvertCArrayTypeToCPP(duckdb_type type);
 namespace duckdb {
 struct DatabaseData {
 	DatabaseData() : database(nullptr) {
@@ -307,6 +309,177 @@ void duckdb_destroy_result(duckdb_result *result) {
 	}
 	memset(result, 0, sizeof(duckdb_result));
 }
+
+// the chunks of a streaming result point directly to the vector data, so the C types have to match the internal ones
+static_assert(sizeof(duckdb_string_t) == sizeof(string_t), "duckdb_string_t must match string_t");
+static_assert(sizeof(duckdb_hugeint) == sizeof(hugeint_t), "duckdb_hugeint must match hugeint_t");
+static_assert(sizeof(duckdb_interval) == sizeof(interval_t), "duckdb_interval must match interval_t");
+
+namespace duckdb {
+struct StreamingResultWrapper {
+	unique_ptr<QueryResult> result;
+};
+} // namespace duckdb
+
+duckdb_state duckdb_query_stream(duckdb_connection connection, const char *query, duckdb_streaming_result *out_result) {
+	if (!out_result) {
+		return DuckDBError;
+	}
+	// the result is always initialized, so that it can be destroyed also when the query fails
+	*out_result = nullptr;
+	if (!connection || !query) {
+		return DuckDBError;
+	}
+	auto wrapper = new StreamingResultWrapper();
+	Connection *conn = (Connection *)connection;
+	wrapper->result = conn->SendQuery(query);
+	*out_result = (duckdb_streaming_result)wrapper;
+	return wrapper->result->success ? DuckDBSuccess : DuckDBError;
+}
+
+const char *duckdb_stream_error(duckdb_streaming_result result) {
+	auto wrapper = (StreamingResultWrapper *)result;
+	if (!wrapper || wrapper->result->success) {
+		return NULL;
+	}
+	return wrapper->result->error.c_str();
+}
+
+idx_t duckdb_stream_column_count(duckdb_streaming_result result) {
+	auto wrapper = (StreamingResultWrapper *)result;
+	if (!wrapper) {
+		return 0;
+	}
+	return wrapper->result->types.size();
+}
+
+duckdb_type duckdb_stream_column_type(duckdb_streaming_result result, idx_t col) {
+	auto wrapper = (StreamingResultWrapper *)result;
+	if (!wrapper || col >= wrapper->result->types.size()) {
+		return DUCKDB_TYPE_INVALID;
+	}
+	return ConvertCPPTypeToC(wrapper->result->types[col]);
+}
+
+const char *duckdb_stream_column_name(duckdb_streaming_result result, idx_t col) {
+	auto wrapper = (StreamingResultWrapper *)result;
+	if (!wrapper || col >= wrapper->result->names.size()) {
+		return NULL;
+	}
+	return wrapper->result->names[col].c_str();
+}
+
+duckdb_state duckdb_stream_fetch_chunk(duckdb_streaming_result result, duckdb_chunk *out_chunk) {
+	auto wrapper = (StreamingResultWrapper *)result;
+	if (!out_chunk) {
+		return DuckDBError;
+	}
+	memset(out_chunk, 0, sizeof(duckdb_chunk));
+	if (!wrapper || !wrapper->result->success) {
+		return DuckDBError;
+	}
+	auto chunk = wrapper->result->Fetch();
+	if (!wrapper->result->success) {
+		return DuckDBError;
+	}
+	if (!chunk || chunk->size() == 0) {
+		// end of the result (or the result was closed by another query on the connection)
+		return DuckDBSuccess;
+	}
+	chunk->Normalify();
+	out_chunk->column_count = chunk->column_count();
+	out_chunk->count = chunk->size();
+	out_chunk->columns = (duckdb_column_data *)malloc(sizeof(duckdb_column_data) * out_chunk->column_count);
+	if (!out_chunk->columns) {
+		return DuckDBError;
+	}
+	memset(out_chunk->columns, 0, sizeof(duckdb_column_data) * out_chunk->column_count);
+	for (idx_t col = 0; col < out_chunk->column_count; col++) {
+		auto &vector = chunk->data[col];
+		if (ConvertCPPTypeToC(vector.type) != DUCKDB_TYPE_INVALID) {
+			out_chunk->columns[col].data = FlatVector::GetData(vector);
+		}
+		auto &nullmask = FlatVector::Nullmask(vector);
+		if (nullmask.any()) {
+			auto target = (bool *)malloc(sizeof(bool) * out_chunk->count);
+			if (!target) {
+				duckdb_destroy_chunk(out_chunk);
+				return DuckDBError;
+			}
+			for (idx_t i = 0; i < out_chunk->count; i++) {
+				target[i] = nullmask[i];
+			}
+			out_chunk->columns[col].nullmask = target;
+		}
+	}
+	// the chunk owns the vector data the columns point to
+	out_chunk->internal_data = chunk.release();
+	return DuckDBSuccess;
+}
+
+void duckdb_destroy_chunk(duckdb_chunk *chunk) {
+	if (!chunk) {
+		return;
+	}
+	if (chunk->columns) {
+		for (idx_t i = 0; i < chunk->column_count; i++) {
+			if (chunk->columns[i].nullmask) {
+				free(chunk->columns[i].nullmask);
+			}
+		}
+		free(chunk->columns);
+	}
+	if (chunk->internal_data) {
+		delete (DataChunk *)chunk->internal_data;
+	}
+	memset(chunk, 0, sizeof(duckdb_chunk));
+}
+
+void duckdb_destroy_stream(duckdb_streaming_result *result) {
+	if (!result) {
+		return;
+	}
+	auto wrapper = (StreamingResultWrapper *)*result;
+	if (wrapper) {
+		delete wrapper;
+	}
+	*result = nullptr;
+}
+
+const char *duckdb_string_data(duckdb_string_t *string) {
+	return ((string_t *)string)->GetData();
+}
+
+duckdb_date duckdb_from_date(int32_t date) {
+	int32_t year, month, day;
+	Date::Convert(date, year, month, day);
+	duckdb_date result;
+	result.year = year;
+	result.month = month;
+	result.day = day;
+	return result;
+}
+
+duckdb_time duckdb_from_time(int32_t time) {
+	int32_t hour, min, sec, msec;
+	Time::Convert(time, hour, min, sec, msec);
+	duckdb_time result;
+	result.hour = hour;
+	result.min = min;
+	result.sec = sec;
+	result.msec = msec;
+	return result;
+}
+
+duckdb_timestamp duckdb_from_timestamp(int64_t timestamp) {
+	date_t date;
+	dtime_t time;
+	Timestamp::Convert(timestamp, date, time);
+	duckdb_timestamp result;
+	result.date = duckdb_from_date(date);
+	result.time = duckdb_from_time(time);
+	return result;
+}
 namespace duckdb {
 struct PreparedStatementWrapper {
 	PreparedStatementWrapper() : statement(nullptr) {
@@ -400,6 +573,129 @@ duckdb_state duckdb_execute_prepared(duckdb_prepared_statement prepared_statemen
 	return duckdb_translate_result(mat_res, out_result);
 }
 
+//! Converts a slice of the C column arrays into the chunk, which is initialized with the target types of the columns.
+//! Values are referenced instead of copied where the C type matches the target type.
+static void ConvertColumnArrays(duckdb_column_array *arrays, idx_t offset, idx_t count, DataChunk &result) {
+	assert(count <= STANDARD_VECTOR_SIZE);
+	result.Reset();
+	for (idx_t col_idx = 0; col_idx < result.column_count(); col_idx++) {
+		auto &array = arrays[col_idx];
+		auto source_type = ConvertCArrayTypeToCPP(array.type);
+		auto &target = result.data[col_idx];
+		Vector source(source_type, nullptr);
+		if (source_type.id() == LogicalTypeId::VARCHAR) {
+			source.Initialize(source_type);
+			auto strings = (const char **)array.data + offset;
+			auto source_data = FlatVector::GetData<string_t>(source);
+			auto &source_nullmask = FlatVector::Nullmask(source);
+			for (idx_t i = 0; i < count; i++) {
+				// check the nullmask before reading the string: the pointers of NULL values may be uninitialized
+				if ((array.nullmask && array.nullmask[offset + i]) || !strings[i]) {
+					source_nullmask[i] = true;
+					continue;
+				}
+				source_data[i] = string_t(strings[i], strlen(strings[i]));
+			}
+		} else {
+			auto type_size = GetTypeIdSize(source_type.InternalType());
+			FlatVector::SetData(source, (data_ptr_t)array.data + offset * type_size);
+		}
+		if (array.nullmask) {
+			auto &source_nullmask = FlatVector::Nullmask(source);
+			for (idx_t i = 0; i < count; i++) {
+				if (array.nullmask[offset + i]) {
+					source_nullmask[i] = true;
+				}
+			}
+		}
+		if (source_type == target.type) {
+			target.Reference(source);
+		} else {
+			VectorOperations::Cast(source, target, count);
+		}
+	}
+	result.SetCardinality(count);
+}
+
+static bool VerifyColumnArrays(duckdb_column_array *arrays, idx_t column_count) {
+	for (idx_t col_idx = 0; col_idx < column_count; col_idx++) {
+		if (ConvertCArrayTypeToCPP(arrays[col_idx].type).id() == LogicalTypeId::INVALID) {
+			return false;
+		}
+		if (!arrays[col_idx].data) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static duckdb_state duckdb_execute_prepared_batch_internal(PreparedStatement &statement, duckdb_column_array *params,
+                                                           idx_t count, unique_ptr<QueryResult> &result) {
+	vector<LogicalType> types;
+	for (idx_t param_idx = 0; param_idx < statement.n_param; param_idx++) {
+		types.push_back(ConvertCArrayTypeToCPP(params[param_idx].type));
+	}
+	DataChunk chunk;
+	if (!types.empty()) {
+		chunk.Initialize(types);
+	}
+	vector<Value> values;
+	values.resize(types.size());
+	for (idx_t offset = 0; offset < count; offset += STANDARD_VECTOR_SIZE) {
+		idx_t next = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - offset);
+		if (!types.empty()) {
+			ConvertColumnArrays(params, offset, next, chunk);
+		}
+		for (idx_t row_idx = 0; row_idx < next; row_idx++) {
+			for (idx_t param_idx = 0; param_idx < types.size(); param_idx++) {
+				values[param_idx] = chunk.GetValue(param_idx, row_idx);
+			}
+			result = statement.Execute(values, false);
+			if (!result->success) {
+				return DuckDBError;
+			}
+		}
+	}
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_execute_prepared_batch(duckdb_prepared_statement prepared_statement, duckdb_column_array *params,
+                                           idx_t count, duckdb_result *out_result) {
+	auto wrapper = (PreparedStatementWrapper *)prepared_statement;
+	if (!wrapper || !wrapper->statement || !wrapper->statement->success || wrapper->statement->is_invalidated) {
+		return DuckDBError;
+	}
+	auto &statement = *wrapper->statement;
+	if (count == 0 || (statement.n_param > 0 && (!params || !VerifyColumnArrays(params, statement.n_param)))) {
+		return DuckDBError;
+	}
+	// run all executions in a single transaction, so they share one commit instead of committing every row
+	auto &context = *statement.context;
+	bool auto_commit = context.transaction.IsAutoCommit();
+	unique_ptr<QueryResult> result;
+	duckdb_state state;
+	try {
+		if (auto_commit) {
+			result = context.Query("BEGIN TRANSACTION", false);
+			if (!result->success) {
+				return duckdb_translate_result((MaterializedQueryResult *)result.get(), out_result);
+			}
+		}
+		state = duckdb_execute_prepared_batch_internal(statement, params, count, result);
+	} catch (std::exception &ex) {
+		result = make_unique<MaterializedQueryResult>(ex.what());
+		state = DuckDBError;
+	}
+	if (auto_commit) {
+		auto end_result = context.Query(state == DuckDBSuccess ? "COMMIT" : "ROLLBACK", false);
+		if (!end_result->success && state == DuckDBSuccess) {
+			result = move(end_result);
+		}
+	}
+	assert(result->type == QueryResultType::MATERIALIZED_RESULT);
+	return duckdb_translate_result((MaterializedQueryResult *)result.get(), out_result);
+}
+
 void duckdb_destroy_prepare(duckdb_prepared_statement *prepared_statement) {
 	if (!prepared_statement) {
 		return;
@@ -411,6 +707,155 @@ void duckdb_destroy_prepare(duckdb_prepared_statement *prepared_statement) {
 	*prepared_statement = nullptr;
 }
 
+namespace duckdb {
+struct AppenderWrapper {
+	unique_ptr<Appender> appender;
+	string error;
+};
+} // namespace duckdb
+
+duckdb_state duckdb_appender_create(duckdb_connection connection, const char *schema, const char *table,
+                                    duckdb_appender *out_appender) {
+	if (!connection || !table || !out_appender) {
+		return DuckDBError;
+	}
+	if (!schema) {
+		schema = DEFAULT_SCHEMA;
+	}
+	auto wrapper = new AppenderWrapper();
+	*out_appender = (duckdb_appender)wrapper;
+	try {
+		wrapper->appender = make_unique<Appender>(*(Connection *)connection, schema, table);
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown create appender error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+const char *duckdb_appender_error(duckdb_appender appender) {
+	auto wrapper = (AppenderWrapper *)appender;
+	if (!wrapper || wrapper->error.empty()) {
+		return nullptr;
+	}
+	return wrapper->error.c_str();
+}
+
+template <class FUN> static duckdb_state duckdb_appender_run_function(duckdb_appender appender, FUN &&function) {
+	auto wrapper = (AppenderWrapper *)appender;
+	if (!wrapper) {
+		return DuckDBError;
+	}
+	if (!wrapper->appender) {
+		wrapper->error = "The appender has not been created";
+		return DuckDBError;
+	}
+	try {
+		function(*wrapper->appender);
+	} catch (std::exception &ex) {
+		wrapper->error = ex.what();
+		return DuckDBError;
+	} catch (...) {
+		wrapper->error = "Unknown appender error";
+		return DuckDBError;
+	}
+	return DuckDBSuccess;
+}
+
+duckdb_state duckdb_appender_begin_row(duckdb_appender appender) {
+	return duckdb_appender_run_function(appender, [&](Appender &app) { app.BeginRow(); });
+}
+
+duckdb_state duckdb_appender_end_row(duckdb_appender appender) {
+	return duckdb_appender_run_function(appender, [&](Appender &app) { app.EndRow(); });
+}
+
+template <class T> static duckdb_state duckdb_append_internal(duckdb_appender appender, T value) {
+	return duckdb_appender_run_function(appender, [&](Appender &app) { app.Append<T>(value); });
+}
+
+duckdb_state duckdb_append_bool(duckdb_appender appender, bool value) {
+	return duckdb_append_internal<bool>(appender, value);
+}
+
+duckdb_state duckdb_append_int8(duckdb_appender appender, int8_t value) {
+	return duckdb_append_internal<int8_t>(appender, value);
+}
+
+duckdb_state duckdb_append_int16(duckdb_appender appender, int16_t value) {
+	return duckdb_append_internal<int16_t>(appender, value);
+}
+
+duckdb_state duckdb_append_int32(duckdb_appender appender, int32_t value) {
+	return duckdb_append_internal<int32_t>(appender, value);
+}
+
+duckdb_state duckdb_append_int64(duckdb_appender appender, int64_t value) {
+	return duckdb_append_internal<int64_t>(appender, value);
+}
+
+duckdb_state duckdb_append_float(duckdb_appender appender, float value) {
+	return duckdb_append_internal<float>(appender, value);
+}
+
+duckdb_state duckdb_append_double(duckdb_appender appender, double value) {
+	return duckdb_append_internal<double>(appender, value);
+}
+
+duckdb_state duckdb_append_varchar(duckdb_appender appender, const char *val) {
+	if (!val) {
+		return duckdb_append_null(appender);
+	}
+	return duckdb_append_internal<const char *>(appender, val);
+}
+
+duckdb_state duckdb_append_varchar_length(duckdb_appender appender, const char *val, idx_t length) {
+	return duckdb_appender_run_function(appender, [&](Appender &app) { app.Append(val, length); });
+}
+
+duckdb_state duckdb_append_null(duckdb_appender appender) {
+	return duckdb_append_internal<std::nullptr_t>(appender, nullptr);
+}
+
+duckdb_state duckdb_appender_append_columns(duckdb_appender appender, duckdb_column_array *columns, idx_t count) {
+	return duckdb_appender_run_function(appender, [&](Appender &app) {
+		auto &append_chunk = app.GetAppendChunk();
+		if (!columns || !VerifyColumnArrays(columns, append_chunk.column_count())) {
+			throw InvalidInputException("Unsupported or missing column array for appender");
+		}
+		DataChunk chunk;
+		auto types = append_chunk.GetTypes();
+		chunk.Initialize(types);
+		for (idx_t offset = 0; offset < count; offset += STANDARD_VECTOR_SIZE) {
+			idx_t next = MinValue<idx_t>(STANDARD_VECTOR_SIZE, count - offset);
+			ConvertColumnArrays(columns, offset, next, chunk);
+			app.AppendChunk(chunk);
+		}
+	});
+}
+
+duckdb_state duckdb_appender_flush(duckdb_appender appender) {
+	return duckdb_appender_run_function(appender, [&](Appender &app) { app.Flush(); });
+}
+
+duckdb_state duckdb_appender_close(duckdb_appender appender) {
+	return duckdb_appender_run_function(appender, [&](Appender &app) { app.Close(); });
+}
+
+duckdb_state duckdb_appender_destroy(duckdb_appender *appender) {
+	if (!appender || !*appender) {
+		return DuckDBError;
+	}
+	auto wrapper = (AppenderWrapper *)*appender;
+	auto state = wrapper->appender ? duckdb_appender_close(*appender) : DuckDBSuccess;
+	delete wrapper;
+	*appender = nullptr;
+	return state;
+}
+
 duckdb_type ConvertCPPTypeToC(LogicalType sql_type) {
 	switch (sql_type.id()) {
 	case LogicalTypeId::BOOLEAN:
@@ -444,6 +889,32 @@ duckdb_type ConvertCPPTypeToC(LogicalType sql_type) {
 	}
 }
 
+LogicalType ConvertCArrayTypeToCPP(duckdb_type type) {
+	switch (type) {
+	case DUCKDB_TYPE_BOOLEAN:
+		return LogicalType::BOOLEAN;
+	case DUCKDB_TYPE_TINYINT:
+		return LogicalType::TINYINT;
+	case DUCKDB_TYPE_SMALLINT:
+		return LogicalType::SMALLINT;
+	case DUCKDB_TYPE_INTEGER:
+		return LogicalType::INTEGER;
+	case DUCKDB_TYPE_BIGINT:
+		return LogicalType::BIGINT;
+	case DUCKDB_TYPE_HUGEINT:
+		return LogicalType::HUGEINT;
+	case DUCKDB_TYPE_FLOAT:
+		return LogicalType::FLOAT;
+	case DUCKDB_TYPE_DOUBLE:
+		return LogicalType::DOUBLE;
+	case DUCKDB_TYPE_VARCHAR:
+		return LogicalType::VARCHAR;
+	default:
+		// only types with the same representation in C and C++ (and strings) can be passed as arrays
+		return LogicalType::INVALID;
+	}
+}
+
 idx_t GetCTypeSize(duckdb_type type) {
 	switch (type) {
 	case DUCKDB_TYPE_BOOLEAN:
@@ -0,0 +1,111 @@
+#include "duckdb/main/plan_cache.hpp"
+
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/function/table/table_scan.hpp"
+#include "duckdb/main/prepared_statement_data.hpp"
+#include "duckdb/planner/expression/bound_aggregate_expression.hpp"
+#include "duckdb/planner/expression/bound_function_expression.hpp"
+#include "duckdb/planner/logical_operator_visitor.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+
+using namespace std;
+
+namespace duckdb {
+
+PlanCache::PlanCache(Catalog &catalog, idx_t capacity) : catalog(catalog), capacity(capacity) {
+}
+
+PlanCache::~PlanCache() {
+}
+
+unique_ptr<PreparedStatementData> PlanCache::Lookup(const string &query) {
+	unique_ptr<PreparedStatementData> result;
+	{
+		lock_guard<mutex> guard(cache_lock);
+		auto entry = plans.find(query);
+		if (entry == plans.end()) {
+			return nullptr;
+		}
+		result = move(entry->second.plan);
+		lru.erase(entry->second.lru_position);
+		plans.erase(entry);
+	}
+	if (result->catalog_version != catalog.GetCatalogVersion()) {
+		// the catalog has changed since the plan was created: the plan is stale
+		return nullptr;
+	}
+	return result;
+}
+
+void PlanCache::Insert(const string &query, unique_ptr<PreparedStatementData> plan) {
+	assert(plan && plan->cacheable);
+	if (capacity == 0 || plan->catalog_version != catalog.GetCatalogVersion()) {
+		return;
+	}
+	// evicted plans are destroyed after releasing the lock
+	unique_ptr<PreparedStatementData> evicted_plan;
+	lock_guard<mutex> guard(cache_lock);
+	if (plans.find(query) != plans.end()) {
+		// a different connection has added a plan of the query in the meantime
+		return;
+	}
+	if (plans.size() >= capacity) {
+		// evict the least recently used plan
+		auto entry = plans.find(lru.back());
+		evicted_plan = move(entry->second.plan);
+		plans.erase(entry);
+		lru.pop_back();
+	}
+	lru.push_front(query);
+	auto &entry = plans[query];
+	entry.plan = move(plan);
+	entry.lru_position = lru.begin();
+}
+
+//! Functions that return the current time are folded into constants by the optimizer, so their plans cannot be reused
+static bool ReadsCurrentTime(const string &function_name) {
+	return function_name == "now" || function_name == "current_timestamp" || function_name == "current_time" ||
+	       function_name == "current_date" || function_name == "age";
+}
+
+class CacheablePlanVerifier : public LogicalOperatorVisitor {
+public:
+	bool cacheable = true;
+
+	void VisitOperator(LogicalOperator &op) override {
+		if (op.type == LogicalOperatorType::GET) {
+			auto &get = (LogicalGet &)op;
+			// index scans look up the row ids of the matching rows when the plan is optimized
+			if (get.function.name != "seq_scan" || ((TableScanBindData &)*get.bind_data).is_index_scan) {
+				cacheable = false;
+			}
+		}
+		if (op.type == LogicalOperatorType::RECURSIVE_CTE) {
+			// the recursive CTE keeps its working tables and pipelines in the physical operator
+			cacheable = false;
+		}
+		LogicalOperatorVisitor::VisitOperator(op);
+	}
+
+protected:
+	unique_ptr<Expression> VisitReplace(BoundAggregateExpression &expr, unique_ptr<Expression> *expr_ptr) override {
+		if (expr.function.has_side_effects) {
+			cacheable = false;
+		}
+		return nullptr;
+	}
+	unique_ptr<Expression> VisitReplace(BoundFunctionExpression &expr, unique_ptr<Expression> *expr_ptr) override {
+		if (expr.function.has_side_effects || ReadsCurrentTime(expr.function.name)) {
+			cacheable = false;
+		}
+		return nullptr;
+	}
+};
+
+bool PlanCache::CanCache(LogicalOperator &plan) {
+	CacheablePlanVerifier verifier;
+	verifier.VisitOperator(plan);
+	return verifier.cacheable;
+}
+
+} // namespace duckdb
@@ -5,7 +5,7 @@ namespace duckdb {
 using namespace std;
 
 PreparedStatementData::PreparedStatementData(StatementType type)
-    : statement_type(type), read_only(true), requires_valid_transaction(true) {
+    : statement_type(type), read_only(true), requires_valid_transaction(true), catalog_version(0), cacheable(false) {
 }
 
 PreparedStatementData::~PreparedStatementData() {
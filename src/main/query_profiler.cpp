@@ -9,8 +9,10 @@
 #include "duckdb/parser/sql_statement.hpp"
 #include "duckdb/common/printer.hpp"
 #include "duckdb/common/limits.hpp"
+#include "duckdb/main/client_context.hpp"
 
 #include <iostream>
+#include <thread>
 #include <utility>
 #include <algorithm>
 
@@ -22,7 +24,7 @@ constexpr idx_t TREE_RENDER_WIDTH = 20;
 constexpr idx_t REMAINING_RENDER_WIDTH = TREE_RENDER_WIDTH - 2;
 constexpr idx_t MAX_EXTRA_LINES = 10;
 
-void QueryProfiler::StartQuery(string query, SQLStatement &statement) {
+void QueryProfiler::StartQuery(string query) {
 	if (!enabled) {
 		return;
 	}
@@ -32,6 +34,12 @@ void QueryProfiler::StartQuery(string query, SQLStatement &statement) {
 	root = nullptr;
 	phase_timings.clear();
 	phase_stack.clear();
+	pipeline_map.clear();
+	pipeline_timings.clear();
+	thread_map.clear();
+
+	start_statistics = BufferManager::GetBufferManager(context).GetStatistics();
+	query_statistics = BufferManagerStatistics();
 
 	main_query.Start();
 }
@@ -78,6 +86,8 @@ void QueryProfiler::EndQuery() {
 	}
 
 	main_query.End();
+	// note that the buffer manager is shared between all connections: concurrently running queries are included
+	query_statistics = BufferManager::GetBufferManager(context).GetStatistics().Subtract(start_statistics);
 	this->running = false;
 	// print or output the query profiling after termination, if this is enabled
 	if (automatic_print_format != ProfilerPrintFormat::NONE) {
@@ -158,11 +168,41 @@ void QueryProfiler::Initialize(PhysicalOperator *root_op) {
 	}
 }
 
-OperatorProfiler::OperatorProfiler(bool enabled_) : enabled(enabled_) {
+OperatorProfiler::OperatorProfiler(bool enabled_, idx_t sample_rate_)
+    : enabled(enabled_ && sample_rate_ == 0), task_sink(nullptr), sample_rate(sample_rate_), sample_counter(0),
+      sample_current(false), sample_depth(0) {
 	execution_stack = stack<PhysicalOperator *>();
+	if (sample_rate > 0) {
+		sampled_timings = unique_ptr<SampledOperatorTiming[]>(new SampledOperatorTiming[SAMPLED_OPERATOR_TYPES]);
+	}
+}
+
+void OperatorProfiler::StartTask(PhysicalOperator *sink, string pipeline_name, double wait_time) {
+	if (!enabled) {
+		return;
+	}
+	task_sink = sink;
+	task_pipeline = move(pipeline_name);
+	task_timing = PipelineThreadTimingInformation();
+	task_timing.tasks = 1;
+	task_timing.wait_time = wait_time;
+	task.Start();
+}
+
+void OperatorProfiler::EndTask(idx_t elements) {
+	if (!enabled || !task_sink) {
+		return;
+	}
+	task.End();
+	task_timing.time = task.Elapsed();
+	task_timing.elements = elements;
 }
 
 void OperatorProfiler::StartOperator(PhysicalOperator *phys_op) {
+	if (sample_rate > 0) {
+		StartSample(phys_op);
+		return;
+	}
 	if (!enabled) {
 		return;
 	}
@@ -181,6 +221,10 @@ void OperatorProfiler::StartOperator(PhysicalOperator *phys_op) {
 }
 
 void OperatorProfiler::EndOperator(DataChunk *chunk) {
+	if (sample_rate > 0) {
+		EndSample(chunk);
+		return;
+	}
 	if (!enabled) {
 		return;
 	}
@@ -199,6 +243,49 @@ void OperatorProfiler::EndOperator(DataChunk *chunk) {
 	}
 }
 
+void OperatorProfiler::StartSample(PhysicalOperator *phys_op) {
+	auto depth = sample_depth++;
+	if (depth == 0) {
+		// the outermost operator decides whether or not the chunk flowing through the operators is sampled
+		sample_counter++;
+		sample_current = sample_counter >= sample_rate;
+		if (sample_current) {
+			sample_counter = 0;
+		}
+	}
+	if (depth >= SAMPLE_MAX_DEPTH) {
+		return;
+	}
+	auto &entry = sample_stack[depth];
+	entry.type = phys_op->type;
+	if (sample_current) {
+		entry.child_cycles = 0;
+		entry.start = CycleCounter::Tick();
+	}
+}
+
+void OperatorProfiler::EndSample(DataChunk *chunk) {
+	assert(sample_depth > 0);
+	auto depth = --sample_depth;
+	if (depth >= SAMPLE_MAX_DEPTH) {
+		return;
+	}
+	auto &entry = sample_stack[depth];
+	auto &timing = sampled_timings[(uint8_t)entry.type];
+	timing.chunks++;
+	timing.elements += chunk ? chunk->size() : 0;
+	if (!sample_current) {
+		return;
+	}
+	uint64_t elapsed = CycleCounter::Tick() - entry.start;
+	timing.sampled_chunks++;
+	timing.sampled_cycles += elapsed > entry.child_cycles ? elapsed - entry.child_cycles : 0;
+	if (depth > 0) {
+		// the time spent in this operator is excluded from the timing of the parent
+		sample_stack[depth - 1].child_cycles += elapsed;
+	}
+}
+
 void OperatorProfiler::AddTiming(PhysicalOperator *op, double time, idx_t elements) {
 	auto entry = timings.find(op);
 	if (entry == timings.end()) {
@@ -212,6 +299,27 @@ void OperatorProfiler::AddTiming(PhysicalOperator *op, double time, idx_t elemen
 }
 
 void QueryProfiler::Flush(OperatorProfiler &profiler) {
+	lock_guard<mutex> guard(flush_lock);
+	if (profiler.sampled_timings) {
+		// add the sampled timings to the aggregated timings of the connection
+		if (!sampled_timings) {
+			sampled_timings = unique_ptr<SampledOperatorTiming[]>(
+			    new SampledOperatorTiming[OperatorProfiler::SAMPLED_OPERATOR_TYPES]);
+		}
+		for (idx_t i = 0; i < OperatorProfiler::SAMPLED_OPERATOR_TYPES; i++) {
+			auto &source = profiler.sampled_timings[i];
+			auto &target = sampled_timings[i];
+			target.chunks += source.chunks;
+			target.elements += source.elements;
+			target.sampled_chunks += source.sampled_chunks;
+			target.sampled_cycles += source.sampled_cycles;
+		}
+		return;
+	}
+	if (!enabled || !running) {
+		// the query is not being profiled
+		return;
+	}
 	for (auto &node : profiler.timings) {
 		auto entry = tree_map.find(node.first);
 		assert(entry != tree_map.end());
@@ -219,6 +327,81 @@ void QueryProfiler::Flush(OperatorProfiler &profiler) {
 		entry->second->info.time += node.second.time;
 		entry->second->info.elements += node.second.elements;
 	}
+	if (!profiler.task_sink) {
+		return;
+	}
+	// add the task timing to the pipeline, broken down by the thread that executed the task
+	auto thread_id = std::hash<std::thread::id>()(std::this_thread::get_id());
+	auto thread_entry = thread_map.find(thread_id);
+	idx_t thread_index;
+	if (thread_entry == thread_map.end()) {
+		thread_index = thread_map.size();
+		thread_map[thread_id] = thread_index;
+	} else {
+		thread_index = thread_entry->second;
+	}
+	auto pipeline_entry = pipeline_map.find(profiler.task_sink);
+	idx_t pipeline_index;
+	if (pipeline_entry == pipeline_map.end()) {
+		pipeline_index = pipeline_timings.size();
+		pipeline_map[profiler.task_sink] = pipeline_index;
+		pipeline_timings.emplace_back();
+		pipeline_timings.back().name = profiler.task_pipeline;
+	} else {
+		pipeline_index = pipeline_entry->second;
+	}
+	auto &threads = pipeline_timings[pipeline_index].threads;
+	if (thread_index >= threads.size()) {
+		threads.resize(thread_index + 1);
+	}
+	auto &timing = threads[thread_index];
+	timing.tasks += profiler.task_timing.tasks;
+	timing.time += profiler.task_timing.time;
+	timing.wait_time += profiler.task_timing.wait_time;
+	timing.elements += profiler.task_timing.elements;
+}
+
+void QueryProfiler::EnableSampling(idx_t sample_rate) {
+	if (sample_rate == 0) {
+		throw InvalidInputException("Sample rate of the sampling profiler must be at least 1");
+	}
+	this->sample_rate = sample_rate;
+}
+
+void QueryProfiler::DisableSampling() {
+	sample_rate = 0;
+}
+
+vector<std::pair<PhysicalOperatorType, SampledOperatorTiming>> QueryProfiler::GetSampledTimings() {
+	lock_guard<mutex> guard(flush_lock);
+	vector<std::pair<PhysicalOperatorType, SampledOperatorTiming>> result;
+	if (!sampled_timings) {
+		return result;
+	}
+	for (idx_t i = 0; i < OperatorProfiler::SAMPLED_OPERATOR_TYPES; i++) {
+		if (sampled_timings[i].chunks > 0) {
+			result.push_back(make_pair((PhysicalOperatorType)i, sampled_timings[i]));
+		}
+	}
+	return result;
+}
+
+void QueryProfiler::ResetSampledTimings() {
+	lock_guard<mutex> guard(flush_lock);
+	sampled_timings.reset();
+}
+
+void QueryProfiler::SetHashTableSize(PhysicalOperator *op, idx_t entries, idx_t size) {
+	if (!enabled || !running) {
+		return;
+	}
+	lock_guard<mutex> guard(flush_lock);
+	auto entry = tree_map.find(op);
+	if (entry == tree_map.end()) {
+		return;
+	}
+	entry->second->info.hash_table_entries = entries;
+	entry->second->info.hash_table_size = size;
 }
 
 string QueryProfiler::ToString() const {
@@ -238,6 +421,30 @@ string QueryProfiler::ToString() const {
 	for (const auto &entry : GetOrderedPhaseTimings()) {
 		result += entry.first + ": " + to_string(entry.second) + "s\n";
 	}
+	// print the buffer manager counters
+	result += "<<Buffer Manager>>\n";
+	result += "Pins: " + to_string(query_statistics.pins) + " (" + to_string(query_statistics.misses) + " misses)\n";
+	result += "Evictions: " + to_string(query_statistics.evictions) + "\n";
+	result += "Bytes Read: " + to_string(query_statistics.bytes_read) + "\n";
+	result += "Bytes Written: " + to_string(query_statistics.bytes_written) + "\n";
+	result += "Bytes Allocated: " + to_string(query_statistics.bytes_allocated) + "\n";
+	// print the pipeline timings
+	result += "<<Pipelines>>\n";
+	for (auto &pipeline : pipeline_timings) {
+		PipelineThreadTimingInformation total;
+		idx_t thread_count = 0;
+		for (auto &timing : pipeline.threads) {
+			if (timing.tasks == 0) {
+				continue;
+			}
+			thread_count++;
+			total.tasks += timing.tasks;
+			total.time += timing.time;
+			total.wait_time += timing.wait_time;
+		}
+		result += pipeline.name + ": " + to_string(total.time) + "s (" + to_string(total.tasks) + " tasks on " +
+		          to_string(thread_count) + " threads, " + to_string(total.wait_time) + "s waiting)\n";
+	}
 	// render the main operator tree
 	result += "<<Operator Tree>>\n";
 	if (!root) {
@@ -252,6 +459,10 @@ static string ToJSONRecursive(QueryProfiler::TreeNode &node) {
 	string result = "{ \"name\": \"" + node.name + "\",\n";
 	result += "\"timing\":" + StringUtil::Format("%.2f", node.info.time) + ",\n";
 	result += "\"cardinality\":" + to_string(node.info.elements) + ",\n";
+	if (node.info.hash_table_size > 0) {
+		result += "\"hash_table_entries\":" + to_string(node.info.hash_table_entries) + ",\n";
+		result += "\"hash_table_size\":" + to_string(node.info.hash_table_size) + ",\n";
+	}
 	result += "\"extra_info\": \"" + StringUtil::Replace(node.extra_info, "\n", "\\n") + "\",\n";
 	result += "\"children\": [";
 	result +=
@@ -261,6 +472,27 @@ static string ToJSONRecursive(QueryProfiler::TreeNode &node) {
 	return result;
 }
 
+static string PipelineToJSON(const PipelineTimingInformation &pipeline) {
+	string result = "{ \"name\": \"" + pipeline.name + "\",\n";
+	result += "\"threads\": [";
+	vector<string> thread_results;
+	for (idx_t i = 0; i < pipeline.threads.size(); i++) {
+		auto &timing = pipeline.threads[i];
+		if (timing.tasks == 0) {
+			continue;
+		}
+		string thread_result = "{ \"thread\": " + to_string(i) + ", ";
+		thread_result += "\"tasks\": " + to_string(timing.tasks) + ", ";
+		thread_result += "\"timing\": " + StringUtil::Format("%.4f", timing.time) + ", ";
+		thread_result += "\"wait_time\": " + StringUtil::Format("%.4f", timing.wait_time) + ", ";
+		thread_result += "\"cardinality\": " + to_string(timing.elements) + " }";
+		thread_results.push_back(thread_result);
+	}
+	result += StringUtil::Join(thread_results, ",\n");
+	result += "]\n}";
+	return result;
+}
+
 string QueryProfiler::ToJSON() const {
 	if (!enabled) {
 		return "{ \"result\": \"disabled\" }\n";
@@ -280,6 +512,19 @@ string QueryProfiler::ToJSON() const {
 		    return "\"" + entry.first + "\": " + to_string(entry.second);
 	    });
 	result += "},\n";
+	// print the buffer manager counters
+	result += "\"buffer_manager\": {\n";
+	result += "\"pins\": " + to_string(query_statistics.pins) + ",\n";
+	result += "\"misses\": " + to_string(query_statistics.misses) + ",\n";
+	result += "\"evictions\": " + to_string(query_statistics.evictions) + ",\n";
+	result += "\"bytes_read\": " + to_string(query_statistics.bytes_read) + ",\n";
+	result += "\"bytes_written\": " + to_string(query_statistics.bytes_written) + ",\n";
+	result += "\"bytes_allocated\": " + to_string(query_statistics.bytes_allocated) + "\n";
+	result += "},\n";
+	// print the pipeline timings, broken down per thread
+	result += "\"pipelines\": [";
+	result += StringUtil::Join(pipeline_timings, pipeline_timings.size(), ",\n", PipelineToJSON);
+	result += "],\n";
 	// recursively print the physical operator tree
 	result += "\"tree\": ";
 	result += ToJSONRecursive(*root);
@@ -55,7 +55,7 @@ void StreamQueryResult::Close() {
 	if (!is_open) {
 		return;
 	}
-	context.Cleanup();
+	context.CleanupResult();
 }
 
 } // namespace duckdb
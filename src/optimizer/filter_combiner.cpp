@@ -3,6 +3,8 @@
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/planner/expression/bound_between_expression.hpp"
 #include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
 #include "duckdb/planner/expression/bound_constant_expression.hpp"
 #include "duckdb/planner/expression/bound_function_expression.hpp"
 #include "duckdb/planner/operator/logical_empty_result.hpp"
@@ -155,6 +157,183 @@ bool FilterCombiner::HasFilters() {
 	return has_filters;
 }
 
+static bool IsPushdownType(const LogicalType &type) {
+	return TypeIsNumeric(type.InternalType()) || type.InternalType() == PhysicalType::VARCHAR;
+}
+
+static bool HasTableFilter(vector<TableFilter> &table_filters, idx_t column_index) {
+	for (auto &table_filter : table_filters) {
+		if (table_filter.column_index == column_index) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//! Checks if the expression is a reference to the column "column_ref"; if "column_ref" is not set yet it is set to the
+//! expression if the expression is a column reference
+static bool MatchColumn(Expression &expr, BoundColumnRefExpression *&column_ref) {
+	if (expr.type != ExpressionType::BOUND_COLUMN_REF) {
+		return false;
+	}
+	auto &ref = (BoundColumnRefExpression &)expr;
+	if (!column_ref) {
+		column_ref = &ref;
+		return true;
+	}
+	return ref.binding == column_ref->binding;
+}
+
+static bool MatchConstant(Expression &expr, BoundColumnRefExpression &column_ref, Value &constant) {
+	if (expr.type != ExpressionType::VALUE_CONSTANT) {
+		return false;
+	}
+	constant = ((BoundConstantExpression &)expr).value;
+	return !constant.is_null && constant.type() == column_ref.return_type;
+}
+
+//! Computes the range [lower, upper] of the values of a single column that can satisfy the expression. Returns false
+//! if the expression is not a constant bound on a single column. Bounds that are not restricted by the expression are
+//! left as NULL.
+static bool ExtractColumnRange(Expression &expr, BoundColumnRefExpression *&column_ref, Value &lower, Value &upper) {
+	switch (expr.GetExpressionClass()) {
+	case ExpressionClass::BOUND_COMPARISON: {
+		auto &comparison = (BoundComparisonExpression &)expr;
+		auto comparison_type = comparison.type;
+		Expression *constant_expr;
+		if (MatchColumn(*comparison.left, column_ref)) {
+			constant_expr = comparison.right.get();
+		} else if (MatchColumn(*comparison.right, column_ref)) {
+			constant_expr = comparison.left.get();
+			comparison_type = FlipComparisionExpression(comparison_type);
+		} else {
+			return false;
+		}
+		Value constant;
+		if (!MatchConstant(*constant_expr, *column_ref, constant)) {
+			return false;
+		}
+		switch (comparison_type) {
+		case ExpressionType::COMPARE_EQUAL:
+			lower = constant;
+			upper = constant;
+			return true;
+		case ExpressionType::COMPARE_GREATERTHAN:
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			lower = constant;
+			return true;
+		case ExpressionType::COMPARE_LESSTHAN:
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			upper = constant;
+			return true;
+		default:
+			return false;
+		}
+	}
+	case ExpressionClass::BOUND_BETWEEN: {
+		auto &between = (BoundBetweenExpression &)expr;
+		if (!MatchColumn(*between.input, column_ref)) {
+			return false;
+		}
+		return MatchConstant(*between.lower, *column_ref, lower) && MatchConstant(*between.upper, *column_ref, upper);
+	}
+	case ExpressionClass::BOUND_CONJUNCTION: {
+		auto &conjunction = (BoundConjunctionExpression &)expr;
+		if (conjunction.type != ExpressionType::CONJUNCTION_AND) {
+			return false;
+		}
+		// every child restricts the range: keep the tightest bounds
+		for (auto &child : conjunction.children) {
+			Value child_lower, child_upper;
+			if (!ExtractColumnRange(*child, column_ref, child_lower, child_upper)) {
+				return false;
+			}
+			if (!child_lower.is_null && (lower.is_null || child_lower > lower)) {
+				lower = child_lower;
+			}
+			if (!child_upper.is_null && (upper.is_null || child_upper < upper)) {
+				upper = child_upper;
+			}
+		}
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+//! Pushes a [lower, upper] range filter on a column into the set of table filters
+static void PushRangeFilter(vector<TableFilter> &table_filters, idx_t column_index, Value lower, Value upper) {
+	if (!lower.is_null && !upper.is_null && lower == upper) {
+		table_filters.push_back(TableFilter(lower, ExpressionType::COMPARE_EQUAL, column_index));
+		return;
+	}
+	// the lower bound has to come before the upper bound
+	if (!lower.is_null) {
+		table_filters.push_back(TableFilter(lower, ExpressionType::COMPARE_GREATERTHANOREQUALTO, column_index));
+	}
+	if (!upper.is_null) {
+		table_filters.push_back(TableFilter(upper, ExpressionType::COMPARE_LESSTHANOREQUALTO, column_index));
+	}
+}
+
+//! Computes the range of the values of a single column that can satisfy an IN list or a disjunction of ranges.
+//! Returns false if the expression is not of that form or does not bound the column.
+static bool ExtractDisjunctionRange(Expression &expr, BoundColumnRefExpression *&column_ref, Value &lower,
+                                    Value &upper) {
+	if (expr.type == ExpressionType::COMPARE_IN) {
+		auto &in_expr = (BoundOperatorExpression &)expr;
+		if (!MatchColumn(*in_expr.children[0], column_ref)) {
+			return false;
+		}
+		for (idx_t i = 1; i < in_expr.children.size(); i++) {
+			Value constant;
+			if (!MatchConstant(*in_expr.children[i], *column_ref, constant)) {
+				if (in_expr.children[i]->type == ExpressionType::VALUE_CONSTANT &&
+				    ((BoundConstantExpression &)*in_expr.children[i]).value.is_null) {
+					// NULL values in the IN list never match
+					continue;
+				}
+				return false;
+			}
+			if (lower.is_null || constant < lower) {
+				lower = constant;
+			}
+			if (upper.is_null || constant > upper) {
+				upper = constant;
+			}
+		}
+		return !lower.is_null;
+	}
+	if (expr.type == ExpressionType::CONJUNCTION_OR) {
+		// the range of a disjunction is the union of the ranges of its children
+		auto &conjunction = (BoundConjunctionExpression &)expr;
+		bool has_lower = true, has_upper = true;
+		for (auto &child : conjunction.children) {
+			Value child_lower, child_upper;
+			if (!ExtractColumnRange(*child, column_ref, child_lower, child_upper)) {
+				return false;
+			}
+			has_lower = has_lower && !child_lower.is_null;
+			has_upper = has_upper && !child_upper.is_null;
+			if (has_lower && (lower.is_null || child_lower < lower)) {
+				lower = child_lower;
+			}
+			if (has_upper && (upper.is_null || child_upper > upper)) {
+				upper = child_upper;
+			}
+		}
+		if (!has_lower) {
+			lower = Value();
+		}
+		if (!has_upper) {
+			upper = Value();
+		}
+		return !lower.is_null || !upper.is_null;
+	}
+	return false;
+}
+
 vector<TableFilter> FilterCombiner::GenerateTableScanFilters(vector<idx_t> &column_ids) {
 	vector<TableFilter> tableFilters;
 	//! First, we figure the filters that have constant expressions that we can push down to the table scan
@@ -251,6 +430,41 @@ vector<TableFilter> FilterCombiner::GenerateTableScanFilters(vector<idx_t> &colu
 			}
 		}
 	}
+	//! IN lists and disjunctions of ranges on a single column: push the range that encloses all of them into the scan
+	//! to skip data, the original filter is still evaluated afterwards
+	for (auto &remaining_filter : remaining_filters) {
+		BoundColumnRefExpression *column_ref = nullptr;
+		Value lower, upper;
+		if (!ExtractDisjunctionRange(*remaining_filter, column_ref, lower, upper)) {
+			continue;
+		}
+		auto column_index = column_ref->binding.column_index;
+		if (column_ids[column_index] == COLUMN_IDENTIFIER_ROW_ID || !IsPushdownType(column_ref->return_type) ||
+		    HasTableFilter(tableFilters, column_index)) {
+			continue;
+		}
+		PushRangeFilter(tableFilters, column_index, lower, upper);
+	}
+	//! IS NULL and IS NOT NULL on a column are evaluated entirely in the scan
+	for (idx_t i = 0; i < remaining_filters.size(); i++) {
+		auto &remaining_filter = remaining_filters[i];
+		if (remaining_filter->type != ExpressionType::OPERATOR_IS_NULL &&
+		    remaining_filter->type != ExpressionType::OPERATOR_IS_NOT_NULL) {
+			continue;
+		}
+		auto &null_expr = (BoundOperatorExpression &)*remaining_filter;
+		BoundColumnRefExpression *column_ref = nullptr;
+		if (!MatchColumn(*null_expr.children[0], column_ref)) {
+			continue;
+		}
+		auto column_index = column_ref->binding.column_index;
+		if (column_ids[column_index] == COLUMN_IDENTIFIER_ROW_ID || !IsPushdownType(column_ref->return_type)) {
+			continue;
+		}
+		tableFilters.push_back(TableFilter(Value(), remaining_filter->type, column_index));
+		remaining_filters.erase(remaining_filters.begin() + i);
+		i--;
+	}
 
 	return tableFilters;
 }
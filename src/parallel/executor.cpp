@@ -1,5 +1,6 @@
 #include "duckdb/execution/executor.hpp"
 
+#include "duckdb/execution/operator/aggregate/physical_hash_aggregate.hpp"
 #include "duckdb/execution/operator/helper/physical_execute.hpp"
 #include "duckdb/execution/operator/join/physical_delim_join.hpp"
 #include "duckdb/execution/operator/scan/physical_chunk_scan.hpp"
@@ -17,21 +18,22 @@ using namespace std;
 
 namespace duckdb {
 
-Executor::Executor(ClientContext &context) : context(context) {
+Executor::Executor(ClientContext &context) : context(context), physical_plan(nullptr) {
 }
 
 Executor::~Executor() {
 }
 
-void Executor::Initialize(unique_ptr<PhysicalOperator> plan) {
+void Executor::Initialize(PhysicalOperator *plan) {
 	Reset();
 
-	physical_plan = move(plan);
+	physical_plan = plan;
 	physical_state = physical_plan->GetOperatorState();
 
-	context.profiler.Initialize(physical_plan.get());
+	context.profiler.Initialize(physical_plan);
+	result_thread = make_unique<ThreadContext>(context);
 
-	BuildPipelines(physical_plan.get(), nullptr);
+	BuildPipelines(physical_plan, nullptr);
 
 	auto &scheduler = TaskScheduler::GetScheduler(context);
 	this->producer = scheduler.CreateProducer();
@@ -60,11 +62,33 @@ void Executor::Initialize(unique_ptr<PhysicalOperator> plan) {
 	}
 }
 
+//! Destroys the global sink states left in the operators of the plan by its last execution
+static void ResetSinkStates(PhysicalOperator &op) {
+	if (op.IsSink()) {
+		((PhysicalSink &)op).sink_state.reset();
+	}
+	if (op.type == PhysicalOperatorType::DELIM_JOIN) {
+		auto &delim_join = (PhysicalDelimJoin &)op;
+		ResetSinkStates(*delim_join.join);
+		ResetSinkStates(*delim_join.distinct);
+	} else if (op.type == PhysicalOperatorType::EXECUTE) {
+		ResetSinkStates(*((PhysicalExecute &)op).plan);
+	}
+	for (auto &child : op.children) {
+		ResetSinkStates(*child);
+	}
+}
+
 void Executor::Reset() {
+	if (physical_plan) {
+		// the plan can outlive this executor in the plan cache: its sink states refer to this client
+		ResetSinkStates(*physical_plan);
+	}
 	delim_join_dependencies.clear();
 	recursive_cte = nullptr;
 	physical_plan = nullptr;
 	physical_state = nullptr;
+	result_thread = nullptr;
 	completed_pipelines = 0;
 	total_pipelines = 0;
 	exceptions.clear();
@@ -168,9 +192,12 @@ void Executor::BuildPipelines(PhysicalOperator *op, Pipeline *parent) {
 				throw InternalException("Recursive CTE detected WITHIN a recursive CTE node");
 			}
 			recursive_cte = op;
+			// the pipelines of a previous execution of the plan belong to a different execution
+			auto &cte = (PhysicalRecursiveCTE &)*op;
+			cte.pipelines.clear();
 			BuildPipelines(op->children[1].get(), nullptr);
 			// finalize the pipelines: re-order them so that they are executed in the correct order
-			((PhysicalRecursiveCTE&) *op).FinalizePipelines();
+			cte.FinalizePipelines();
 
 			recursive_cte = nullptr;
 			return;
@@ -214,16 +241,20 @@ void Executor::Flush(ThreadContext &tcontext) {
 }
 
 unique_ptr<DataChunk> Executor::FetchChunk() {
-	assert(physical_plan);
+	assert(physical_plan && result_thread);
 
-	ThreadContext thread(context);
 	TaskContext task;
-	ExecutionContext econtext(context, thread, task);
+	ExecutionContext econtext(context, *result_thread, task);
 
 	auto chunk = make_unique<DataChunk>();
 	// run the plan to get the next chunks
 	physical_plan->InitializeChunk(*chunk);
 	physical_plan->GetChunk(econtext, *chunk, physical_state.get());
+	if (chunk->size() == 0) {
+		// the result is exhausted: flush the timings gathered while fetching it
+		Flush(*result_thread);
+		result_thread = make_unique<ThreadContext>(context);
+	}
 	return chunk;
 }
 
@@ -10,6 +10,12 @@
 #include "duckdb/execution/operator/aggregate/physical_simple_aggregate.hpp"
 #include "duckdb/execution/operator/scan/physical_table_scan.hpp"
 #include "duckdb/execution/operator/aggregate/physical_hash_aggregate.hpp"
+#include "duckdb/execution/operator/persistent/physical_copy_to_file.hpp"
+#include "duckdb/execution/operator/persistent/physical_insert.hpp"
+#include "duckdb/execution/operator/persistent/physical_update.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/storage/data_table.hpp"
+#include "duckdb/transaction/transaction.hpp"
 
 using namespace std;
 
@@ -18,6 +24,8 @@ namespace duckdb {
 class PipelineTask : public Task {
 public:
 	PipelineTask(Pipeline *pipeline_) : pipeline(pipeline_) {
+		task.scheduled = true;
+		task.queue_timer.Start();
 	}
 
 	TaskContext task;
@@ -25,6 +33,7 @@ public:
 
 public:
 	void Execute() override {
+		task.queue_timer.End();
 		pipeline->Execute(task);
 		pipeline->FinishTask();
 	}
@@ -43,6 +52,10 @@ void Pipeline::Execute(TaskContext &task) {
 
 	ThreadContext thread(client);
 	ExecutionContext context(client, thread, task);
+	if (thread.profiler.IsEnabled()) {
+		thread.profiler.StartTask(sink, ToString(), task.scheduled ? task.queue_timer.Elapsed() : 0);
+	}
+	idx_t sink_count = 0;
 	try {
 		auto state = child->GetOperatorState();
 		auto lstate = sink->GetLocalSinkState(context);
@@ -57,6 +70,7 @@ void Pipeline::Execute(TaskContext &task) {
 				break;
 			}
 			sink->Sink(context, *sink_state, *lstate, intermediate);
+			sink_count += intermediate.size();
 			thread.profiler.EndOperator(nullptr);
 		}
 	} catch (std::exception &ex) {
@@ -64,6 +78,7 @@ void Pipeline::Execute(TaskContext &task) {
 	} catch (...) {
 		executor.PushError("Unknown exception in pipeline!");
 	}
+	thread.profiler.EndTask(sink_count);
 	executor.Flush(thread);
 }
 
@@ -113,9 +128,10 @@ bool Pipeline::ScheduleOperator(PhysicalOperator *op) {
 			return false;
 		}
 		// after we have gathered all the tasks we actually schedule them for execution
-		for (auto &info : tasks) {
+		for (idx_t i = 0; i < tasks.size(); i++) {
 			auto task = make_unique<PipelineTask>(this);
-			task->task.task_info[op] = move(info);
+			task->task.task_info[op] = move(tasks[i]);
+			task->task.batch_index = i;
 			scheduler.ScheduleTask(*executor.producer, move(task));
 		}
 		return true;
@@ -168,6 +184,50 @@ void Pipeline::Schedule() {
 		}
 		break;
 	}
+	case PhysicalOperatorType::INSERT: {
+		auto &insert = (PhysicalInsert &)*sink;
+		// the parallel scan of the transaction local storage cannot run concurrently with appends to it
+		// only parallelize if this transaction has not yet made any local changes to the target table
+		auto &transaction = Transaction::GetTransaction(executor.context);
+		if (transaction.storage.HasStorage(insert.table->storage.get())) {
+			break;
+		}
+		if (ScheduleOperator(sink->children[0].get())) {
+			// all parallel tasks have been scheduled: return
+			return;
+		}
+		break;
+	}
+	case PhysicalOperatorType::UPDATE: {
+		auto &update = (PhysicalUpdate &)*sink;
+		if (update.is_index_update) {
+			// index updates are performed as a delete + append: switch to sequential mode
+			break;
+		}
+		auto &transaction = Transaction::GetTransaction(executor.context);
+		if (transaction.storage.HasStorage(&update.table)) {
+			// updates to the local storage cannot run concurrently with the scan of the local storage
+			break;
+		}
+		if (ScheduleOperator(sink->children[0].get())) {
+			// all parallel tasks have been scheduled: return
+			return;
+		}
+		break;
+	}
+	case PhysicalOperatorType::COPY_TO_FILE: {
+		auto &copy = (PhysicalCopyToFile &)*sink;
+		if (!copy.function.copy_to_combine) {
+			// the copy function has no way of finishing the output of a task: switch to sequential mode
+			break;
+		}
+		// the copy function orders the output of the tasks by their batch index
+		if (ScheduleOperator(sink->children[0].get())) {
+			// all parallel tasks have been scheduled: return
+			return;
+		}
+		break;
+	}
 	case PhysicalOperatorType::HASH_JOIN: {
 		// schedule build side of the join
 		if (ScheduleOperator(sink->children[1].get())) {
@@ -212,6 +272,9 @@ string Pipeline::ToString() const {
 	auto node = this->child;
 	while (node) {
 		str = PhysicalOperatorToString(node->type) + " -> " + str;
+		if (node->children.empty()) {
+			break;
+		}
 		node = node->children[0].get();
 	}
 	return str;
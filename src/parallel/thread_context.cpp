@@ -4,7 +4,8 @@
 
 namespace duckdb {
 
-ThreadContext::ThreadContext(ClientContext &context) : profiler(context.profiler.IsEnabled()) {
+ThreadContext::ThreadContext(ClientContext &context)
+    : profiler(context.profiler.IsEnabled(), context.profiler.SampleRate()) {
 }
 
 } // namespace duckdb
@@ -18,6 +18,7 @@ string ParameterExpression::ToString() const {
 unique_ptr<ParsedExpression> ParameterExpression::Copy() const {
 	auto copy = make_unique<ParameterExpression>();
 	copy->CopyProperties(*this);
+	copy->parameter_nr = parameter_nr;
 	return move(copy);
 }
 
@@ -0,0 +1,63 @@
+#include "duckdb/storage/buffer/memory_reservation.hpp"
+
+#include "duckdb/common/exception.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+
+namespace duckdb {
+using namespace std;
+
+MemoryReservation::MemoryReservation(ClientContext &context)
+    : context(context), buffer_manager(BufferManager::GetBufferManager(context)), size(0) {
+}
+
+MemoryReservation::~MemoryReservation() {
+	if (size > 0) {
+		context.query_memory_usage -= size;
+		buffer_manager.FreeReservedMemory(size);
+	}
+}
+
+bool MemoryReservation::TryResize(idx_t new_size) {
+	if (new_size <= size) {
+		// shrinking the reservation always succeeds
+		auto freed = size - new_size;
+		if (freed > 0) {
+			context.query_memory_usage -= freed;
+			buffer_manager.FreeReservedMemory(freed);
+		}
+		size = new_size;
+		return true;
+	}
+	auto additional = new_size - size;
+	// first account for the memory in the query
+	auto query_usage = context.query_memory_usage += additional;
+	if (query_usage > context.query_memory_limit) {
+		context.query_memory_usage -= additional;
+		return false;
+	}
+	// then reserve the memory in the buffer manager
+	if (!buffer_manager.TryReserveMemory(additional)) {
+		context.query_memory_usage -= additional;
+		return false;
+	}
+	size = new_size;
+	return true;
+}
+
+void MemoryReservation::Resize(idx_t new_size) {
+	if (TryResize(new_size)) {
+		return;
+	}
+	if (context.query_memory_usage + (new_size - size) > context.query_memory_limit) {
+		throw OutOfMemoryException("could not reserve %s for the query: query memory limit of %s exceeded",
+		                           StringUtil::FormatSize(new_size - size),
+		                           StringUtil::FormatSize(context.query_memory_limit));
+	}
+	throw OutOfMemoryException("could not reserve %s for the query: database memory limit of %s exceeded",
+	                           StringUtil::FormatSize(new_size - size),
+	                           StringUtil::FormatSize(buffer_manager.GetMaxMemory()));
+}
+
+} // namespace duckdb
@@ -22,6 +22,7 @@ BufferManager::~BufferManager() {
 unique_ptr<BufferHandle> BufferManager::Pin(block_id_t block_id, bool can_destroy) {
 	// first obtain a lock on the set of blocks
 	lock_guard<mutex> lock(block_lock);
+	statistics.pins++;
 	if (block_id < MAXIMUM_BLOCK) {
 		return PinBlock(block_id);
 	} else {
@@ -56,6 +57,8 @@ unique_ptr<BufferHandle> BufferManager::PinBlock(block_id_t block_id) {
 			block = make_unique<Block>(block_id);
 		}
 		manager.Read(*block);
+		statistics.misses++;
+		statistics.bytes_read += Storage::BLOCK_ALLOC_SIZE;
 		result_block = block.get();
 		// create a new buffer entry for this block and insert it into the block list
 		auto buffer_entry = make_unique<BufferEntry>(move(block));
@@ -107,17 +110,30 @@ void BufferManager::Unpin(block_id_t block_id) {
 	}
 }
 
-unique_ptr<Block> BufferManager::EvictBlock() {
+BufferEntry *BufferManager::GetEvictionCandidate() {
+	auto entry = lru.First();
 	if (temp_directory.empty()) {
-		throw Exception("Out-of-memory: cannot evict buffer because no temporary directory is specified!\nTo enable "
-		                "temporary buffer eviction set a temporary directory in the configuration");
+		// managed buffers would have to be written to the temporary directory: skip them
+		while (entry && entry->buffer->type != FileBufferType::BLOCK) {
+			entry = entry->next.get();
+		}
 	}
-	// pop the first entry from the lru list
-	auto entry = lru.Pop();
-	if (!entry) {
+	return entry;
+}
+
+unique_ptr<Block> BufferManager::EvictBlock() {
+	auto candidate = GetEvictionCandidate();
+	if (!candidate) {
+		if (temp_directory.empty()) {
+			throw Exception("Out-of-memory: cannot evict buffer because no temporary directory is specified!\nTo "
+			                "enable temporary buffer eviction set a temporary directory in the configuration");
+		}
 		throw Exception("Not enough memory to complete operation!");
 	}
+	// remove the entry from the lru list
+	auto entry = lru.Erase(candidate);
 	assert(entry->ref_count == 0);
+	statistics.evictions++;
 	// erase this identifier from the set of blocks
 	auto buffer = entry->buffer.get();
 	if (buffer->type == FileBufferType::BLOCK) {
@@ -156,6 +172,7 @@ unique_ptr<BufferHandle> BufferManager::Allocate(idx_t alloc_size, bool can_dest
 	auto buffer = make_unique<ManagedBuffer>(*this, alloc_size, can_destroy, temp_id);
 	auto managed_buffer = buffer.get();
 	current_memory += buffer->AllocSize();
+	statistics.bytes_allocated += buffer->AllocSize();
 	// create a new entry and append it to the used list
 	auto buffer_entry = make_unique<BufferEntry>(move(buffer));
 	blocks.insert(make_pair(temp_id, buffer_entry.get()));
@@ -198,6 +215,30 @@ void BufferManager::SetLimit(idx_t limit) {
 	maximum_memory = limit;
 }
 
+bool BufferManager::TryReserveMemory(idx_t size) {
+	lock_guard<mutex> lock(block_lock);
+	while (current_memory + size > maximum_memory) {
+		if (!GetEvictionCandidate()) {
+			// no blocks can be evicted to make room for the reservation
+			return false;
+		}
+		EvictBlock();
+	}
+	current_memory += size;
+	return true;
+}
+
+void BufferManager::FreeReservedMemory(idx_t size) {
+	lock_guard<mutex> lock(block_lock);
+	assert(current_memory >= size);
+	current_memory -= size;
+}
+
+BufferManagerStatistics BufferManager::GetStatistics() {
+	lock_guard<mutex> lock(block_lock);
+	return statistics;
+}
+
 unique_ptr<BufferHandle> BufferManager::PinBuffer(block_id_t buffer_id, bool can_destroy) {
 	assert(buffer_id >= MAXIMUM_BLOCK);
 	// check if we have this buffer here
@@ -233,6 +274,7 @@ void BufferManager::WriteTemporaryBuffer(ManagedBuffer &buffer) {
 	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE);
 	handle->Write(&buffer.size, sizeof(idx_t), 0);
 	buffer.Write(*handle, sizeof(idx_t));
+	statistics.bytes_written += sizeof(idx_t) + buffer.size;
 }
 
 unique_ptr<BufferHandle> BufferManager::ReadTemporaryBuffer(block_id_t id) {
@@ -252,6 +294,8 @@ unique_ptr<BufferHandle> BufferManager::ReadTemporaryBuffer(block_id_t id) {
 	// now allocate a buffer of this size and read the data into that buffer
 	auto buffer = make_unique<ManagedBuffer>(*this, alloc_size + Storage::BLOCK_HEADER_SIZE, false, id);
 	buffer->Read(*handle, sizeof(idx_t));
+	statistics.misses++;
+	statistics.bytes_read += sizeof(idx_t) + alloc_size;
 
 	auto managed_buffer = buffer.get();
 	current_memory += buffer->AllocSize();
@@ -24,9 +24,8 @@ void ColumnData::InitializeScan(ColumnScanState &state) {
 	state.initialized = false;
 }
 
-void ColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t vector_idx) {
-	idx_t row_idx = vector_idx * STANDARD_VECTOR_SIZE;
-	state.current = (ColumnSegment*) data.GetSegment(row_idx);
+void ColumnData::InitializeScanWithOffset(ColumnScanState &state, idx_t row_idx) {
+	state.current = (ColumnSegment *)data.GetSegment(row_idx);
 	state.vector_index = (row_idx - state.current->start) / STANDARD_VECTOR_SIZE;
 	state.initialized = false;
 }
@@ -56,6 +55,12 @@ void ColumnData::FilterScan(Transaction &transaction, ColumnScanState &state, Ve
 
 void ColumnData::Select(Transaction &transaction, ColumnScanState &state, Vector &result, SelectionVector &sel,
                         idx_t &approved_tuple_count, vector<TableFilter> &tableFilter) {
+	if (!state.current->CheckZonemap(state.vector_index, tableFilter)) {
+		// no tuple in this vector can pass the filter: skip it without pinning the block of the segment
+		approved_tuple_count = 0;
+		state.Next();
+		return;
+	}
 	if (!state.initialized) {
 		state.current->InitializeScan(state);
 		state.initialized = true;
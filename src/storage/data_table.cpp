@@ -3,6 +3,7 @@
 #include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
 #include "duckdb/common/exception.hpp"
 #include "duckdb/common/helper.hpp"
+#include "duckdb/common/types/chunk_collection.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
 #include "duckdb/execution/expression_executor.hpp"
 #include "duckdb/planner/constraints/list.hpp"
@@ -240,23 +241,19 @@ void DataTable::InitializeParallelScan(ClientContext &context, const vector<colu
 	idx_t PARALLEL_SCAN_VECTOR_COUNT = 100;
 	idx_t PARALLEL_SCAN_TUPLE_COUNT = STANDARD_VECTOR_SIZE * PARALLEL_SCAN_VECTOR_COUNT;
 
-	idx_t current_offset = 0;
 	// create parallel scans for the persistent rows
 	for (idx_t i = 0; i < persistent_manager->max_row; i += PARALLEL_SCAN_TUPLE_COUNT) {
 		idx_t current = i;
 		idx_t next = MinValue(i + PARALLEL_SCAN_TUPLE_COUNT, persistent_manager->max_row);
 
 		TableScanState state;
-		InitializeScanWithOffset(state, column_ids, table_filters, current_offset);
+		InitializeScanWithOffset(state, column_ids, table_filters, current);
 		state.current_persistent_row = current;
 		state.max_persistent_row = next;
 
-		callback(move(state));
-
-		current_offset += PARALLEL_SCAN_VECTOR_COUNT;
-	}
-	if (persistent_manager->max_row > 0) {
-		current_offset = (persistent_manager->max_row / STANDARD_VECTOR_SIZE) + 1;
+		if (!table_filters || CheckZonemapRange(state, *table_filters, next - current)) {
+			callback(move(state));
+		}
 	}
 	// now create parallel scans for the transient rows
 	if (context.force_parallelism) {
@@ -269,13 +266,14 @@ void DataTable::InitializeParallelScan(ClientContext &context, const vector<colu
 		idx_t next = MinValue(i + PARALLEL_SCAN_TUPLE_COUNT, transient_manager->max_row);
 
 		TableScanState state;
-		InitializeScanWithOffset(state, column_ids, table_filters, current_offset);
+		// the transient segments start directly after the persistent rows
+		InitializeScanWithOffset(state, column_ids, table_filters, persistent_manager->max_row + current);
 		state.current_transient_row = current;
 		state.max_transient_row = next;
 
-		callback(move(state));
-
-		current_offset += PARALLEL_SCAN_VECTOR_COUNT;
+		if (!table_filters || CheckZonemapRange(state, *table_filters, next - current)) {
+			callback(move(state));
+		}
 	}
 
 	// create a task for scanning the local data
@@ -353,6 +351,11 @@ bool DataTable::CheckZonemap(TableScanState &state, unordered_map<idx_t, vector<
                              idx_t &current_row) {
 	for (auto &table_filter : table_filters) {
 		for (auto &predicate_constant : table_filter.second) {
+			if (predicate_constant.comparison_type == ExpressionType::OPERATOR_IS_NULL ||
+			    predicate_constant.comparison_type == ExpressionType::OPERATOR_IS_NOT_NULL) {
+				// the segment statistics cannot be used to prune NULL filters
+				continue;
+			}
 			bool readSegment = true;
 
 			if (!state.column_scans[predicate_constant.column_index].segment_checked) {
@@ -430,6 +433,33 @@ bool DataTable::CheckZonemap(TableScanState &state, unordered_map<idx_t, vector<
 	return true;
 }
 
+bool DataTable::CheckZonemapRange(TableScanState &state, unordered_map<idx_t, vector<TableFilter>> &table_filters,
+                                  idx_t count) {
+	for (auto &table_filter : table_filters) {
+		// walk over the vectors of the column in the same way the scan would
+		auto &column_scan = state.column_scans[table_filter.first];
+		auto segment = column_scan.current;
+		auto vector_index = column_scan.vector_index;
+		bool read_range = false;
+		for (idx_t row = 0; row < count; row += STANDARD_VECTOR_SIZE) {
+			if (!segment || segment->CheckZonemap(vector_index, table_filter.second)) {
+				read_range = true;
+				break;
+			}
+			vector_index++;
+			if (vector_index * STANDARD_VECTOR_SIZE >= segment->count) {
+				segment = (ColumnSegment *)segment->next.get();
+				vector_index = 0;
+			}
+		}
+		if (!read_range) {
+			// none of the vectors can satisfy the filters on this column: the range can be skipped
+			return false;
+		}
+	}
+	return true;
+}
+
 bool DataTable::ScanBaseTable(Transaction &transaction, DataChunk &result, TableScanState &state,
                               const vector<column_t> &column_ids, idx_t &current_row, idx_t max_row, idx_t base_row,
                               VersionManager &manager, unordered_map<idx_t, vector<TableFilter>> &table_filters) {
@@ -479,6 +509,11 @@ bool DataTable::ScanBaseTable(Transaction &transaction, DataChunk &result, Table
 		for (idx_t i = 0; i < table_filters.size(); i++) {
 			auto tf_idx = state.adaptive_filter->permutation[i];
 			auto col_idx = column_ids[tf_idx];
+			if (approved_tuple_count == 0) {
+				// an earlier filter already eliminated all tuples: skip the remaining filter columns
+				state.column_scans[tf_idx].Next();
+				continue;
+			}
 			columns[col_idx]->Select(transaction, state.column_scans[tf_idx], result.data[tf_idx], sel,
 			                         approved_tuple_count, table_filters[tf_idx]);
 		}
@@ -489,7 +524,10 @@ bool DataTable::ScanBaseTable(Transaction &transaction, DataChunk &result, Table
 		for (idx_t i = 0; i < column_ids.size(); i++) {
 			if (table_filters.find(i) == table_filters.end()) {
 				auto column = column_ids[i];
-				if (column == COLUMN_IDENTIFIER_ROW_ID) {
+				if (approved_tuple_count == 0) {
+					// no tuples passed the filters: skip the vector without fetching any data
+					state.column_scans[i].Next();
+				} else if (column == COLUMN_IDENTIFIER_ROW_ID) {
 					assert(result.data[i].type.InternalType() == PhysicalType::INT64);
 					result.data[i].vector_type = VectorType::FLAT_VECTOR;
 					auto result_data = (int64_t *)FlatVector::GetData(result.data[i]);
@@ -636,10 +674,7 @@ void DataTable::VerifyAppendConstraints(TableCatalogEntry &table, DataChunk &chu
 	}
 }
 
-void DataTable::Append(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk) {
-	if (chunk.size() == 0) {
-		return;
-	}
+void DataTable::VerifyAppend(TableCatalogEntry &table, DataChunk &chunk) {
 	if (chunk.column_count() != table.columns.size()) {
 		throw CatalogException("Mismatch in column count for append");
 	}
@@ -651,12 +686,30 @@ void DataTable::Append(TableCatalogEntry &table, ClientContext &context, DataChu
 
 	// verify any constraints on the new chunk
 	VerifyAppendConstraints(table, chunk);
+}
+
+void DataTable::Append(TableCatalogEntry &table, ClientContext &context, DataChunk &chunk) {
+	if (chunk.size() == 0) {
+		return;
+	}
+	VerifyAppend(table, chunk);
 
 	// append to the transaction local data
 	auto &transaction = Transaction::GetTransaction(context);
 	transaction.storage.Append(this, chunk);
 }
 
+void DataTable::LocalAppend(ClientContext &context, ChunkCollection &collection) {
+	if (!is_root) {
+		throw TransactionException("Transaction conflict: adding entries to a table that has been altered!");
+	}
+	// the chunks have already been verified: append them to the transaction local data
+	auto &transaction = Transaction::GetTransaction(context);
+	for (auto &chunk : collection.chunks) {
+		transaction.storage.Append(this, *chunk);
+	}
+}
+
 void DataTable::InitializeAppend(TableAppendState &state) {
 	// obtain the append lock for this table
 	state.append_lock = unique_lock<mutex>(append_lock);
@@ -3,12 +3,14 @@
 #include "duckdb/storage/table/append_state.hpp"
 #include "duckdb/storage/write_ahead_log.hpp"
 #include "duckdb/common/vector_operations/vector_operations.hpp"
+#include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/storage/uncompressed_segment.hpp"
 
 namespace duckdb {
 using namespace std;
 
 LocalTableStorage::LocalTableStorage(DataTable &table) : max_row(0) {
+	collection = make_unique<BufferedChunkCollection>(*table.storage.buffer_manager, table.types);
 	for (auto &index : table.info->indexes) {
 		assert(index->type == IndexType::ART);
 		auto &art = (ART &)*index;
@@ -27,15 +29,23 @@ LocalTableStorage::~LocalTableStorage() {
 }
 
 void LocalTableStorage::InitializeScan(LocalScanState &state) {
+	if (collection->Count() == 0) {
+		// nothing to scan
+		state.storage = nullptr;
+		return;
+	}
 	state.storage = this;
 
 	state.chunk_index = 0;
-	state.max_index = collection.chunks.size() - 1;
-	state.last_chunk_count = collection.chunks.back()->size();
+	state.max_index = collection->ChunkCount() - 1;
+	// every chunk except the last one is full
+	state.last_chunk_count = collection->Count() - state.max_index * STANDARD_VECTOR_SIZE;
+	state.chunk = make_unique<DataChunk>();
+	state.chunk->Initialize(collection->Types());
 }
 
 void LocalTableStorage::Clear() {
-	collection.chunks.clear();
+	collection.reset();
 	indexes.clear();
 	deleted_entries.clear();
 }
@@ -58,7 +68,9 @@ void LocalStorage::Scan(LocalScanState &state, const vector<column_t> &column_id
 		result.Reset();
 		return;
 	}
-	auto &chunk = *state.storage->collection.chunks[state.chunk_index];
+	auto &chunk = *state.chunk;
+	// only deserialize the columns that are scanned
+	state.storage->collection->FetchChunk(state.chunk_index, chunk, column_ids);
 	idx_t chunk_count = state.chunk_index == state.max_index ? state.last_chunk_count : chunk.size();
 	idx_t count = chunk_count;
 
@@ -138,7 +150,7 @@ void LocalStorage::Append(DataTable *table, DataChunk &chunk) {
 	}
 	// append to unique indices (if any)
 	if (storage->indexes.size() > 0) {
-		idx_t base_id = MAX_ROW_ID + storage->collection.count;
+		idx_t base_id = MAX_ROW_ID + storage->collection->Count();
 
 		// first generate the vector of row identifiers
 		Vector row_ids(LOGICAL_ROW_TYPE);
@@ -153,7 +165,7 @@ void LocalStorage::Append(DataTable *table, DataChunk &chunk) {
 	}
 
 	//! Append to the chunk
-	storage->collection.Append(chunk);
+	storage->collection->Append(chunk);
 }
 
 LocalTableStorage *LocalStorage::GetStorage(DataTable *table) {
@@ -173,7 +185,7 @@ void LocalStorage::Delete(DataTable *table, Vector &row_ids, idx_t count) {
 	auto storage = GetStorage(table);
 	// figure out the chunk from which these row ids came
 	idx_t chunk_idx = GetChunk(row_ids);
-	assert(chunk_idx < storage->collection.chunks.size());
+	assert(chunk_idx < storage->collection->ChunkCount());
 
 	// get a pointer to the deleted entries for this chunk
 	bool *deleted;
@@ -217,6 +229,28 @@ static void update_data(Vector &data_vector, Vector &update_vector, Vector &row_
 	}
 }
 
+static void update_string_data(Vector &data_vector, Vector &update_vector, Vector &row_ids, idx_t count,
+                               idx_t base_index) {
+	VectorData udata;
+	update_vector.Orrify(count, udata);
+
+	auto target = FlatVector::GetData<string_t>(data_vector);
+	auto &nullmask = FlatVector::Nullmask(data_vector);
+	auto ids = FlatVector::GetData<row_t>(row_ids);
+	auto updates = (string_t *)udata.data;
+
+	for (idx_t i = 0; i < count; i++) {
+		auto uidx = udata.sel->get_index(i);
+
+		auto id = ids[i] - base_index;
+		nullmask[id] = (*udata.nullmask)[uidx];
+		if (!nullmask[id]) {
+			// the chunk is written back into the collection: the string has to live in the heap of the chunk
+			target[id] = StringVector::AddStringOrBlob(data_vector, updates[uidx]);
+		}
+	}
+}
+
 static void update_chunk(Vector &data, Vector &updates, Vector &row_ids, idx_t count, idx_t base_index) {
 	assert(data.type == updates.type);
 	assert(row_ids.type == LOGICAL_ROW_TYPE);
@@ -240,6 +274,9 @@ static void update_chunk(Vector &data, Vector &updates, Vector &row_ids, idx_t c
 	case PhysicalType::DOUBLE:
 		update_data<double>(data, updates, row_ids, count, base_index);
 		break;
+	case PhysicalType::VARCHAR:
+		update_string_data(data, updates, row_ids, count, base_index);
+		break;
 	default:
 		throw Exception("Unsupported type for in-place update");
 	}
@@ -249,16 +286,19 @@ void LocalStorage::Update(DataTable *table, Vector &row_ids, vector<column_t> &c
 	auto storage = GetStorage(table);
 	// figure out the chunk from which these row ids came
 	idx_t chunk_idx = GetChunk(row_ids);
-	assert(chunk_idx < storage->collection.chunks.size());
+	assert(chunk_idx < storage->collection->ChunkCount());
 
 	idx_t base_index = MAX_ROW_ID + chunk_idx * STANDARD_VECTOR_SIZE;
 
-	// now perform the actual update
-	auto &chunk = *storage->collection.chunks[chunk_idx];
+	// fetch the chunk, perform the actual update and write the chunk back
+	DataChunk chunk;
+	chunk.Initialize(storage->collection->Types());
+	storage->collection->FetchChunk(chunk_idx, chunk);
 	for (idx_t i = 0; i < column_ids.size(); i++) {
 		auto col_idx = column_ids[i];
 		update_chunk(chunk.data[col_idx], data.data[i], row_ids, data.size(), base_index);
 	}
+	storage->collection->ReplaceChunk(chunk_idx, chunk);
 }
 
 template <class T> bool LocalStorage::ScanTableStorage(DataTable *table, LocalTableStorage *storage, T &&fun) {
@@ -369,18 +409,33 @@ void LocalStorage::AddColumn(DataTable *old_dt, DataTable *new_dt, ColumnDefinit
 		executor.AddExpression(*default_value);
 	}
 
-	new_storage->collection.types.push_back(new_column_type);
-	for (idx_t chunk_idx = 0; chunk_idx < new_storage->collection.chunks.size(); chunk_idx++) {
-		auto &chunk = new_storage->collection.chunks[chunk_idx];
+	// rewrite the collection with the new column added to every chunk
+	auto &old_collection = *new_storage->collection;
+	auto new_types = old_collection.Types();
+	new_types.push_back(new_column_type);
+	auto new_collection = make_unique<BufferedChunkCollection>(*new_dt->storage.buffer_manager, new_types);
+
+	DataChunk chunk;
+	chunk.Initialize(old_collection.Types());
+	for (idx_t chunk_idx = 0; chunk_idx < old_collection.ChunkCount(); chunk_idx++) {
+		old_collection.FetchChunk(chunk_idx, chunk);
 		Vector result(new_column_type);
 		if (default_value) {
-			dummy_chunk.SetCardinality(chunk->size());
+			dummy_chunk.SetCardinality(chunk.size());
 			executor.ExecuteExpression(dummy_chunk, result);
 		} else {
 			FlatVector::Nullmask(result).set();
 		}
-		chunk->data.push_back(move(result));
+		DataChunk new_chunk;
+		new_chunk.InitializeEmpty(new_types);
+		for (idx_t col_idx = 0; col_idx < chunk.column_count(); col_idx++) {
+			new_chunk.data[col_idx].Reference(chunk.data[col_idx]);
+		}
+		new_chunk.data.back().Reference(result);
+		new_chunk.SetCardinality(chunk.size());
+		new_collection->Append(new_chunk);
 	}
+	new_storage->collection = move(new_collection);
 
 	table_storage.erase(entry);
 	table_storage[new_dt] = move(new_storage);
@@ -9,6 +9,7 @@
 #include "duckdb/storage/data_table.hpp"
 #include "duckdb/common/operator/comparison_operators.hpp"
 #include "duckdb/common/vector_size.hpp"
+#include "duckdb/common/limits.hpp"
 
 using namespace std;
 
@@ -26,6 +27,12 @@ static NumericSegment::merge_update_function_t GetMergeUpdateFunction(PhysicalTy
 
 static NumericSegment::update_info_append_function_t GetUpdateInfoAppendFunction(PhysicalType type);
 
+static NumericSegment::zonemap_initialize_function_t GetZonemapInitializeFunction(PhysicalType type);
+
+static NumericSegment::zonemap_update_function_t GetZonemapUpdateFunction(PhysicalType type);
+
+static NumericSegment::zonemap_check_function_t GetZonemapCheckFunction(PhysicalType type);
+
 NumericSegment::NumericSegment(BufferManager &manager, PhysicalType type, idx_t row_start, block_id_t block)
     : UncompressedSegment(manager, type, row_start) {
 	// set up the different functions for this type of segment
@@ -35,12 +42,19 @@ NumericSegment::NumericSegment(BufferManager &manager, PhysicalType type, idx_t
 	this->append_from_update_info = GetUpdateInfoAppendFunction(type);
 	this->rollback_update = GetRollbackUpdateFunction(type);
 	this->merge_update_function = GetMergeUpdateFunction(type);
+	this->zonemap_initialize = GetZonemapInitializeFunction(type);
+	this->zonemap_update = GetZonemapUpdateFunction(type);
+	this->zonemap_check = GetZonemapCheckFunction(type);
 
 	// figure out how many vectors we want to store in this block
 	this->type_size = GetTypeIdSize(type);
 	this->vector_size = sizeof(nullmask_t) + type_size * STANDARD_VECTOR_SIZE;
 	this->max_vector_count = Storage::BLOCK_SIZE / vector_size;
 
+	this->zonemap = unique_ptr<data_t[]>(new data_t[max_vector_count * 2 * type_size]);
+	this->zonemap_has_null = unique_ptr<bool[]>(new bool[max_vector_count]);
+	this->zonemap_initialized = false;
+
 	this->block_id = block;
 	if (block_id == INVALID_BLOCK) {
 		// no block id specified: allocate a buffer for the uncompressed segment
@@ -51,6 +65,14 @@ NumericSegment::NumericSegment(BufferManager &manager, PhysicalType type, idx_t
 			auto mask = (nullmask_t *)(handle->node->buffer + (i * vector_size));
 			mask->reset();
 		}
+		// the segment is empty: initialize the zone maps of all vectors
+		if (zonemap_initialize) {
+			for (idx_t i = 0; i < max_vector_count; i++) {
+				zonemap_initialize(GetZonemap(i));
+				zonemap_has_null[i] = false;
+			}
+		}
+		zonemap_initialized = true;
 	}
 }
 
@@ -426,6 +448,10 @@ idx_t NumericSegment::Append(SegmentStatistics &stats, Vector &data, idx_t offse
 		// now perform the actual append
 		append_function(stats, handle->node->buffer + vector_size * vector_index, current_tuple_count, data, offset,
 		                append_count);
+		if (zonemap_update) {
+			zonemap_update(GetZonemap(vector_index), zonemap_has_null[vector_index],
+			               handle->node->buffer + vector_size * vector_index, current_tuple_count, append_count);
+		}
 
 		count -= append_count;
 		offset += append_count;
@@ -439,6 +465,8 @@ idx_t NumericSegment::Append(SegmentStatistics &stats, Vector &data, idx_t offse
 //===--------------------------------------------------------------------===//
 void NumericSegment::Update(ColumnData &column_data, SegmentStatistics &stats, Transaction &transaction, Vector &update,
                             row_t *ids, idx_t count, idx_t vector_index, idx_t vector_offset, UpdateInfo *node) {
+	// the zone maps have to cover both the old and the new values of the updated tuples
+	InitializeZonemap();
 	if (!node) {
 		auto handle = manager.Pin(block_id);
 
@@ -453,6 +481,12 @@ void NumericSegment::Update(ColumnData &column_data, SegmentStatistics &stats, T
 		merge_update_function(stats, node, handle->node->buffer + vector_index * vector_size, update, ids, count,
 		                      vector_offset);
 	}
+	if (zonemap_update) {
+		// widen the zone map of the vector with the new values
+		auto handle = manager.Pin(block_id);
+		zonemap_update(GetZonemap(vector_index), zonemap_has_null[vector_index],
+		               handle->node->buffer + vector_index * vector_size, 0, GetVectorCount(vector_index));
+	}
 }
 
 void NumericSegment::RollbackUpdate(UpdateInfo *info) {
@@ -816,4 +850,208 @@ static NumericSegment::rollback_update_function_t GetRollbackUpdateFunction(Phys
 	}
 }
 
+//===--------------------------------------------------------------------===//
+// Zone maps
+//===--------------------------------------------------------------------===//
+void NumericSegment::InitializeZonemap() {
+	if (zonemap_initialized || !zonemap_initialize) {
+		return;
+	}
+	lock_guard<mutex> zonemap_guard(zonemap_lock);
+	if (zonemap_initialized) {
+		// the zone maps have been computed by a different thread
+		return;
+	}
+	auto handle = manager.Pin(block_id);
+	for (idx_t vector_index = 0; vector_index < max_vector_count; vector_index++) {
+		auto entry = GetZonemap(vector_index);
+		zonemap_initialize(entry);
+		zonemap_has_null[vector_index] = false;
+		if (vector_index * STANDARD_VECTOR_SIZE < tuple_count) {
+			zonemap_update(entry, zonemap_has_null[vector_index], handle->node->buffer + vector_index * vector_size, 0,
+			               GetVectorCount(vector_index));
+		}
+	}
+	zonemap_initialized = true;
+}
+
+bool NumericSegment::CheckZonemap(idx_t vector_index, vector<TableFilter> &filters, bool initialize) {
+	if (!zonemap_check || vector_index >= max_vector_count) {
+		return true;
+	}
+	if (!zonemap_initialized) {
+		if (!initialize) {
+			return true;
+		}
+		InitializeZonemap();
+	}
+	for (auto &filter : filters) {
+		if (filter.comparison_type == ExpressionType::OPERATOR_IS_NULL) {
+			// IS NULL can only be satisfied by vectors that contain NULL values
+			return zonemap_has_null[vector_index];
+		}
+	}
+	return zonemap_check(GetZonemap(vector_index), filters);
+}
+
+template <class T> static void zonemap_initialize_loop(data_ptr_t zonemap) {
+	auto min_max = (T *)zonemap;
+	min_max[0] = NumericLimits<T>::Maximum();
+	min_max[1] = NumericLimits<T>::Minimum();
+}
+
+template <class T>
+static void zonemap_update_loop(data_ptr_t zonemap, bool &has_null, data_ptr_t source, idx_t offset, idx_t count) {
+	auto min_max = (T *)zonemap;
+	auto &nullmask = *((nullmask_t *)source);
+	auto source_data = (T *)(source + sizeof(nullmask_t));
+	for (idx_t i = offset; i < offset + count; i++) {
+		if (nullmask[i]) {
+			has_null = true;
+		} else {
+			update_min_max_numeric_segment(source_data[i], &min_max[0], &min_max[1]);
+		}
+	}
+}
+
+//! The filter constants have the physical type of the column, read them directly from the value
+template <class T> static T zonemap_constant(Value &value);
+
+template <> int8_t zonemap_constant(Value &value) {
+	return value.value_.tinyint;
+}
+
+template <> int16_t zonemap_constant(Value &value) {
+	return value.value_.smallint;
+}
+
+template <> int32_t zonemap_constant(Value &value) {
+	return value.value_.integer;
+}
+
+template <> int64_t zonemap_constant(Value &value) {
+	return value.value_.bigint;
+}
+
+template <> hugeint_t zonemap_constant(Value &value) {
+	return value.value_.hugeint;
+}
+
+template <> float zonemap_constant(Value &value) {
+	return value.value_.float_;
+}
+
+template <> double zonemap_constant(Value &value) {
+	return value.value_.double_;
+}
+
+template <class T> static bool zonemap_check_loop(data_ptr_t zonemap, vector<TableFilter> &filters) {
+	auto min = ((T *)zonemap)[0];
+	auto max = ((T *)zonemap)[1];
+	if (GreaterThan::Operation(min, max)) {
+		// the vector is empty or only contains NULL values: no comparison (and no IS NOT NULL) can be satisfied
+		return false;
+	}
+	for (auto &filter : filters) {
+		auto constant = zonemap_constant<T>(filter.constant);
+		switch (filter.comparison_type) {
+		case ExpressionType::COMPARE_EQUAL:
+			if (LessThan::Operation(constant, min) || GreaterThan::Operation(constant, max)) {
+				return false;
+			}
+			break;
+		case ExpressionType::COMPARE_GREATERTHAN:
+			if (!GreaterThan::Operation(max, constant)) {
+				return false;
+			}
+			break;
+		case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+			if (LessThan::Operation(max, constant)) {
+				return false;
+			}
+			break;
+		case ExpressionType::COMPARE_LESSTHAN:
+			if (!LessThan::Operation(min, constant)) {
+				return false;
+			}
+			break;
+		case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+			if (GreaterThan::Operation(min, constant)) {
+				return false;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+	return true;
+}
+
+static NumericSegment::zonemap_initialize_function_t GetZonemapInitializeFunction(PhysicalType type) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		return zonemap_initialize_loop<int8_t>;
+	case PhysicalType::INT16:
+		return zonemap_initialize_loop<int16_t>;
+	case PhysicalType::INT32:
+		return zonemap_initialize_loop<int32_t>;
+	case PhysicalType::INT64:
+		return zonemap_initialize_loop<int64_t>;
+	case PhysicalType::INT128:
+		return zonemap_initialize_loop<hugeint_t>;
+	case PhysicalType::FLOAT:
+		return zonemap_initialize_loop<float>;
+	case PhysicalType::DOUBLE:
+		return zonemap_initialize_loop<double>;
+	default:
+		// no zone maps for this type
+		return nullptr;
+	}
+}
+
+static NumericSegment::zonemap_update_function_t GetZonemapUpdateFunction(PhysicalType type) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		return zonemap_update_loop<int8_t>;
+	case PhysicalType::INT16:
+		return zonemap_update_loop<int16_t>;
+	case PhysicalType::INT32:
+		return zonemap_update_loop<int32_t>;
+	case PhysicalType::INT64:
+		return zonemap_update_loop<int64_t>;
+	case PhysicalType::INT128:
+		return zonemap_update_loop<hugeint_t>;
+	case PhysicalType::FLOAT:
+		return zonemap_update_loop<float>;
+	case PhysicalType::DOUBLE:
+		return zonemap_update_loop<double>;
+	default:
+		return nullptr;
+	}
+}
+
+static NumericSegment::zonemap_check_function_t GetZonemapCheckFunction(PhysicalType type) {
+	switch (type) {
+	case PhysicalType::BOOL:
+	case PhysicalType::INT8:
+		return zonemap_check_loop<int8_t>;
+	case PhysicalType::INT16:
+		return zonemap_check_loop<int16_t>;
+	case PhysicalType::INT32:
+		return zonemap_check_loop<int32_t>;
+	case PhysicalType::INT64:
+		return zonemap_check_loop<int64_t>;
+	case PhysicalType::INT128:
+		return zonemap_check_loop<hugeint_t>;
+	case PhysicalType::FLOAT:
+		return zonemap_check_loop<float>;
+	case PhysicalType::DOUBLE:
+		return zonemap_check_loop<double>;
+	default:
+		return nullptr;
+	}
+}
+
 } // namespace duckdb
@@ -48,6 +48,11 @@ void PersistentSegment::Select(Transaction &transaction, ColumnScanState &state,
 	data->Select(transaction, result, tableFilter, sel, approved_tuple_count, state);
 }
 
+bool PersistentSegment::CheckZonemap(idx_t vector_index, vector<TableFilter> &filters) {
+	// do not load the block from disk only to compute its zone maps
+	return data->CheckZonemap(vector_index, filters, false);
+}
+
 void PersistentSegment::Fetch(ColumnScanState &state, idx_t vector_index, Vector &result) {
 	data->Fetch(state, vector_index, result);
 }
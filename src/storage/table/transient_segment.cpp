@@ -40,6 +40,10 @@ void TransientSegment::Select(Transaction &transaction, ColumnScanState &state,
 	return data->Select(transaction, result, tableFilter, sel, approved_tuple_count, state);
 }
 
+bool TransientSegment::CheckZonemap(idx_t vector_index, vector<TableFilter> &filters) {
+	return data->CheckZonemap(vector_index, filters, true);
+}
+
 void TransientSegment::Fetch(ColumnScanState &state, idx_t vector_index, Vector &result) {
 	data->Fetch(state, vector_index, result);
 }
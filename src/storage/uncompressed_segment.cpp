@@ -219,8 +219,52 @@ static void filterSelectionType(T *vec, T *predicate, SelectionVector &sel, idx_
 	sel.Initialize(new_sel);
 }
 
+static void filterNullSelection(SelectionVector &sel, idx_t &approved_tuple_count, nullmask_t &nullmask,
+                                bool select_null) {
+	SelectionVector new_sel(approved_tuple_count);
+	idx_t result_count = 0;
+	for (idx_t i = 0; i < approved_tuple_count; i++) {
+		auto idx = sel.get_index(i);
+		if (nullmask[idx] == select_null) {
+			new_sel.set_index(result_count++, idx);
+		}
+	}
+	sel.Initialize(new_sel);
+	approved_tuple_count = result_count;
+}
+
+static bool IsNullFilter(TableFilter &filter) {
+	return filter.comparison_type == ExpressionType::OPERATOR_IS_NULL ||
+	       filter.comparison_type == ExpressionType::OPERATOR_IS_NOT_NULL;
+}
+
+//! Whether or not the filters can be handled by the specialized selections of the segments: either a single
+//! comparison, or a lower bound followed by an upper bound
+static bool IsSimpleFilter(vector<TableFilter> &filters) {
+	for (auto &filter : filters) {
+		if (IsNullFilter(filter)) {
+			return false;
+		}
+	}
+	if (filters.size() == 1) {
+		return true;
+	}
+	if (filters.size() != 2) {
+		return false;
+	}
+	return (filters[0].comparison_type == ExpressionType::COMPARE_GREATERTHAN ||
+	        filters[0].comparison_type == ExpressionType::COMPARE_GREATERTHANOREQUALTO) &&
+	       (filters[1].comparison_type == ExpressionType::COMPARE_LESSTHAN ||
+	        filters[1].comparison_type == ExpressionType::COMPARE_LESSTHANOREQUALTO);
+}
+
 void UncompressedSegment::filterSelection(SelectionVector &sel, Vector &result, TableFilter filter,
                                           idx_t &approved_tuple_count, nullmask_t &nullmask) {
+	if (IsNullFilter(filter)) {
+		filterNullSelection(sel, approved_tuple_count, nullmask,
+		                    filter.comparison_type == ExpressionType::OPERATOR_IS_NULL);
+		return;
+	}
 	// the inplace loops take the result as the last parameter
 	switch (result.type.InternalType()) {
 	case PhysicalType::INT8: {
@@ -255,6 +299,13 @@ void UncompressedSegment::filterSelection(SelectionVector &sel, Vector &result,
 		                             nullmask);
 		break;
 	}
+	case PhysicalType::INT128: {
+		auto result_flat = FlatVector::GetData<hugeint_t>(result);
+		auto predicate = filter.constant.value_.hugeint;
+		filterSelectionType<hugeint_t>(result_flat, &predicate, sel, approved_tuple_count, filter.comparison_type,
+		                               nullmask);
+		break;
+	}
 	case PhysicalType::FLOAT: {
 		auto result_flat = FlatVector::GetData<float>(result);
 		auto predicate_vector = Vector(filter.constant.value_.float_);
@@ -286,6 +337,20 @@ void UncompressedSegment::filterSelection(SelectionVector &sel, Vector &result,
 void UncompressedSegment::Select(Transaction &transaction, Vector &result, vector<TableFilter> &tableFilters,
                                  SelectionVector &sel, idx_t &approved_tuple_count, ColumnScanState &state) {
 	auto read_lock = lock.GetSharedLock();
+	if (approved_tuple_count == 0 || !CheckZonemap(state.vector_index, tableFilters, true)) {
+		// no tuple in this vector can satisfy the filters: skip the vector entirely
+		approved_tuple_count = 0;
+		return;
+	}
+	if (!IsSimpleFilter(tableFilters)) {
+		// the specialized selections only support simple comparisons: scan the vector and filter the result
+		Scan(transaction, state, state.vector_index, result, false);
+		auto &nullmask = FlatVector::Nullmask(result);
+		for (auto &table_filter : tableFilters) {
+			filterSelection(sel, result, table_filter, approved_tuple_count, nullmask);
+		}
+		return;
+	}
 	if (versions && versions[state.vector_index]) {
 		Scan(transaction, state, state.vector_index, result, false);
 		auto vector_index = state.vector_index;
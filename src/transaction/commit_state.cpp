@@ -2,6 +2,7 @@
 #include "duckdb/transaction/delete_info.hpp"
 #include "duckdb/transaction/update_info.hpp"
 
+#include "duckdb/catalog/catalog_set.hpp"
 #include "duckdb/storage/data_table.hpp"
 #include "duckdb/storage/write_ahead_log.hpp"
 #include "duckdb/storage/uncompressed_segment.hpp"
@@ -142,6 +143,8 @@ template <bool HAS_LOG> void CommitState::CommitEntry(UndoFlags type, data_ptr_t
 		CatalogEntry *catalog_entry = *((CatalogEntry **)data);
 		assert(catalog_entry->parent);
 		catalog_entry->parent->timestamp = commit_id;
+		// the change is now visible to new transactions
+		catalog_entry->set->ModifyCatalog(*catalog_entry);
 
 		if (HAS_LOG) {
 			// push the catalog update to the WAL
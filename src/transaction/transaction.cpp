@@ -49,6 +49,7 @@ void Transaction::PushDelete(DataTable *table, ChunkInfo *vinfo, row_t rows[], i
 }
 
 UpdateInfo *Transaction::CreateUpdateInfo(idx_t type_size, idx_t entries) {
+	lock_guard<mutex> lock(undo_lock);
 	auto update_info = (UpdateInfo *)undo_buffer.CreateEntry(
 	    UndoFlags::UPDATE_TUPLE, sizeof(UpdateInfo) + (sizeof(sel_t) + type_size) * entries);
 	update_info->max = entries;
@@ -6,6 +6,7 @@
 #include "duckdb/common/types/timestamp.hpp"
 #include "duckdb/catalog/catalog.hpp"
 #include "duckdb/catalog/dependency_manager.hpp"
+#include "duckdb/main/database.hpp"
 #include "duckdb/storage/storage_manager.hpp"
 #include "duckdb/transaction/transaction.hpp"
 
@@ -43,6 +44,9 @@ Transaction *TransactionManager::StartTransaction() {
 
 	// create the actual transaction
 	auto transaction = make_unique<Transaction>(start_time, transaction_id, start_timestamp);
+	// catalog changes are committed while holding the transaction lock, so the transaction sees exactly the catalog
+	// of this version
+	transaction->catalog_version = storage.database.catalog->GetCatalogVersion();
 	auto transaction_ptr = transaction.get();
 
 	// store it in the set of active transactions
@@ -445,3 +445,281 @@ TEST_CASE("Test prepared statements in C API", "[capi]") {
 	duckdb_destroy_result(&res);
 	duckdb_destroy_prepare(&stmt);
 }
+
+TEST_CASE("Test streaming results in C API", "[capi]") {
+	CAPITester tester;
+	duckdb_streaming_result stream = nullptr;
+	duckdb_chunk chunk;
+
+	REQUIRE(tester.OpenDatabase(nullptr));
+	REQUIRE_NO_FAIL(tester.Query("CREATE TABLE strings AS SELECT i, CASE WHEN i % 10 = 0 THEN NULL ELSE "
+	                             "'this is a long string ' || i::VARCHAR END AS s, CASE WHEN i % 2 = 0 THEN 'short' "
+	                             "ELSE NULL END AS s2 FROM range(0, 5000, 1) t1(i)"));
+
+	REQUIRE(duckdb_query_stream(tester.connection, "SELECT i, s, s2, DATE '1992-09-20', TIMESTAMP '1992-09-20 "
+	                                               "11:30:00' FROM strings ORDER BY i",
+	                            &stream) == DuckDBSuccess);
+	REQUIRE(duckdb_stream_error(stream) == nullptr);
+	REQUIRE(duckdb_stream_column_count(stream) == 5);
+	REQUIRE(duckdb_stream_column_type(stream, 0) == DUCKDB_TYPE_BIGINT);
+	REQUIRE(duckdb_stream_column_type(stream, 1) == DUCKDB_TYPE_VARCHAR);
+	REQUIRE(duckdb_stream_column_type(stream, 5) == DUCKDB_TYPE_INVALID);
+	REQUIRE(string(duckdb_stream_column_name(stream, 0)) == "i");
+
+	idx_t row = 0;
+	idx_t chunk_count = 0;
+	while (true) {
+		REQUIRE(duckdb_stream_fetch_chunk(stream, &chunk) == DuckDBSuccess);
+		if (chunk.count == 0) {
+			duckdb_destroy_chunk(&chunk);
+			break;
+		}
+		REQUIRE(chunk.column_count == 5);
+		auto ints = (int64_t *)chunk.columns[0].data;
+		auto strings = (duckdb_string_t *)chunk.columns[1].data;
+		auto short_strings = (duckdb_string_t *)chunk.columns[2].data;
+		REQUIRE(chunk.columns[0].nullmask == nullptr);
+		REQUIRE(chunk.columns[1].nullmask != nullptr);
+		for (idx_t i = 0; i < chunk.count; i++, row++) {
+			REQUIRE(ints[i] == (int64_t)row);
+			REQUIRE(chunk.columns[1].nullmask[i] == (row % 10 == 0));
+			if (row % 10 != 0) {
+				auto expected = "this is a long string " + to_string(row);
+				REQUIRE(string(duckdb_string_data(&strings[i]), strings[i].length) == expected);
+			}
+			REQUIRE(chunk.columns[2].nullmask[i] == (row % 2 != 0));
+			if (row % 2 == 0) {
+				REQUIRE(string(duckdb_string_data(&short_strings[i]), short_strings[i].length) == "short");
+			}
+		}
+		auto date = duckdb_from_date(((int32_t *)chunk.columns[3].data)[0]);
+		REQUIRE(date.year == 1992);
+		REQUIRE(date.month == 9);
+		REQUIRE(date.day == 20);
+		auto timestamp = duckdb_from_timestamp(((int64_t *)chunk.columns[4].data)[0]);
+		REQUIRE(timestamp.date.day == 20);
+		REQUIRE(timestamp.time.hour == 11);
+		REQUIRE(timestamp.time.min == 30);
+		chunk_count++;
+		duckdb_destroy_chunk(&chunk);
+	}
+	REQUIRE(row == 5000);
+	REQUIRE(chunk_count > 1);
+	// fetching past the end keeps returning empty chunks
+	REQUIRE(duckdb_stream_fetch_chunk(stream, &chunk) == DuckDBSuccess);
+	REQUIRE(chunk.count == 0);
+	duckdb_destroy_stream(&stream);
+	REQUIRE(stream == nullptr);
+
+	// chunks remain valid after the stream is destroyed
+	REQUIRE(duckdb_query_stream(tester.connection, "SELECT 'hello world, this is a string'", &stream) ==
+	        DuckDBSuccess);
+	REQUIRE(duckdb_stream_fetch_chunk(stream, &chunk) == DuckDBSuccess);
+	duckdb_destroy_stream(&stream);
+	REQUIRE(chunk.count == 1);
+	auto str = (duckdb_string_t *)chunk.columns[0].data;
+	REQUIRE(string(duckdb_string_data(str), str->length) == "hello world, this is a string");
+	duckdb_destroy_chunk(&chunk);
+
+	// errors
+	REQUIRE(duckdb_query_stream(tester.connection, "SELECT * FROM nonexistent", &stream) == DuckDBError);
+	REQUIRE(duckdb_stream_error(stream) != nullptr);
+	REQUIRE(duckdb_stream_fetch_chunk(stream, &chunk) == DuckDBError);
+	duckdb_destroy_stream(&stream);
+	// the result is initialized also when the arguments are invalid
+	REQUIRE(duckdb_query_stream(NULL, "SELECT 42", &stream) == DuckDBError);
+	REQUIRE(stream == nullptr);
+	duckdb_destroy_stream(&stream);
+	REQUIRE(duckdb_query_stream(tester.connection, NULL, &stream) == DuckDBError);
+	REQUIRE(stream == nullptr);
+	duckdb_destroy_stream(&stream);
+	REQUIRE(duckdb_stream_fetch_chunk(NULL, &chunk) == DuckDBError);
+	duckdb_destroy_stream(NULL);
+}
+
+TEST_CASE("Test appender in C API", "[capi]") {
+	CAPITester tester;
+	unique_ptr<CAPIResult> result;
+	duckdb_appender appender = nullptr;
+
+	REQUIRE(tester.OpenDatabase(nullptr));
+	REQUIRE_NO_FAIL(tester.Query("CREATE TABLE test (i INTEGER, d DOUBLE, s VARCHAR, b BOOLEAN)"));
+
+	// nonexistent table
+	REQUIRE(duckdb_appender_create(tester.connection, nullptr, "nonexistent", &appender) == DuckDBError);
+	REQUIRE(duckdb_appender_error(appender) != nullptr);
+	REQUIRE(duckdb_appender_begin_row(appender) == DuckDBError);
+	REQUIRE(duckdb_appender_destroy(&appender) == DuckDBSuccess);
+	REQUIRE(appender == nullptr);
+
+	// append row by row
+	REQUIRE(duckdb_appender_create(tester.connection, nullptr, "test", &appender) == DuckDBSuccess);
+	REQUIRE(duckdb_appender_error(appender) == nullptr);
+	REQUIRE(duckdb_appender_begin_row(appender) == DuckDBSuccess);
+	REQUIRE(duckdb_append_int32(appender, 1) == DuckDBSuccess);
+	REQUIRE(duckdb_append_double(appender, 1.5) == DuckDBSuccess);
+	REQUIRE(duckdb_append_varchar(appender, "hello") == DuckDBSuccess);
+	REQUIRE(duckdb_append_bool(appender, true) == DuckDBSuccess);
+	REQUIRE(duckdb_appender_end_row(appender) == DuckDBSuccess);
+
+	REQUIRE(duckdb_appender_begin_row(appender) == DuckDBSuccess);
+	REQUIRE(duckdb_append_int8(appender, 2) == DuckDBSuccess);
+	REQUIRE(duckdb_append_float(appender, 2.5) == DuckDBSuccess);
+	REQUIRE(duckdb_append_varchar_length(appender, "worldwide", 5) == DuckDBSuccess);
+	REQUIRE(duckdb_append_null(appender) == DuckDBSuccess);
+	REQUIRE(duckdb_appender_end_row(appender) == DuckDBSuccess);
+	REQUIRE(duckdb_appender_flush(appender) == DuckDBSuccess);
+
+	result = tester.Query("SELECT * FROM test ORDER BY i");
+	REQUIRE_NO_FAIL(*result);
+	REQUIRE(result->row_count() == 2);
+	REQUIRE(result->Fetch<int32_t>(0, 1) == 2);
+	REQUIRE(result->Fetch<double>(1, 1) == 2.5);
+	REQUIRE(result->Fetch<string>(2, 0) == "hello");
+	REQUIRE(result->Fetch<string>(2, 1) == "world");
+	REQUIRE(result->Fetch<bool>(3, 0) == true);
+	REQUIRE(result->IsNull(3, 1));
+
+	// append whole columns at once, converting them to the column types
+	idx_t count = 3000;
+	vector<int64_t> ints;
+	vector<double> doubles;
+	vector<string> strings;
+	vector<const char *> string_ptrs;
+	unique_ptr<bool[]> bools(new bool[count]);
+	unique_ptr<bool[]> nullmask(new bool[count]);
+	for (idx_t i = 0; i < count; i++) {
+		ints.push_back(100 + i);
+		doubles.push_back(i / 2.0);
+		strings.push_back("string " + to_string(i));
+		bools[i] = i % 2;
+		nullmask[i] = i % 3 == 0;
+	}
+	for (idx_t i = 0; i < count; i++) {
+		string_ptrs.push_back(i % 5 == 0 ? nullptr : strings[i].c_str());
+	}
+	duckdb_column_array columns[4];
+	columns[0] = {DUCKDB_TYPE_BIGINT, ints.data(), nullptr};
+	columns[1] = {DUCKDB_TYPE_DOUBLE, doubles.data(), nullmask.get()};
+	columns[2] = {DUCKDB_TYPE_VARCHAR, string_ptrs.data(), nullptr};
+	columns[3] = {DUCKDB_TYPE_BOOLEAN, bools.get(), nullptr};
+	REQUIRE(duckdb_appender_append_columns(appender, columns, count) == DuckDBSuccess);
+	REQUIRE(duckdb_appender_close(appender) == DuckDBSuccess);
+	REQUIRE(duckdb_appender_begin_row(appender) == DuckDBError);
+	REQUIRE(duckdb_appender_destroy(&appender) == DuckDBSuccess);
+
+	result = tester.Query("SELECT COUNT(*), SUM(i), COUNT(d), COUNT(s), SUM(b::INTEGER) FROM test WHERE i >= 100");
+	REQUIRE_NO_FAIL(*result);
+	REQUIRE(result->Fetch<int64_t>(0, 0) == 3000);
+	REQUIRE(result->Fetch<int64_t>(1, 0) == 4798500);
+	REQUIRE(result->Fetch<int64_t>(2, 0) == 2000);
+	REQUIRE(result->Fetch<int64_t>(3, 0) == 2400);
+	REQUIRE(result->Fetch<int64_t>(4, 0) == 1500);
+	result = tester.Query("SELECT s, d FROM test WHERE i = 2102");
+	REQUIRE_NO_FAIL(*result);
+	REQUIRE(result->Fetch<string>(0, 0) == "string 2002");
+	REQUIRE(result->Fetch<double>(1, 0) == 1001);
+
+	// the string pointers of values that are NULL in the nullmask are never read
+	REQUIRE(duckdb_appender_create(tester.connection, nullptr, "test", &appender) == DuckDBSuccess);
+	int64_t null_ints[] = {10000, 10001};
+	const char *null_strings[] = {"hello", (const char *)1};
+	bool string_nullmask[] = {false, true};
+	columns[0] = {DUCKDB_TYPE_BIGINT, null_ints, nullptr};
+	columns[2] = {DUCKDB_TYPE_VARCHAR, null_strings, string_nullmask};
+	REQUIRE(duckdb_appender_append_columns(appender, columns, 2) == DuckDBSuccess);
+	REQUIRE(duckdb_appender_destroy(&appender) == DuckDBSuccess);
+	result = tester.Query("SELECT s FROM test WHERE i >= 10000 ORDER BY i");
+	REQUIRE_NO_FAIL(*result);
+	REQUIRE(result->Fetch<string>(0, 0) == "hello");
+	REQUIRE(result->IsNull(0, 1));
+
+	// a failing conversion invalidates the appender
+	REQUIRE(duckdb_appender_create(tester.connection, "main", "test", &appender) == DuckDBSuccess);
+	const char *invalid_ints[] = {"1", "hello"};
+	columns[0] = {DUCKDB_TYPE_VARCHAR, invalid_ints, nullptr};
+	REQUIRE(duckdb_appender_append_columns(appender, columns, 2) == DuckDBError);
+	REQUIRE(duckdb_appender_error(appender) != nullptr);
+	REQUIRE(duckdb_appender_destroy(&appender) == DuckDBSuccess);
+
+	// unsupported array types
+	REQUIRE(duckdb_appender_create(tester.connection, nullptr, "test", &appender) == DuckDBSuccess);
+	columns[0] = {DUCKDB_TYPE_DATE, ints.data(), nullptr};
+	REQUIRE(duckdb_appender_append_columns(appender, columns, 1) == DuckDBError);
+	REQUIRE(duckdb_appender_destroy(&appender) == DuckDBSuccess);
+
+	result = tester.Query("SELECT COUNT(*) FROM test");
+	REQUIRE(result->Fetch<int64_t>(0, 0) == 3004);
+	REQUIRE(duckdb_appender_destroy(nullptr) == DuckDBError);
+}
+
+TEST_CASE("Test batch execution of prepared statements in C API", "[capi]") {
+	CAPITester tester;
+	unique_ptr<CAPIResult> result;
+	duckdb_result res;
+	duckdb_prepared_statement stmt = nullptr;
+
+	REQUIRE(tester.OpenDatabase(nullptr));
+	REQUIRE_NO_FAIL(tester.Query("CREATE TABLE test (i INTEGER PRIMARY KEY, s VARCHAR)"));
+	REQUIRE(duckdb_prepare(tester.connection, "INSERT INTO test VALUES ($1, $2)", &stmt) == DuckDBSuccess);
+
+	idx_t count = 2500;
+	vector<int32_t> ints;
+	vector<string> strings;
+	vector<const char *> string_ptrs;
+	for (idx_t i = 0; i < count; i++) {
+		ints.push_back(i);
+		strings.push_back(to_string(i));
+	}
+	for (idx_t i = 0; i < count; i++) {
+		string_ptrs.push_back(strings[i].c_str());
+	}
+	duckdb_column_array params[2];
+	params[0] = {DUCKDB_TYPE_INTEGER, ints.data(), nullptr};
+	params[1] = {DUCKDB_TYPE_VARCHAR, string_ptrs.data(), nullptr};
+	REQUIRE(duckdb_execute_prepared_batch(stmt, params, count, &res) == DuckDBSuccess);
+	duckdb_destroy_result(&res);
+
+	result = tester.Query("SELECT COUNT(*), SUM(i), SUM(s::INTEGER) FROM test");
+	REQUIRE_NO_FAIL(*result);
+	REQUIRE(result->Fetch<int64_t>(0, 0) == 2500);
+	REQUIRE(result->Fetch<int64_t>(1, 0) == 3123750);
+	REQUIRE(result->Fetch<int64_t>(2, 0) == 3123750);
+
+	// a failing execution rolls back the entire batch
+	for (idx_t i = 0; i < count; i++) {
+		ints[i] = count + i;
+	}
+	ints[count - 1] = count;
+	REQUIRE(duckdb_execute_prepared_batch(stmt, params, count, &res) == DuckDBError);
+	REQUIRE(res.error_message != nullptr);
+	duckdb_destroy_result(&res);
+	result = tester.Query("SELECT COUNT(*) FROM test");
+	REQUIRE(result->Fetch<int64_t>(0, 0) == 2500);
+
+	// inside a transaction the batch does not commit
+	ints[count - 1] = 2 * count - 1;
+	REQUIRE_NO_FAIL(tester.Query("BEGIN TRANSACTION"));
+	REQUIRE(duckdb_execute_prepared_batch(stmt, params, count, &res) == DuckDBSuccess);
+	duckdb_destroy_result(&res);
+	REQUIRE_NO_FAIL(tester.Query("ROLLBACK"));
+	result = tester.Query("SELECT COUNT(*) FROM test");
+	REQUIRE(result->Fetch<int64_t>(0, 0) == 2500);
+
+	// the result of the last execution is returned
+	duckdb_prepared_statement select_stmt = nullptr;
+	REQUIRE(duckdb_prepare(tester.connection, "SELECT s FROM test WHERE i = $1", &select_stmt) == DuckDBSuccess);
+	int32_t keys[] = {3, 42};
+	params[0] = {DUCKDB_TYPE_INTEGER, keys, nullptr};
+	REQUIRE(duckdb_execute_prepared_batch(select_stmt, params, 2, &res) == DuckDBSuccess);
+	REQUIRE(res.row_count == 1);
+	REQUIRE(duckdb_value_int32(&res, 0, 0) == 42);
+	duckdb_destroy_result(&res);
+
+	// invalid parameter arrays
+	params[0] = {DUCKDB_TYPE_DATE, keys, nullptr};
+	REQUIRE(duckdb_execute_prepared_batch(select_stmt, params, 2, &res) == DuckDBError);
+	REQUIRE(duckdb_execute_prepared_batch(select_stmt, nullptr, 2, &res) == DuckDBError);
+	duckdb_destroy_prepare(&select_stmt);
+	duckdb_destroy_prepare(&stmt);
+}
@@ -436,3 +436,128 @@ TEST_CASE("Prepare all types of statements", "[prepared]") {
 	// TRANSACTION
 	REQUIRE_NO_FAIL(TestExecutePrepared(con, "COMMIT"));
 }
+
+TEST_CASE("Test executing the same prepared query from different connections", "[prepared]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db), con2(db);
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE a(i INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO a VALUES (11), (12), (13)"));
+
+	// the same query issued from different connections and with different parameters
+	for (idx_t i = 0; i < 10; i++) {
+		result = con.Query("SELECT COUNT(*) FROM a WHERE i>=$1", 12);
+		REQUIRE(CHECK_COLUMN(result, 0, {2}));
+		result = con2.Query("SELECT COUNT(*) FROM a WHERE i>=$1", 13);
+		REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	}
+	auto prepare = con.Prepare("SELECT COUNT(*) FROM a WHERE i>=$1");
+	auto prepare2 = con2.Prepare("SELECT COUNT(*) FROM a WHERE i>=$1");
+	REQUIRE(prepare->n_param == 1);
+	result = prepare->Execute(11);
+	REQUIRE(CHECK_COLUMN(result, 0, {3}));
+	result = prepare2->Execute(14);
+	REQUIRE(CHECK_COLUMN(result, 0, {0}));
+	result = prepare->Execute(12);
+	REQUIRE(CHECK_COLUMN(result, 0, {2}));
+	prepare.reset();
+	prepare2.reset();
+
+	// the query is bound again against the current catalog
+	REQUIRE_NO_FAIL(con2.Query("DROP TABLE a"));
+	REQUIRE_FAIL(con.Query("SELECT COUNT(*) FROM a WHERE i>=$1", 12));
+	REQUIRE_NO_FAIL(con2.Query("CREATE TABLE a(i VARCHAR)"));
+	REQUIRE_NO_FAIL(con2.Query("INSERT INTO a VALUES ('12'), ('hello')"));
+	result = con.Query("SELECT COUNT(*) FROM a WHERE i>=$1", "2");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+}
+
+//! Returns whether or not the last query of the connection was planned, rather than taken from the plan cache
+static bool QueryWasPlanned(Connection &con) {
+	return con.GetProfilingInformation(ProfilerPrintFormat::JSON).find("\"planner\"") != string::npos;
+}
+
+TEST_CASE("Test the plan cache shared between connections", "[prepared]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db), con2(db);
+	con.EnableProfiling();
+	con2.EnableProfiling();
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers(i INTEGER)"));
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO integers VALUES (1), (2), (3), (NULL)"));
+
+	// the plan of the query is created once and reused by the other connection
+	result = con.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {6}));
+	REQUIRE(QueryWasPlanned(con));
+	result = con2.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {6}));
+	REQUIRE(!QueryWasPlanned(con2));
+	result = con.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {6}));
+	REQUIRE(!QueryWasPlanned(con));
+
+	// changes to the data do not invalidate the plan
+	REQUIRE_NO_FAIL(con2.Query("INSERT INTO integers VALUES (4)"));
+	result = con.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {10}));
+	REQUIRE(!QueryWasPlanned(con));
+
+	// changes to the catalog do
+	REQUIRE_NO_FAIL(con2.Query("ALTER TABLE integers ALTER i TYPE DOUBLE"));
+	result = con.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {10.0}));
+	REQUIRE(QueryWasPlanned(con));
+	REQUIRE_NO_FAIL(con2.Query("CREATE VIEW v1 AS SELECT 42"));
+	result = con2.Query("SELECT SUM(i) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {10.0}));
+	REQUIRE(QueryWasPlanned(con2));
+
+	// a transaction that started before a catalog change does not use the plans of the new catalog
+	REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+	REQUIRE_NO_FAIL(con2.Query("DROP TABLE integers"));
+	REQUIRE_NO_FAIL(con2.Query("CREATE TABLE integers AS SELECT 'hello' AS i"));
+	result = con2.Query("SELECT COUNT(*) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+	result = con.Query("SELECT COUNT(*) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {5}));
+	REQUIRE(QueryWasPlanned(con));
+	REQUIRE_NO_FAIL(con.Query("COMMIT"));
+	result = con.Query("SELECT COUNT(*) FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {1}));
+
+	// connections with temporary objects do not share plans, as the names in the query can refer to them
+	result = con2.Query("SELECT i FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {"hello"}));
+	REQUIRE_NO_FAIL(con.Query("CREATE TEMPORARY TABLE temp_integers AS SELECT 'world' AS i"));
+	result = con.Query("SELECT i FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {"hello"}));
+	REQUIRE(QueryWasPlanned(con));
+	result = con2.Query("SELECT i FROM integers");
+	REQUIRE(CHECK_COLUMN(result, 0, {"hello"}));
+	REQUIRE(!QueryWasPlanned(con2));
+
+	// the parameters of a cached plan are bound again on every execution
+	REQUIRE_NO_FAIL(con2.Query("CREATE TABLE a AS SELECT * FROM range(0, 100, 1) t1(i)"));
+	{
+		Connection con3(db);
+		auto prepare = con3.Prepare("SELECT COUNT(*) FROM a WHERE i<$1");
+		result = prepare->Execute(10);
+		REQUIRE(CHECK_COLUMN(result, 0, {10}));
+	}
+	auto prepare = con2.Prepare("SELECT COUNT(*) FROM a WHERE i<$1");
+	REQUIRE(prepare->n_param == 1);
+	result = prepare->Execute(20);
+	REQUIRE(CHECK_COLUMN(result, 0, {20}));
+	result = prepare->Execute(30);
+	REQUIRE(CHECK_COLUMN(result, 0, {30}));
+	prepare.reset();
+
+	// the plans of queries that read the current time are not cached
+	result = con2.Query("SELECT NOW() - NOW()");
+	REQUIRE(QueryWasPlanned(con2));
+	result = con2.Query("SELECT NOW() - NOW()");
+	REQUIRE(QueryWasPlanned(con2));
+}
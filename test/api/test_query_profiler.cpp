@@ -23,3 +23,118 @@ TEST_CASE("Test query profiler", "[api]") {
 	output = con.GetProfilingInformation(ProfilerPrintFormat::JSON);
 	REQUIRE(output.size() > 0);
 }
+
+TEST_CASE("Test query profiler pipeline and buffer manager counters", "[api]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	string output;
+
+	con.EnableProfiling();
+
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers AS SELECT * FROM range(0, 10000, 1) t1(i)"));
+	REQUIRE_NO_FAIL(con.Query("SELECT i % 10, COUNT(*) FROM integers GROUP BY 1"));
+
+	output = con.GetProfilingInformation(ProfilerPrintFormat::JSON);
+	REQUIRE(output.find("\"pipelines\"") != string::npos);
+	REQUIRE(output.find("\"buffer_manager\"") != string::npos);
+	REQUIRE(output.find("\"hash_table_entries\":10") != string::npos);
+
+	output = con.GetProfilingInformation();
+	REQUIRE(output.find("<<Pipelines>>") != string::npos);
+}
+
+//! Returns the total amount of tasks of all pipelines in the profiler output
+static idx_t ProfiledTaskCount(const string &output) {
+	idx_t total = 0;
+	auto pos = output.find("<<Pipelines>>");
+	REQUIRE(pos != string::npos);
+	auto end = output.find("<<Operator Tree>>", pos);
+	while (true) {
+		auto tasks_pos = output.find(" tasks on ", pos);
+		if (tasks_pos == string::npos || tasks_pos > end) {
+			break;
+		}
+		auto start = output.rfind('(', tasks_pos);
+		total += std::stoull(output.substr(start + 1, tasks_pos - start - 1));
+		pos = tasks_pos + 1;
+	}
+	return total;
+}
+
+TEST_CASE("Test that the profiler counts fewer scan tasks when zone maps exclude them", "[api]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+	REQUIRE_NO_FAIL(con.Query("PRAGMA force_parallelism"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE t AS SELECT range::INTEGER AS i FROM range(0, 300000, 1)"));
+	con.EnableProfiling();
+
+	// without a filter every vector of the table is scanned in its own task
+	result = con.Query("SELECT COUNT(*), SUM(i) FROM t");
+	REQUIRE(CHECK_COLUMN(result, 0, {300000}));
+	auto all_tasks = ProfiledTaskCount(con.GetProfilingInformation());
+	REQUIRE(all_tasks >= 293);
+
+	// the zone maps exclude all but the vectors that hold the range
+	result = con.Query("SELECT COUNT(*), SUM(i) FROM t WHERE i >= 150000 AND i < 151000");
+	REQUIRE(CHECK_COLUMN(result, 0, {1000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {150499500}));
+	auto filtered_tasks = ProfiledTaskCount(con.GetProfilingInformation());
+	REQUIRE(filtered_tasks <= 5);
+
+	// a filter that excludes every vector leaves no scan tasks for the table
+	result = con.Query("SELECT COUNT(*) FROM t WHERE i > 300000");
+	REQUIRE(CHECK_COLUMN(result, 0, {0}));
+	REQUIRE(ProfiledTaskCount(con.GetProfilingInformation()) <= 2);
+}
+
+TEST_CASE("Test that COPY TO writes the output of parallel tasks in the order of the input", "[api]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+	auto csv_path = TestCreatePath("parallel_copy.csv");
+
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+	REQUIRE_NO_FAIL(con.Query("PRAGMA force_parallelism"));
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers AS SELECT i, i::VARCHAR AS v FROM range(0, 300000, 1) t1(i)"));
+	con.EnableProfiling();
+
+	// every vector of the table is formatted in its own task
+	result = con.Query("COPY integers TO '" + csv_path + "'");
+	REQUIRE(CHECK_COLUMN(result, 0, {300000}));
+	auto output = con.GetProfilingInformation();
+	REQUIRE(ProfiledTaskCount(output) >= 293);
+
+	// the rows are written in the order of the input
+	con.DisableProfiling();
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE integers2 AS SELECT * FROM integers LIMIT 0"));
+	REQUIRE_NO_FAIL(con.Query("COPY integers2 FROM '" + csv_path + "'"));
+	result = con.Query("SELECT COUNT(*), SUM(i) FROM integers2");
+	REQUIRE(CHECK_COLUMN(result, 0, {300000}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(44999850000)}));
+	result = con.Query("SELECT COUNT(*) FROM integers2 WHERE rowid <> i OR v <> i::VARCHAR");
+	REQUIRE(CHECK_COLUMN(result, 0, {0}));
+}
+
+TEST_CASE("Test that read_csv reads the files of a glob pattern in one task per file", "[api]") {
+	unique_ptr<QueryResult> result;
+	DuckDB db(nullptr);
+	Connection con(db);
+
+	REQUIRE_NO_FAIL(con.Query("PRAGMA threads=4"));
+	con.EnableProfiling();
+
+	result = con.Query("SELECT COUNT(*), SUM(id) FROM read_csv_auto('test/sql/copy/csv/data/glob/*.csv')");
+	REQUIRE(CHECK_COLUMN(result, 0, {6}));
+	REQUIRE(CHECK_COLUMN(result, 1, {21}));
+	REQUIRE(ProfiledTaskCount(con.GetProfilingInformation()) == 3);
+
+	// a single file is read in a single task
+	result = con.Query("SELECT COUNT(*), SUM(id) FROM read_csv_auto('test/sql/copy/csv/data/glob/b1.csv')");
+	REQUIRE(CHECK_COLUMN(result, 0, {3}));
+	REQUIRE(CHECK_COLUMN(result, 1, {15}));
+	REQUIRE(ProfiledTaskCount(con.GetProfilingInformation()) == 1);
+}
@@ -126,3 +126,48 @@ TEST_CASE("Test file buffers for reading/writing to file", "[file_system]") {
 
 	fs.RemoveFile(fname);
 }
+
+TEST_CASE("Test memory mapped and positional file reads", "[file_system]") {
+	FileSystem fs;
+	unique_ptr<FileHandle> handle;
+	int64_t test_data[INTEGER_COUNT];
+	for (int i = 0; i < INTEGER_COUNT; i++) {
+		test_data[i] = i;
+	}
+
+	auto fname = TestCreatePath("test_file");
+
+	REQUIRE_NOTHROW(handle = fs.OpenFile(fname, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE, FileLockType::NO_LOCK));
+	REQUIRE_NOTHROW(handle->Write((void *)test_data, sizeof(int64_t) * INTEGER_COUNT, 0));
+	handle.reset();
+
+	REQUIRE_NOTHROW(handle = fs.OpenFile(fname, FileFlags::FILE_FLAGS_READ, FileLockType::NO_LOCK));
+	// positional reads in any order
+	int64_t value;
+	REQUIRE_NOTHROW(handle->Read((void *)&value, sizeof(int64_t), sizeof(int64_t) * 100));
+	REQUIRE(value == 100);
+	REQUIRE_NOTHROW(handle->Read((void *)&value, sizeof(int64_t), sizeof(int64_t) * 3));
+	REQUIRE(value == 3);
+	// reading past the end of the file fails
+	REQUIRE_THROWS(handle->Read((void *)&value, sizeof(int64_t), sizeof(int64_t) * INTEGER_COUNT));
+
+	// map the file into memory
+	auto mapping = fs.MapFile(*handle);
+	REQUIRE(mapping);
+	REQUIRE(mapping->size == sizeof(int64_t) * INTEGER_COUNT);
+	auto mapped_data = (int64_t *)mapping->data;
+	for (int i = 0; i < INTEGER_COUNT; i++) {
+		REQUIRE(mapped_data[i] == i);
+	}
+	// the mapping stays valid after the file is closed
+	handle.reset();
+	REQUIRE(mapped_data[INTEGER_COUNT - 1] == INTEGER_COUNT - 1);
+	mapping.reset();
+	fs.RemoveFile(fname);
+
+	// empty files cannot be mapped
+	REQUIRE_NOTHROW(handle = fs.OpenFile(fname, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE, FileLockType::NO_LOCK));
+	REQUIRE(!fs.MapFile(*handle));
+	handle.reset();
+	fs.RemoveFile(fname);
+}
@@ -34,3 +34,51 @@ TEST_CASE("Test basic stream read from GZIP files", "[gzip_stream]") {
 	GzipStream gz3("XXX_THIS_DOES_NOT_EXIST");
 	REQUIRE_THROWS(s = string(std::istreambuf_iterator<char>(gz3), {}));
 }
+
+TEST_CASE("Test reading GZIP files with multiple members", "[gzip_stream]") {
+	string gzip_file_path = TestCreatePath("test_members.txt.gz");
+
+	// concatenated gzip members decompress to the concatenation of their contents
+	ofstream ofp(gzip_file_path, ios::out | ios::binary);
+	for (idx_t i = 0; i < 3; i++) {
+		ofp.write((const char *)test_txt_gz, test_txt_gz_len);
+	}
+	ofp.close();
+
+	GzipStream gz(gzip_file_path);
+	std::string s(istreambuf_iterator<char>(gz), {});
+	REQUIRE(s == "Hello, World\nHello, World\nHello, World\n");
+
+	// destroying a stream that has not been read completely
+	{
+		GzipStream gz2(gzip_file_path);
+		REQUIRE(gz2.get() == 'H');
+	}
+
+	// a truncated member header
+	std::ofstream ofp2(gzip_file_path, ios::out | ios::binary);
+	ofp2.write((const char *)test_txt_gz, test_txt_gz_len);
+	ofp2.write((const char *)test_txt_gz, 5);
+	ofp2.close();
+
+	GzipStream gz3(gzip_file_path);
+	REQUIRE_THROWS(s = string(std::istreambuf_iterator<char>(gz3), {}));
+
+	// data after the last member that is not a member is ignored
+	std::ofstream ofp3(gzip_file_path, ios::out | ios::binary);
+	ofp3.write((const char *)test_txt_gz, test_txt_gz_len);
+	ofp3.write("\0\0\0\0\0\0\0\0\0\0\0\0", 12);
+	ofp3.close();
+
+	GzipStream gz4(gzip_file_path);
+	s = string(istreambuf_iterator<char>(gz4), {});
+	REQUIRE(s == "Hello, World\n");
+
+	// a truncated payload
+	std::ofstream ofp4(gzip_file_path, ios::out | ios::binary);
+	ofp4.write((const char *)test_txt_gz, test_txt_gz_len - 12);
+	ofp4.close();
+
+	GzipStream gz5(gzip_file_path);
+	REQUIRE_THROWS(s = string(std::istreambuf_iterator<char>(gz5), {}));
+}
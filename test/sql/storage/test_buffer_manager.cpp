@@ -222,3 +222,190 @@ TEST_CASE("Modifying the buffer manager limit at runtime for an in-memory databa
 	REQUIRE_NO_FAIL(con.Query("DROP TABLE test"));
 	REQUIRE_NO_FAIL(con.Query("PRAGMA memory_limit='1MB'"));
 }
+
+TEST_CASE("Test a cross product that materializes more data than the buffer manager size", "[storage][.]") {
+	unique_ptr<MaterializedQueryResult> result;
+	auto storage_database = TestCreatePath("storage_test");
+	auto config = GetTestConfig();
+
+	// set the maximum memory to 10MB: both the tables and the materialized side of the cross product have to be
+	// offloaded to disk
+	config->maximum_memory = 10000000;
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		// create a table of roughly 40MB of string data
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE big AS SELECT i, REPEAT('x', 100) || i::VARCHAR AS s FROM range(0, "
+		                          "400000) t(i)"));
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE small AS SELECT i FROM range(0, 2) t(i)"));
+		result = con.Query("SELECT COUNT(*), SUM(big.i), MIN(s), MAX(LENGTH(s)) FROM big, small");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(800000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(159999600000)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {string(100, 'x') + "0"}));
+		REQUIRE(CHECK_COLUMN(result, 3, {Value::BIGINT(106)}));
+		result = con.Query("SELECT COUNT(*), SUM(big.i), MIN(s), MAX(LENGTH(s)) FROM small, big");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(800000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(159999600000)}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test a recursive CTE with iterations that exceed the buffer manager size", "[storage][.]") {
+	unique_ptr<MaterializedQueryResult> result;
+	auto storage_database = TestCreatePath("storage_test");
+	auto config = GetTestConfig();
+
+	// set the maximum memory to 10MB: the working and intermediate tables of the recursive CTE are offloaded to disk
+	config->maximum_memory = 10000000;
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		// every iteration produces roughly 20MB of string data
+		result = con.Query("WITH RECURSIVE t(i, s) AS (SELECT i, REPEAT('x', 100) || i::VARCHAR FROM range(0, 200000) "
+		                   "t1(i) UNION ALL SELECT i + 200000, s FROM t WHERE i < 400000) SELECT COUNT(*), SUM(i), "
+		                   "MAX(LENGTH(s)) FROM t");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(600000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(179999700000)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(106)}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test a transaction-local append that exceeds the buffer manager size", "[storage][.]") {
+	unique_ptr<MaterializedQueryResult> result;
+	auto storage_database = TestCreatePath("storage_test");
+	auto config = GetTestConfig();
+
+	// set the maximum memory to 10MB
+	config->maximum_memory = 10000000;
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (a BIGINT, b VARCHAR);"));
+		// append roughly 50MB of data in a single transaction: the transaction-local data is offloaded to disk
+		REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+		REQUIRE_NO_FAIL(
+		    con.Query("INSERT INTO test SELECT i, REPEAT('x', 100) || i::VARCHAR FROM range(0, 400000) t(i)"));
+		result = con.Query("SELECT COUNT(*), SUM(a) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(400000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(79999800000)}));
+		REQUIRE_NO_FAIL(con.Query("COMMIT"));
+		result = con.Query("SELECT COUNT(*), SUM(a), MAX(LENGTH(b)) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(400000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(79999800000)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(106)}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test reserving operator memory without a temporary directory", "[storage][.]") {
+	unique_ptr<MaterializedQueryResult> result;
+	auto storage_database = TestCreatePath("storage_test");
+	auto config = GetTestConfig();
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		// create a table of roughly 32MB
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE test AS SELECT i::INTEGER AS a, (i % 100000)::INTEGER AS b FROM "
+		                          "range(0, 4000000) t(i)"));
+	}
+	// set the maximum memory to 10MB without a temporary directory: only blocks of the database file can be evicted
+	config->maximum_memory = 10000000;
+	config->use_temporary_directory = false;
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		// scanning the table fills the buffer manager with blocks of the database file
+		result = con.Query("SELECT SUM(a) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::HUGEINT(7999998000000)}));
+		// the hash table of the aggregate evicts these blocks to reserve its memory
+		result = con.Query("SELECT COUNT(*), SUM(c) FROM (SELECT b, COUNT(*) AS c FROM test GROUP BY b) t");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(100000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(4000000)}));
+	}
+	DeleteDatabase(storage_database);
+}
+
+TEST_CASE("Test repeatedly growing transaction-local rows with an update", "[storage][.]") {
+	unique_ptr<MaterializedQueryResult> result;
+	auto config = GetTestConfig();
+
+	// set the maximum memory to 10MB without a temporary directory: the transaction-local blocks cannot be evicted
+	config->maximum_memory = 10000000;
+	config->use_temporary_directory = false;
+
+	DuckDB db(nullptr, config.get());
+	Connection con(db);
+	REQUIRE_NO_FAIL(con.Query("CREATE TABLE test (a BIGINT, b VARCHAR);"));
+	REQUIRE_NO_FAIL(con.Query("BEGIN TRANSACTION"));
+	// roughly 1MB of transaction-local data
+	REQUIRE_NO_FAIL(con.Query("INSERT INTO test SELECT i, REPEAT('x', 100) FROM range(0, 10000) t(i)"));
+	// every update grows all chunks, which are moved: without reusing the space they leave behind, the updates would
+	// allocate more than 50MB
+	for (idx_t i = 0; i < 50; i++) {
+		REQUIRE_NO_FAIL(con.Query("UPDATE test SET b = b || 'y'"));
+	}
+	result = con.Query("SELECT COUNT(*), SUM(a), MIN(LENGTH(b)), MAX(LENGTH(b)) FROM test");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(10000)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(49995000)}));
+	REQUIRE(CHECK_COLUMN(result, 2, {Value::BIGINT(150)}));
+	REQUIRE(CHECK_COLUMN(result, 3, {Value::BIGINT(150)}));
+	REQUIRE_NO_FAIL(con.Query("COMMIT"));
+	result = con.Query("SELECT COUNT(*), MAX(LENGTH(b)) FROM test");
+	REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(10000)}));
+	REQUIRE(CHECK_COLUMN(result, 1, {Value::BIGINT(150)}));
+}
+
+//! Returns the amount of bytes written to the temporary directory according to the profiler output of the last query
+static idx_t ProfiledBytesWritten(const string &profiler_output) {
+	auto pos = profiler_output.find("Bytes Written: ");
+	REQUIRE(pos != string::npos);
+	return std::stoull(profiler_output.substr(pos + strlen("Bytes Written: ")));
+}
+
+TEST_CASE("Test a GROUP BY that spills its radix partitions to the temporary directory", "[storage][.]") {
+	unique_ptr<MaterializedQueryResult> result;
+	auto storage_database = TestCreatePath("storage_test");
+	auto config = GetTestConfig();
+
+	// make sure the database does not exist
+	DeleteDatabase(storage_database);
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		REQUIRE_NO_FAIL(con.Query("CREATE TABLE test AS SELECT i::INTEGER AS a FROM range(0, 2000000) t(i)"));
+	}
+	// set the maximum memory to 10MB: the HT of one million groups does not fit, and neither do its partitions
+	config->maximum_memory = 10000000;
+	{
+		DuckDB db(storage_database, config.get());
+		Connection con(db);
+		con.EnableProfiling();
+		// the table is checkpointed: scanning it does not write anything to the temporary directory
+		result = con.Query("SELECT SUM(a) FROM test");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::HUGEINT(1999999000000)}));
+		REQUIRE(ProfiledBytesWritten(con.GetProfilingInformation()) == 0);
+
+		result = con.Query("SELECT COUNT(*), SUM(c), MIN(g), MAX(g) FROM (SELECT a % 1000000 AS g, COUNT(*) AS c FROM "
+		                   "test GROUP BY g) t");
+		REQUIRE(CHECK_COLUMN(result, 0, {Value::BIGINT(1000000)}));
+		REQUIRE(CHECK_COLUMN(result, 1, {Value::HUGEINT(2000000)}));
+		REQUIRE(CHECK_COLUMN(result, 2, {0}));
+		REQUIRE(CHECK_COLUMN(result, 3, {999999}));
+		// the blocks of the partitions were evicted to the temporary directory
+		REQUIRE(ProfiledBytesWritten(con.GetProfilingInformation()) > 0);
+	}
+	DeleteDatabase(storage_database);
+}
@@ -1,6 +1,13 @@
 #include "org_duckdb_DuckDBNative.h"
 #include "duckdb.hpp"
+#include "duckdb/common/limits.hpp"
+#include "duckdb/main/appender.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/parser/expression/parameter_expression.hpp"
+#include "duckdb/parser/parser.hpp"
+#include "duckdb/parser/query_node/select_node.hpp"
+#include "duckdb/parser/statement/insert_statement.hpp"
+#include "duckdb/parser/tableref/expressionlistref.hpp"
 
 using namespace duckdb;
 using namespace std;
@@ -82,6 +89,7 @@ JNIEXPORT void JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1disconnect(JNI
 }
 
 struct StatementHolder {
+	Connection *conn;
 	unique_ptr<PreparedStatement> stmt;
 };
 
@@ -97,6 +105,7 @@ JNIEXPORT jobject JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1prepare(JNI
 	auto query = byte_array_to_string(env, query_j);
 
 	auto stmt_ref = new StatementHolder();
+	stmt_ref->conn = conn_ref;
 	stmt_ref->stmt = conn_ref->Prepare(query);
 	if (!stmt_ref->stmt->success) {
 		string error_msg = string(stmt_ref->stmt->error);
@@ -109,6 +118,100 @@ JNIEXPORT jobject JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1prepare(JNI
 struct ResultHolder {
 	unique_ptr<QueryResult> res;
 	unique_ptr<DataChunk> chunk;
+	//! The offsets and characters of the string columns of the current chunk, handed to Java as direct byte buffers
+	vector<unique_ptr<data_t[]>> string_buffers;
+};
+
+//! The classes and accessor methods of the supported Java parameter types. They are looked up once per execution or
+//! batch rather than for every parameter value.
+struct ParameterClasses {
+	explicit ParameterClasses(JNIEnv *env) {
+		bool_class = env->FindClass("java/lang/Boolean");
+		byte_class = env->FindClass("java/lang/Byte");
+		short_class = env->FindClass("java/lang/Short");
+		integer_class = env->FindClass("java/lang/Integer");
+		long_class = env->FindClass("java/lang/Long");
+		float_class = env->FindClass("java/lang/Float");
+		double_class = env->FindClass("java/lang/Double");
+		string_class = env->FindClass("java/lang/String");
+		boolean_value = env->GetMethodID(bool_class, "booleanValue", "()Z");
+		byte_value = env->GetMethodID(byte_class, "byteValue", "()B");
+		short_value = env->GetMethodID(short_class, "shortValue", "()S");
+		int_value = env->GetMethodID(integer_class, "intValue", "()I");
+		long_value = env->GetMethodID(long_class, "longValue", "()J");
+		float_value = env->GetMethodID(float_class, "floatValue", "()F");
+		double_value = env->GetMethodID(double_class, "doubleValue", "()D");
+	}
+
+	jclass bool_class;
+	jclass byte_class;
+	jclass short_class;
+	jclass integer_class;
+	jclass long_class;
+	jclass float_class;
+	jclass double_class;
+	jclass string_class;
+	jmethodID boolean_value;
+	jmethodID byte_value;
+	jmethodID short_value;
+	jmethodID int_value;
+	jmethodID long_value;
+	jmethodID float_value;
+	jmethodID double_value;
+};
+
+//! Converts the Java parameters of a single execution to values, returns false (with a pending Java exception) if
+//! one of the parameters has an unsupported type
+static bool jobject_array_to_values(JNIEnv *env, ParameterClasses &classes, jobjectArray params,
+                                    vector<Value> &duckdb_params) {
+	auto param_len = env->GetArrayLength(params);
+	for (idx_t i = 0; i < (idx_t)param_len; i++) {
+		auto param = env->GetObjectArrayElement(params, i);
+		if (param == nullptr) {
+			duckdb_params.push_back(Value());
+		} else if (env->IsInstanceOf(param, classes.bool_class)) {
+			duckdb_params.push_back(Value::BOOLEAN(env->CallBooleanMethod(param, classes.boolean_value)));
+		} else if (env->IsInstanceOf(param, classes.byte_class)) {
+			duckdb_params.push_back(Value::TINYINT(env->CallByteMethod(param, classes.byte_value)));
+		} else if (env->IsInstanceOf(param, classes.short_class)) {
+			duckdb_params.push_back(Value::SMALLINT(env->CallShortMethod(param, classes.short_value)));
+		} else if (env->IsInstanceOf(param, classes.integer_class)) {
+			duckdb_params.push_back(Value::INTEGER(env->CallIntMethod(param, classes.int_value)));
+		} else if (env->IsInstanceOf(param, classes.long_class)) {
+			duckdb_params.push_back(Value::BIGINT(env->CallLongMethod(param, classes.long_value)));
+		} else if (env->IsInstanceOf(param, classes.float_class)) {
+			duckdb_params.push_back(Value::FLOAT(env->CallFloatMethod(param, classes.float_value)));
+		} else if (env->IsInstanceOf(param, classes.double_class)) {
+			duckdb_params.push_back(Value::DOUBLE(env->CallDoubleMethod(param, classes.double_value)));
+		} else if (env->IsInstanceOf(param, classes.string_class)) {
+			auto *param_string = env->GetStringUTFChars((jstring)param, 0);
+			duckdb_params.push_back(Value(param_string));
+			env->ReleaseStringUTFChars((jstring)param, param_string);
+		} else {
+			env->DeleteLocalRef(param);
+			env->ThrowNew(env->FindClass("java/sql/SQLException"), "Unsupported parameter type");
+			return false;
+		}
+		env->DeleteLocalRef(param);
+	}
+	return true;
+}
+
+//! Frees all local references created while converting one row of a batch when it goes out of scope, also if the
+//! conversion or execution of the row throws
+class LocalFrame {
+public:
+	LocalFrame(JNIEnv *env, jint capacity) : env(env) {
+		if (env->PushLocalFrame(capacity) != 0) {
+			throw Exception("Could not allocate local references");
+		}
+	}
+	~LocalFrame() {
+		env->PopLocalFrame(nullptr);
+	}
+
+private:
+	JNIEnv *env;
 };
 
 JNIEXPORT jobject JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1execute(JNIEnv *env, jclass, jobject stmt_ref_buf,
@@ -116,69 +219,21 @@ JNIEXPORT jobject JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1execute(JNI
 	auto stmt_ref = (StatementHolder *)env->GetDirectBufferAddress(stmt_ref_buf);
 	if (!stmt_ref) {
 		env->ThrowNew(env->FindClass("java/sql/SQLException"), "Invalid statement");
+		return nullptr;
 	}
-	auto res_ref = new ResultHolder();
 	vector<Value> duckdb_params;
 
 	auto param_len = env->GetArrayLength(params);
 	if (param_len != stmt_ref->stmt->n_param) {
 		env->ThrowNew(env->FindClass("java/sql/SQLException"), "Parameter count mismatch");
+		return nullptr;
 	}
-
-	if (param_len > 0) {
-		auto bool_class = env->FindClass("java/lang/Boolean");
-		auto byte_class = env->FindClass("java/lang/Byte");
-		auto short_class = env->FindClass("java/lang/Short");
-		auto integer_class = env->FindClass("java/lang/Integer");
-		auto long_class = env->FindClass("java/lang/Long");
-		auto float_class = env->FindClass("java/lang/Float");
-		auto double_class = env->FindClass("java/lang/Double");
-		auto string_class = env->FindClass("java/lang/String");
-
-		for (idx_t i = 0; i < param_len; i++) {
-			auto param = env->GetObjectArrayElement(params, i);
-			if (param == nullptr) {
-				duckdb_params.push_back(Value());
-				continue;
-			} else if (env->IsInstanceOf(param, bool_class)) {
-				duckdb_params.push_back(
-				    Value::BOOLEAN(env->CallBooleanMethod(param, env->GetMethodID(bool_class, "booleanValue", "()Z"))));
-				continue;
-			} else if (env->IsInstanceOf(param, byte_class)) {
-				duckdb_params.push_back(
-				    Value::TINYINT(env->CallByteMethod(param, env->GetMethodID(byte_class, "byteValue", "()B"))));
-				continue;
-			} else if (env->IsInstanceOf(param, short_class)) {
-				duckdb_params.push_back(
-				    Value::SMALLINT(env->CallShortMethod(param, env->GetMethodID(short_class, "shortValue", "()S"))));
-				continue;
-			} else if (env->IsInstanceOf(param, integer_class)) {
-				duckdb_params.push_back(
-				    Value::INTEGER(env->CallIntMethod(param, env->GetMethodID(integer_class, "intValue", "()I"))));
-				continue;
-			} else if (env->IsInstanceOf(param, long_class)) {
-				duckdb_params.push_back(
-				    Value::BIGINT(env->CallLongMethod(param, env->GetMethodID(long_class, "longValue", "()J"))));
-				continue;
-			} else if (env->IsInstanceOf(param, float_class)) {
-				duckdb_params.push_back(
-				    Value::FLOAT(env->CallFloatMethod(param, env->GetMethodID(float_class, "floatValue", "()F"))));
-				continue;
-			} else if (env->IsInstanceOf(param, double_class)) {
-				duckdb_params.push_back(
-				    Value::DOUBLE(env->CallDoubleMethod(param, env->GetMethodID(double_class, "doubleValue", "()D"))));
-				continue;
-			} else if (env->IsInstanceOf(param, string_class)) {
-				auto *param_string = env->GetStringUTFChars((jstring)param, 0);
-				duckdb_params.push_back(Value(param_string));
-				env->ReleaseStringUTFChars((jstring)param, param_string);
-				continue;
-			} else {
-				env->ThrowNew(env->FindClass("java/sql/SQLException"), "Unsupported parameter type");
-			}
-		}
+	ParameterClasses classes(env);
+	if (!jobject_array_to_values(env, classes, params, duckdb_params)) {
+		return nullptr;
 	}
 
+	auto res_ref = new ResultHolder();
 	res_ref->res = stmt_ref->stmt->Execute(duckdb_params);
 	if (!res_ref->res->success) {
 		string error_msg = string(res_ref->res->error);
@@ -188,6 +243,178 @@ JNIEXPORT jobject JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1execute(JNI
 	return env->NewDirectByteBuffer(res_ref, 0);
 }
 
+//! Returns the table to append to if the statement is a plain "INSERT INTO tbl VALUES (?, ?, ...)" that fills every
+//! column of the table with a parameter. column_map receives the parameter index of each of the table columns.
+static unique_ptr<TableDescription> get_append_table(Connection &conn, PreparedStatement &stmt,
+                                                     vector<idx_t> &column_map) {
+	Parser parser;
+	parser.ParseQuery(stmt.query);
+	if (parser.statements.size() != 1 || parser.statements[0]->type != StatementType::INSERT_STATEMENT) {
+		return nullptr;
+	}
+	auto &insert = (InsertStatement &)*parser.statements[0];
+	if (!insert.select_statement->cte_map.empty() ||
+	    insert.select_statement->node->type != QueryNodeType::SELECT_NODE) {
+		return nullptr;
+	}
+	auto &node = (SelectNode &)*insert.select_statement->node;
+	if (!node.from_table || node.from_table->type != TableReferenceType::EXPRESSION_LIST || node.where_clause ||
+	    !node.groups.empty() || node.having || !node.modifiers.empty()) {
+		return nullptr;
+	}
+	auto &values = ((ExpressionListRef &)*node.from_table).values;
+	if (values.size() != 1) {
+		return nullptr;
+	}
+	auto &row = values[0];
+	auto table = conn.TableInfo(insert.schema, insert.table);
+	if (!table || row.size() != table->columns.size() || row.size() != stmt.n_param) {
+		return nullptr;
+	}
+	if (!insert.columns.empty() && insert.columns.size() != row.size()) {
+		return nullptr;
+	}
+	column_map.resize(row.size(), INVALID_INDEX);
+	for (idx_t i = 0; i < row.size(); i++) {
+		if (row[i]->type != ExpressionType::VALUE_PARAMETER) {
+			return nullptr;
+		}
+		auto param_idx = ((ParameterExpression &)*row[i]).parameter_nr - 1;
+		// find the table column the value is inserted into
+		idx_t column_idx = i;
+		if (!insert.columns.empty()) {
+			column_idx = INVALID_INDEX;
+			for (idx_t col = 0; col < table->columns.size(); col++) {
+				if (StringUtil::Lower(table->columns[col].name) == StringUtil::Lower(insert.columns[i])) {
+					column_idx = col;
+					break;
+				}
+			}
+		}
+		if (column_idx == INVALID_INDEX || column_map[column_idx] != INVALID_INDEX || param_idx >= row.size()) {
+			return nullptr;
+		}
+		column_map[column_idx] = param_idx;
+	}
+	return table;
+}
+
+//! The amount of local references a row of a batch needs: the parameter array and one parameter at a time
+static constexpr jint ROW_LOCAL_REFERENCES = 4;
+
+//! Executes the prepared statement once for every parameter row, returns the update count of every row
+static vector<int32_t> execute_batch_rows(JNIEnv *env, StatementHolder &stmt_ref, jobjectArray batch) {
+	auto row_count = env->GetArrayLength(batch);
+	vector<int32_t> update_counts;
+	vector<Value> duckdb_params;
+	ParameterClasses classes(env);
+	for (idx_t row_idx = 0; row_idx < (idx_t)row_count; row_idx++) {
+		LocalFrame frame(env, ROW_LOCAL_REFERENCES);
+		auto params = (jobjectArray)env->GetObjectArrayElement(batch, row_idx);
+		duckdb_params.clear();
+		if (!jobject_array_to_values(env, classes, params, duckdb_params)) {
+			throw Exception("Unsupported parameter type");
+		}
+		auto result = stmt_ref.stmt->Execute(duckdb_params, false);
+		if (!result->success) {
+			throw Exception(result->error);
+		}
+		auto &collection = ((MaterializedQueryResult &)*result).collection;
+		int32_t update_count = 0;
+		if (collection.count > 0 && collection.types.size() > 0) {
+			update_count = collection.GetValue(0, 0).GetValue<int32_t>();
+		}
+		update_counts.push_back(update_count);
+	}
+	return update_counts;
+}
+
+//! Appends the parameter rows of an "INSERT INTO tbl VALUES (?, ...)" statement directly to the table in chunks
+static vector<int32_t> append_batch_rows(JNIEnv *env, StatementHolder &stmt_ref, TableDescription &table,
+                                         vector<idx_t> &column_map, jobjectArray batch) {
+	auto row_count = env->GetArrayLength(batch);
+	Appender appender(*stmt_ref.conn, table.schema, table.table);
+	vector<Value> duckdb_params;
+	ParameterClasses classes(env);
+	try {
+		for (idx_t row_idx = 0; row_idx < (idx_t)row_count; row_idx++) {
+			LocalFrame frame(env, ROW_LOCAL_REFERENCES);
+			auto params = (jobjectArray)env->GetObjectArrayElement(batch, row_idx);
+			duckdb_params.clear();
+			if (!jobject_array_to_values(env, classes, params, duckdb_params)) {
+				throw Exception("Unsupported parameter type");
+			}
+			appender.BeginRow();
+			for (idx_t col_idx = 0; col_idx < column_map.size(); col_idx++) {
+				appender.Append<Value>(duckdb_params[column_map[col_idx]]);
+			}
+			appender.EndRow();
+		}
+		appender.Close();
+	} catch (...) {
+		// discard the rows that have not been flushed yet
+		appender.Invalidate("Batch execution failed");
+		throw;
+	}
+	return vector<int32_t>(row_count, 1);
+}
+
+JNIEXPORT jintArray JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1execute_1batch(JNIEnv *env, jclass,
+                                                                                      jobject stmt_ref_buf,
+                                                                                      jobjectArray batch) {
+	auto stmt_ref = (StatementHolder *)env->GetDirectBufferAddress(stmt_ref_buf);
+	if (!stmt_ref || !stmt_ref->stmt || !stmt_ref->stmt->success) {
+		env->ThrowNew(env->FindClass("java/sql/SQLException"), "Invalid statement");
+		return nullptr;
+	}
+	auto row_count = env->GetArrayLength(batch);
+	for (idx_t row_idx = 0; row_idx < (idx_t)row_count; row_idx++) {
+		auto params = (jobjectArray)env->GetObjectArrayElement(batch, row_idx);
+		auto param_len = env->GetArrayLength(params);
+		env->DeleteLocalRef(params);
+		if ((idx_t)param_len != stmt_ref->stmt->n_param) {
+			env->ThrowNew(env->FindClass("java/sql/SQLException"), "Parameter count mismatch");
+			return nullptr;
+		}
+	}
+
+	auto &conn = *stmt_ref->conn;
+	// all rows of the batch are executed in one transaction, which we only commit ourselves in auto-commit mode
+	bool auto_commit = conn.context->transaction.IsAutoCommit();
+	vector<int32_t> update_counts;
+	try {
+		if (auto_commit) {
+			conn.BeginTransaction();
+		}
+		try {
+			vector<idx_t> column_map;
+			auto table = get_append_table(conn, *stmt_ref->stmt, column_map);
+			if (table) {
+				update_counts = append_batch_rows(env, *stmt_ref, *table, column_map, batch);
+			} else {
+				update_counts = execute_batch_rows(env, *stmt_ref, batch);
+			}
+		} catch (...) {
+			if (auto_commit) {
+				conn.Rollback();
+			}
+			throw;
+		}
+		if (auto_commit) {
+			conn.Commit();
+		}
+	} catch (exception &e) {
+		if (!env->ExceptionCheck()) {
+			env->ThrowNew(env->FindClass("java/sql/SQLException"), e.what());
+		}
+		return nullptr;
+	}
+
+	auto result = env->NewIntArray(update_counts.size());
+	env->SetIntArrayRegion(result, 0, update_counts.size(), (jint *)update_counts.data());
+	return result;
+}
+
 JNIEXPORT void JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1release(JNIEnv *env, jclass, jobject stmt_ref_buf) {
 	auto stmt_ref = (StatementHolder *)env->GetDirectBufferAddress(stmt_ref_buf);
 	if (stmt_ref) {
@@ -237,6 +464,7 @@ JNIEXPORT jobjectArray JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1fetch(
 	}
 
 	res_ref->chunk = res_ref->res->Fetch();
+	res_ref->string_buffers.clear();
 	auto row_count = res_ref->chunk->size();
 
 	auto vec_array = (jobjectArray)env->NewObjectArray(res_ref->chunk->column_count(),
@@ -257,7 +485,8 @@ JNIEXPORT jobjectArray JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1fetch(
 		auto jvec = env->NewObject(vec_class, vec_construct, type_str, (int)row_count, null_array);
 
 		jobject constlen_data = nullptr;
-		jobjectArray varlen_data = nullptr;
+		jobject varlen_data = nullptr;
+		jobject varlen_offsets = nullptr;
 
 		switch (vec.type.id()) {
 		case LogicalTypeId::BOOLEAN:
@@ -299,26 +528,53 @@ JNIEXPORT jobjectArray JNICALL Java_org_duckdb_DuckDBNative_duckdb_1jdbc_1fetch(
 			vec.Reference(string_vec);
 			// fall through on purpose
 		}
-		case LogicalTypeId::VARCHAR:
-			varlen_data = env->NewObjectArray(row_count, env->FindClass("java/lang/String"), nullptr);
+		case LogicalTypeId::VARCHAR: {
+			// the strings are copied into one buffer of UTF-8 characters with an offset array in front, which are only
+			// decoded into Java strings when they are accessed
+			auto strings = FlatVector::GetData<string_t>(vec);
+			auto &nullmask = FlatVector::Nullmask(vec);
+			idx_t offsets_size = (row_count + 1) * sizeof(int32_t);
+			idx_t total_length = 0;
 			for (idx_t row_idx = 0; row_idx < row_count; row_idx++) {
-				if (FlatVector::Nullmask(vec)[row_idx]) {
+				if (!nullmask[row_idx]) {
+					total_length += strings[row_idx].GetSize();
+				}
+			}
+			if (total_length > (idx_t)NumericLimits<int32_t>::Maximum()) {
+				env->ThrowNew(env->FindClass("java/sql/SQLException"), "String data of result chunk is too large");
+				return nullptr;
+			}
+			auto buffer = unique_ptr<data_t[]>(new data_t[offsets_size + total_length]);
+			auto offsets = (int32_t *)buffer.get();
+			auto characters = buffer.get() + offsets_size;
+			int32_t offset = 0;
+			for (idx_t row_idx = 0; row_idx < row_count; row_idx++) {
+				offsets[row_idx] = offset;
+				if (nullmask[row_idx]) {
 					continue;
 				}
-				env->SetObjectArrayElement(
-				    varlen_data, row_idx, env->NewStringUTF(((string_t *)FlatVector::GetData(vec))[row_idx].GetData()));
+				auto length = strings[row_idx].GetSize();
+				memcpy(characters + offset, strings[row_idx].GetData(), length);
+				offset += length;
 			}
+			offsets[row_count] = offset;
+			varlen_offsets = env->NewDirectByteBuffer(offsets, offsets_size);
+			varlen_data = env->NewDirectByteBuffer(characters, total_length);
+			res_ref->string_buffers.push_back(move(buffer));
 			break;
+		}
 		default:
 			jclass Exception = env->FindClass("java/sql/SQLException");
 			env->ThrowNew(Exception, ("Unsupported result column type " + vec.type.ToString()).c_str());
 		}
 
 		jfieldID constlen_data_field = env->GetFieldID(vec_class, "constlen_data", "Ljava/nio/ByteBuffer;");
-		jfieldID varlen_data_field = env->GetFieldID(vec_class, "varlen_data", "[Ljava/lang/Object;");
+		jfieldID varlen_data_field = env->GetFieldID(vec_class, "varlen_data", "Ljava/nio/ByteBuffer;");
+		jfieldID varlen_offsets_field = env->GetFieldID(vec_class, "varlen_offsets", "Ljava/nio/ByteBuffer;");
 
 		env->SetObjectField(jvec, constlen_data_field, constlen_data);
 		env->SetObjectField(jvec, varlen_data_field, varlen_data);
+		env->SetObjectField(jvec, varlen_offsets_field, varlen_offsets);
 
 		env->SetObjectArrayElement(vec_array, col_idx, jvec);
 	}
@@ -766,7 +766,7 @@ public class DuckDBDatabaseMetaData implements DatabaseMetaData {
 
 	@Override
 	public boolean supportsBatchUpdates() throws SQLException {
-		throw new SQLFeatureNotSupportedException();
+		return true;
 	}
 
 	@Override
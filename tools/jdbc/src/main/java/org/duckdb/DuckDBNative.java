@@ -78,6 +78,9 @@ public class DuckDBNative {
 	// returns res_ref result reference object
 	protected static native ByteBuffer duckdb_jdbc_execute(ByteBuffer stmt_ref, Object[] params);
 
+	// executes the statement for every parameter row in one transaction, returns the update counts
+	protected static native int[] duckdb_jdbc_execute_batch(ByteBuffer stmt_ref, Object[][] params);
+
 
 	protected static native void duckdb_jdbc_free_result(ByteBuffer res_ref);
 
@@ -7,6 +7,7 @@ import java.net.URL;
 import java.nio.ByteBuffer;
 import java.nio.charset.StandardCharsets;
 import java.sql.Array;
+import java.sql.BatchUpdateException;
 import java.sql.Blob;
 import java.sql.Clob;
 import java.sql.Connection;
@@ -25,6 +26,7 @@ import java.sql.SQLXML;
 import java.sql.Time;
 import java.sql.Timestamp;
 import java.sql.Types;
+import java.util.ArrayList;
 import java.util.Calendar;
 
 public class DuckDBPreparedStatement implements PreparedStatement {
@@ -36,6 +38,7 @@ public class DuckDBPreparedStatement implements PreparedStatement {
 	private boolean is_update = false;
 	private Object[] params = new Object[0];
 	private DuckDBResultSetMetaData meta = null;
+	private ArrayList<Object[]> batch = new ArrayList<Object[]>();
 
 	public DuckDBPreparedStatement(DuckDBConnection conn) throws SQLException {
 		if (conn == null) {
@@ -69,6 +72,7 @@ public class DuckDBPreparedStatement implements PreparedStatement {
 
 		select_result = null;
 		update_result = 0;
+		batch.clear();
 
 		stmt_ref = DuckDBNative.duckdb_jdbc_prepare(conn.conn_ref, sql.getBytes(StandardCharsets.UTF_8));
 		meta = DuckDBNative.duckdb_jdbc_meta(stmt_ref);
@@ -356,12 +360,28 @@ public class DuckDBPreparedStatement implements PreparedStatement {
 
 	@Override
 	public void clearBatch() throws SQLException {
-		throw new SQLFeatureNotSupportedException();
+		batch.clear();
 	}
 
 	@Override
 	public int[] executeBatch() throws SQLException {
-		throw new SQLFeatureNotSupportedException();
+		if (isClosed()) {
+			throw new SQLException("Statement was closed");
+		}
+		if (stmt_ref == null) {
+			throw new SQLException("Prepare something first");
+		}
+		if (batch.isEmpty()) {
+			return new int[0];
+		}
+		// the whole batch is sent to the native side at once, plain inserts are appended to the table in bulk
+		Object[][] batch_params = batch.toArray(new Object[batch.size()][]);
+		batch.clear();
+		try {
+			return DuckDBNative.duckdb_jdbc_execute_batch(stmt_ref, batch_params);
+		} catch (SQLException e) {
+			throw new BatchUpdateException(e.getMessage(), new int[0], e);
+		}
 	}
 
 	@Override
@@ -603,7 +623,16 @@ public class DuckDBPreparedStatement implements PreparedStatement {
 
 	@Override
 	public void addBatch() throws SQLException {
-		throw new SQLFeatureNotSupportedException();
+		if (isClosed()) {
+			throw new SQLException("Statement was closed");
+		}
+		if (stmt_ref == null) {
+			throw new SQLException("Prepare something first");
+		}
+		if (!is_update) {
+			throw new SQLException("addBatch() cannot be used with SELECT queries");
+		}
+		batch.add(params.clone());
 	}
 
 	@Override
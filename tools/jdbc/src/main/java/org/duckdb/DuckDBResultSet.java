@@ -163,7 +163,7 @@ public class DuckDBResultSet implements ResultSet {
 		if (check_and_null(columnIndex)) {
 			return null;
 		}
-		return (String) current_chunk[columnIndex - 1].varlen_data[chunk_idx - 1];
+		return current_chunk[columnIndex - 1].getLazyString(chunk_idx - 1);
 	}
 
 	public String getString(int columnIndex) throws SQLException {
@@ -172,7 +172,7 @@ public class DuckDBResultSet implements ResultSet {
 		}
 
 		if ("VARCHAR".equals(meta.column_types[columnIndex - 1])) {
-			return (String) current_chunk[columnIndex - 1].varlen_data[chunk_idx - 1];
+			return current_chunk[columnIndex - 1].getLazyString(chunk_idx - 1);
 		}
 		Object res = getObject(columnIndex);
 		if (res == null) {
@@ -1,6 +1,9 @@
 package org.duckdb;
 
+import java.nio.Buffer;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
 
 public class DuckDBVector {
 	
@@ -14,6 +17,29 @@ public class DuckDBVector {
 	protected int length;
 	protected boolean[] nullmask;
 	protected ByteBuffer constlen_data = null;
-	protected Object[] varlen_data = null;
+	// strings are transferred as the UTF-8 characters of all rows and (length + 1) offsets into them
+	protected ByteBuffer varlen_data = null;
+	protected ByteBuffer varlen_offsets = null;
+	private String[] varlen_strings = null;
+
+	// decodes the string at the given row on first access
+	protected String getLazyString(int idx) {
+		if (nullmask[idx]) {
+			return null;
+		}
+		if (varlen_strings == null) {
+			varlen_strings = new String[length];
+		}
+		if (varlen_strings[idx] == null) {
+			varlen_offsets.order(ByteOrder.LITTLE_ENDIAN);
+			int start = varlen_offsets.getInt(idx * 4);
+			int end = varlen_offsets.getInt((idx + 1) * 4);
+			byte[] bytes = new byte[end - start];
+			((Buffer) varlen_data).position(start);
+			varlen_data.get(bytes);
+			varlen_strings[idx] = new String(bytes, StandardCharsets.UTF_8);
+		}
+		return varlen_strings[idx];
+	}
 
 }
@@ -6,6 +6,7 @@ import java.math.BigDecimal;
 import java.math.BigInteger;
 import java.nio.file.Files;
 import java.nio.file.Path;
+import java.sql.BatchUpdateException;
 import java.sql.Connection;
 import java.sql.Date;
 import java.sql.Driver;
@@ -599,6 +600,78 @@ public class TestDuckDBJDBC {
 
 	}
 
+	public static void test_batch_insert() throws Exception {
+		Connection conn = DriverManager.getConnection("jdbc:duckdb:");
+		Statement stmt = conn.createStatement();
+		stmt.execute("CREATE TABLE batch_test (i INTEGER PRIMARY KEY, s VARCHAR)");
+
+		// plain inserts are appended to the table in bulk
+		PreparedStatement ps = conn.prepareStatement("INSERT INTO batch_test (s, i) VALUES (?, ?)");
+		for (int i = 0; i < 5000; i++) {
+			ps.setString(1, i % 3 == 0 ? null : "string " + i);
+			ps.setInt(2, i);
+			ps.addBatch();
+		}
+		int[] counts = ps.executeBatch();
+		assertEquals(counts.length, 5000);
+		assertEquals(counts[4999], 1);
+		assertEquals(ps.executeBatch().length, 0);
+
+		// a failing row rolls back the entire batch
+		for (int i = 5000; i < 6000; i++) {
+			ps.setString(1, "string " + i);
+			ps.setInt(2, i == 5999 ? 42 : i);
+			ps.addBatch();
+		}
+		try {
+			ps.executeBatch();
+			assertTrue(false);
+		} catch (BatchUpdateException e) {
+		}
+		ps.close();
+
+		// other statements are executed row by row
+		ps = conn.prepareStatement("UPDATE batch_test SET s = ? WHERE i = ?");
+		ps.setString(1, "updated");
+		ps.setInt(2, 0);
+		ps.addBatch();
+		ps.setString(1, "updated");
+		ps.setInt(2, 1);
+		ps.addBatch();
+		ps.setString(1, "updated");
+		ps.setInt(2, 100000);
+		ps.addBatch();
+		counts = ps.executeBatch();
+		assertEquals(counts.length, 3);
+		assertEquals(counts[0], 1);
+		assertEquals(counts[2], 0);
+		ps.close();
+
+		ResultSet rs = stmt.executeQuery("SELECT COUNT(*), COUNT(s), SUM(i) FROM batch_test");
+		assertTrue(rs.next());
+		assertEquals(rs.getInt(1), 5000);
+		assertEquals(rs.getInt(2), 3334);
+		assertEquals(rs.getLong(3), 12497500L);
+		rs.close();
+
+		rs = stmt.executeQuery("SELECT s FROM batch_test ORDER BY i LIMIT 3");
+		assertTrue(rs.next());
+		assertEquals(rs.getString(1), "updated");
+		assertTrue(rs.next());
+		assertEquals(rs.getString(1), "updated");
+		assertTrue(rs.next());
+		assertEquals(rs.getString(1), "string 2");
+		rs.close();
+
+		rs = stmt.executeQuery("SELECT s FROM batch_test WHERE i = 3");
+		assertTrue(rs.next());
+		assertTrue(rs.getString(1) == null);
+		assertTrue(rs.wasNull());
+		rs.close();
+		stmt.close();
+		conn.close();
+	}
+
 	public static void test_read_only() throws Exception {
 		Path database_file = Files.createTempFile("duckdb-jdbc-test-", ".duckdb");
 		database_file.toFile().delete();